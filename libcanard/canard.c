@@ -25,9 +25,54 @@
 
 /// Define CANARD_CRC_TABLE=0 to use slow but ROM-efficient transfer-CRC computation algorithm.
 /// Doing so is expected to save ca. 500 bytes of ROM and increase the cost of RX/TX transfer processing by ~half.
+/// Define CANARD_CRC_TABLE=4 or CANARD_CRC_TABLE=8 to use the slice-by-4 or slice-by-8 algorithm, respectively,
+/// which processes 4 or 8 bytes per iteration at the expense of 2 or 4 KiB of ROM (instead of 512 bytes).
+/// This is beneficial for large transfers, especially over CAN FD. The default is the byte-wise table.
 #ifndef CANARD_CRC_TABLE
 #    define CANARD_CRC_TABLE 1
 #endif
+#if (CANARD_CRC_TABLE != 0) && (CANARD_CRC_TABLE != 1) && (CANARD_CRC_TABLE != 4) && (CANARD_CRC_TABLE != 8)
+#    error "Invalid CANARD_CRC_TABLE: the valid values are 0, 1, 4, and 8."
+#endif
+
+/// Define this macro to the name of a function that updates the transfer CRC using a hardware CRC peripheral or
+/// a platform-specific accelerated routine; it shall be declared in CANARD_CONFIG_HEADER. The signature is:
+///     uint16_t f(uint16_t crc, size_t size, const void* data);
+/// The function shall update the running CRC value with the data bytes per CRC-16/CCITT-FALSE: polynomial 0x1021,
+/// no reflection, no output XOR; the initial value 0xFFFF is applied by the library. If defined, CANARD_CRC_TABLE
+/// only affects the single-byte updates used for padding.
+
+/// These macros are used by the RX transfer ring (see CanardRxRing) to access its indexes from different threads:
+/// the load shall have the acquire semantics and the store shall have the release semantics. By default, the atomic
+/// builtins of GCC-compatible compilers are used; otherwise, the C11 fences are used if <stdatomic.h> is available.
+/// If neither is available, the indexes are accessed as plain volatile objects, which is only correct if the ring
+/// is used from a single thread (e.g., the producer is an ISR on a single-core MCU that does not reorder memory
+/// accesses); otherwise, the user shall provide suitable definitions in CANARD_CONFIG_HEADER.
+/// The other parts of the library do not use these macros.
+#if !defined(__GNUC__) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#    include <stdatomic.h>
+#    define ATOMIC_FENCES_C11 1
+#else
+#    define ATOMIC_FENCES_C11 0
+#endif
+#ifndef CANARD_ATOMIC_LOAD_ACQUIRE
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#    elif ATOMIC_FENCES_C11
+#        define CANARD_ATOMIC_LOAD_ACQUIRE(ptr) atomicLoadAcquire(ptr)
+#    else
+#        define CANARD_ATOMIC_LOAD_ACQUIRE(ptr) (*(const volatile size_t*) (ptr))
+#    endif
+#endif
+#ifndef CANARD_ATOMIC_STORE_RELEASE
+#    if defined(__GNUC__)
+#        define CANARD_ATOMIC_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#    elif ATOMIC_FENCES_C11
+#        define CANARD_ATOMIC_STORE_RELEASE(ptr, value) atomicStoreRelease((ptr), (value))
+#    else
+#        define CANARD_ATOMIC_STORE_RELEASE(ptr, value) (*(volatile size_t*) (ptr) = (value))
+#    endif
+#endif
 
 /// This macro is needed for testing and for library development.
 #ifndef CANARD_PRIVATE
@@ -43,6 +88,8 @@
 #define BITS_PER_BYTE 8U
 #define BYTE_MAX 0xFFU
 
+#define MICROSECONDS_PER_SECOND 1000000U
+
 #define CAN_EXT_ID_MASK ((UINT32_C(1) << 29U) - 1U)
 
 #define MFT_NON_LAST_FRAME_PAYLOAD_MIN 7U
@@ -80,28 +127,213 @@ typedef uint16_t TransferCRC;
 #define CRC_RESIDUE 0x0000U
 #define CRC_SIZE_BYTES 2U
 
+/// The longest frame payload that can be received; longer frames are discarded as malformed.
+#if CANARD_FIXED_MTU
+#    define RX_FRAME_PAYLOAD_MAX ((size_t) CANARD_FIXED_MTU)
+#else
+#    define RX_FRAME_PAYLOAD_MAX ((size_t) CANARD_MTU_CAN_FD)
+#endif
+
 #if (CANARD_CRC_TABLE != 0)
-static const uint16_t CRCTable[256] = {
-    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U, 0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU,
-    0xD1ADU, 0xE1CEU, 0xF1EFU, 0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U, 0x9339U, 0x8318U,
-    0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU, 0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U,
-    0x5485U, 0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU, 0x3653U, 0x2672U, 0x1611U, 0x0630U,
-    0x76D7U, 0x66F6U, 0x5695U, 0x46B4U, 0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU, 0x48C4U,
-    0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U, 0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U,
-    0xA90AU, 0xB92BU, 0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U, 0xDBFDU, 0xCBDCU, 0xFBBFU,
-    0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU, 0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
-    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U, 0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U,
-    0x2E32U, 0x1E51U, 0x0E70U, 0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U, 0x9188U, 0x81A9U,
-    0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU, 0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U,
-    0x6067U, 0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU, 0x02B1U, 0x1290U, 0x22F3U, 0x32D2U,
-    0x4235U, 0x5214U, 0x6277U, 0x7256U, 0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU, 0x34E2U,
-    0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U, 0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU,
-    0xC71DU, 0xD73CU, 0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U, 0xD94CU, 0xC96DU, 0xF90EU,
-    0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU, 0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
-    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU, 0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U,
-    0x1AD0U, 0x2AB3U, 0x3A92U, 0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U, 0x7C26U, 0x6C07U,
-    0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U, 0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U,
-    0x9FF8U, 0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+#    define CRC_TABLE_SLICES ((size_t) CANARD_CRC_TABLE)
+/// Row K contains the CRC of each byte value followed by K zero bytes; row 0 is the classic byte-wise table.
+static const uint16_t CRCTable[CRC_TABLE_SLICES][256] = {
+    {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U, 0x8108U, 0x9129U, 0xA14AU, 0xB16BU,
+        0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU, 0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+        0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU, 0x2462U, 0x3443U, 0x0420U, 0x1401U,
+        0x64E6U, 0x74C7U, 0x44A4U, 0x5485U, 0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+        0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U, 0xB75BU, 0xA77AU, 0x9719U, 0x8738U,
+        0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU, 0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+        0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU, 0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U,
+        0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U, 0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+        0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U, 0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU,
+        0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U, 0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+        0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U, 0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU,
+        0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU, 0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+        0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU, 0x02B1U, 0x1290U, 0x22F3U, 0x32D2U,
+        0x4235U, 0x5214U, 0x6277U, 0x7256U, 0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+        0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U, 0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U,
+        0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU, 0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+        0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU, 0x5844U, 0x4865U, 0x7806U, 0x6827U,
+        0x18C0U, 0x08E1U, 0x3882U, 0x28A3U, 0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+        0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U, 0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU,
+        0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U, 0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+        0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U, 0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U,
+        0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+    },
+#    if (CANARD_CRC_TABLE >= 4)
+    {
+        0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xCCC4U, 0xFFF5U, 0xAAA6U, 0x9997U, 0x89A9U, 0xBA98U, 0xEFCBU, 0xDCFAU,
+        0x456DU, 0x765CU, 0x230FU, 0x103EU, 0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xCFB7U, 0xFC86U, 0xA9D5U, 0x9AE4U,
+        0x8ADAU, 0xB9EBU, 0xECB8U, 0xDF89U, 0x461EU, 0x752FU, 0x207CU, 0x134DU, 0x06E6U, 0x35D7U, 0x6084U, 0x53B5U,
+        0xCA22U, 0xF913U, 0xAC40U, 0x9F71U, 0x8F4FU, 0xBC7EU, 0xE92DU, 0xDA1CU, 0x438BU, 0x70BAU, 0x25E9U, 0x16D8U,
+        0x0595U, 0x36A4U, 0x63F7U, 0x50C6U, 0xC951U, 0xFA60U, 0xAF33U, 0x9C02U, 0x8C3CU, 0xBF0DU, 0xEA5EU, 0xD96FU,
+        0x40F8U, 0x73C9U, 0x269AU, 0x15ABU, 0x0DCCU, 0x3EFDU, 0x6BAEU, 0x589FU, 0xC108U, 0xF239U, 0xA76AU, 0x945BU,
+        0x8465U, 0xB754U, 0xE207U, 0xD136U, 0x48A1U, 0x7B90U, 0x2EC3U, 0x1DF2U, 0x0EBFU, 0x3D8EU, 0x68DDU, 0x5BECU,
+        0xC27BU, 0xF14AU, 0xA419U, 0x9728U, 0x8716U, 0xB427U, 0xE174U, 0xD245U, 0x4BD2U, 0x78E3U, 0x2DB0U, 0x1E81U,
+        0x0B2AU, 0x381BU, 0x6D48U, 0x5E79U, 0xC7EEU, 0xF4DFU, 0xA18CU, 0x92BDU, 0x8283U, 0xB1B2U, 0xE4E1U, 0xD7D0U,
+        0x4E47U, 0x7D76U, 0x2825U, 0x1B14U, 0x0859U, 0x3B68U, 0x6E3BU, 0x5D0AU, 0xC49DU, 0xF7ACU, 0xA2FFU, 0x91CEU,
+        0x81F0U, 0xB2C1U, 0xE792U, 0xD4A3U, 0x4D34U, 0x7E05U, 0x2B56U, 0x1867U, 0x1B98U, 0x28A9U, 0x7DFAU, 0x4ECBU,
+        0xD75CU, 0xE46DU, 0xB13EU, 0x820FU, 0x9231U, 0xA100U, 0xF453U, 0xC762U, 0x5EF5U, 0x6DC4U, 0x3897U, 0x0BA6U,
+        0x18EBU, 0x2BDAU, 0x7E89U, 0x4DB8U, 0xD42FU, 0xE71EU, 0xB24DU, 0x817CU, 0x9142U, 0xA273U, 0xF720U, 0xC411U,
+        0x5D86U, 0x6EB7U, 0x3BE4U, 0x08D5U, 0x1D7EU, 0x2E4FU, 0x7B1CU, 0x482DU, 0xD1BAU, 0xE28BU, 0xB7D8U, 0x84E9U,
+        0x94D7U, 0xA7E6U, 0xF2B5U, 0xC184U, 0x5813U, 0x6B22U, 0x3E71U, 0x0D40U, 0x1E0DU, 0x2D3CU, 0x786FU, 0x4B5EU,
+        0xD2C9U, 0xE1F8U, 0xB4ABU, 0x879AU, 0x97A4U, 0xA495U, 0xF1C6U, 0xC2F7U, 0x5B60U, 0x6851U, 0x3D02U, 0x0E33U,
+        0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xDA90U, 0xE9A1U, 0xBCF2U, 0x8FC3U, 0x9FFDU, 0xACCCU, 0xF99FU, 0xCAAEU,
+        0x5339U, 0x6008U, 0x355BU, 0x066AU, 0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xD9E3U, 0xEAD2U, 0xBF81U, 0x8CB0U,
+        0x9C8EU, 0xAFBFU, 0xFAECU, 0xC9DDU, 0x504AU, 0x637BU, 0x3628U, 0x0519U, 0x10B2U, 0x2383U, 0x76D0U, 0x45E1U,
+        0xDC76U, 0xEF47U, 0xBA14U, 0x8925U, 0x991BU, 0xAA2AU, 0xFF79U, 0xCC48U, 0x55DFU, 0x66EEU, 0x33BDU, 0x008CU,
+        0x13C1U, 0x20F0U, 0x75A3U, 0x4692U, 0xDF05U, 0xEC34U, 0xB967U, 0x8A56U, 0x9A68U, 0xA959U, 0xFC0AU, 0xCF3BU,
+        0x56ACU, 0x659DU, 0x30CEU, 0x03FFU,
+    },
+    {
+        0x0000U, 0x3730U, 0x6E60U, 0x5950U, 0xDCC0U, 0xEBF0U, 0xB2A0U, 0x8590U, 0xA9A1U, 0x9E91U, 0xC7C1U, 0xF0F1U,
+        0x7561U, 0x4251U, 0x1B01U, 0x2C31U, 0x4363U, 0x7453U, 0x2D03U, 0x1A33U, 0x9FA3U, 0xA893U, 0xF1C3U, 0xC6F3U,
+        0xEAC2U, 0xDDF2U, 0x84A2U, 0xB392U, 0x3602U, 0x0132U, 0x5862U, 0x6F52U, 0x86C6U, 0xB1F6U, 0xE8A6U, 0xDF96U,
+        0x5A06U, 0x6D36U, 0x3466U, 0x0356U, 0x2F67U, 0x1857U, 0x4107U, 0x7637U, 0xF3A7U, 0xC497U, 0x9DC7U, 0xAAF7U,
+        0xC5A5U, 0xF295U, 0xABC5U, 0x9CF5U, 0x1965U, 0x2E55U, 0x7705U, 0x4035U, 0x6C04U, 0x5B34U, 0x0264U, 0x3554U,
+        0xB0C4U, 0x87F4U, 0xDEA4U, 0xE994U, 0x1DADU, 0x2A9DU, 0x73CDU, 0x44FDU, 0xC16DU, 0xF65DU, 0xAF0DU, 0x983DU,
+        0xB40CU, 0x833CU, 0xDA6CU, 0xED5CU, 0x68CCU, 0x5FFCU, 0x06ACU, 0x319CU, 0x5ECEU, 0x69FEU, 0x30AEU, 0x079EU,
+        0x820EU, 0xB53EU, 0xEC6EU, 0xDB5EU, 0xF76FU, 0xC05FU, 0x990FU, 0xAE3FU, 0x2BAFU, 0x1C9FU, 0x45CFU, 0x72FFU,
+        0x9B6BU, 0xAC5BU, 0xF50BU, 0xC23BU, 0x47ABU, 0x709BU, 0x29CBU, 0x1EFBU, 0x32CAU, 0x05FAU, 0x5CAAU, 0x6B9AU,
+        0xEE0AU, 0xD93AU, 0x806AU, 0xB75AU, 0xD808U, 0xEF38U, 0xB668U, 0x8158U, 0x04C8U, 0x33F8U, 0x6AA8U, 0x5D98U,
+        0x71A9U, 0x4699U, 0x1FC9U, 0x28F9U, 0xAD69U, 0x9A59U, 0xC309U, 0xF439U, 0x3B5AU, 0x0C6AU, 0x553AU, 0x620AU,
+        0xE79AU, 0xD0AAU, 0x89FAU, 0xBECAU, 0x92FBU, 0xA5CBU, 0xFC9BU, 0xCBABU, 0x4E3BU, 0x790BU, 0x205BU, 0x176BU,
+        0x7839U, 0x4F09U, 0x1659U, 0x2169U, 0xA4F9U, 0x93C9U, 0xCA99U, 0xFDA9U, 0xD198U, 0xE6A8U, 0xBFF8U, 0x88C8U,
+        0x0D58U, 0x3A68U, 0x6338U, 0x5408U, 0xBD9CU, 0x8AACU, 0xD3FCU, 0xE4CCU, 0x615CU, 0x566CU, 0x0F3CU, 0x380CU,
+        0x143DU, 0x230DU, 0x7A5DU, 0x4D6DU, 0xC8FDU, 0xFFCDU, 0xA69DU, 0x91ADU, 0xFEFFU, 0xC9CFU, 0x909FU, 0xA7AFU,
+        0x223FU, 0x150FU, 0x4C5FU, 0x7B6FU, 0x575EU, 0x606EU, 0x393EU, 0x0E0EU, 0x8B9EU, 0xBCAEU, 0xE5FEU, 0xD2CEU,
+        0x26F7U, 0x11C7U, 0x4897U, 0x7FA7U, 0xFA37U, 0xCD07U, 0x9457U, 0xA367U, 0x8F56U, 0xB866U, 0xE136U, 0xD606U,
+        0x5396U, 0x64A6U, 0x3DF6U, 0x0AC6U, 0x6594U, 0x52A4U, 0x0BF4U, 0x3CC4U, 0xB954U, 0x8E64U, 0xD734U, 0xE004U,
+        0xCC35U, 0xFB05U, 0xA255U, 0x9565U, 0x10F5U, 0x27C5U, 0x7E95U, 0x49A5U, 0xA031U, 0x9701U, 0xCE51U, 0xF961U,
+        0x7CF1U, 0x4BC1U, 0x1291U, 0x25A1U, 0x0990U, 0x3EA0U, 0x67F0U, 0x50C0U, 0xD550U, 0xE260U, 0xBB30U, 0x8C00U,
+        0xE352U, 0xD462U, 0x8D32U, 0xBA02U, 0x3F92U, 0x08A2U, 0x51F2U, 0x66C2U, 0x4AF3U, 0x7DC3U, 0x2493U, 0x13A3U,
+        0x9633U, 0xA103U, 0xF853U, 0xCF63U,
+    },
+    {
+        0x0000U, 0x76B4U, 0xED68U, 0x9BDCU, 0xCAF1U, 0xBC45U, 0x2799U, 0x512DU, 0x85C3U, 0xF377U, 0x68ABU, 0x1E1FU,
+        0x4F32U, 0x3986U, 0xA25AU, 0xD4EEU, 0x1BA7U, 0x6D13U, 0xF6CFU, 0x807BU, 0xD156U, 0xA7E2U, 0x3C3EU, 0x4A8AU,
+        0x9E64U, 0xE8D0U, 0x730CU, 0x05B8U, 0x5495U, 0x2221U, 0xB9FDU, 0xCF49U, 0x374EU, 0x41FAU, 0xDA26U, 0xAC92U,
+        0xFDBFU, 0x8B0BU, 0x10D7U, 0x6663U, 0xB28DU, 0xC439U, 0x5FE5U, 0x2951U, 0x787CU, 0x0EC8U, 0x9514U, 0xE3A0U,
+        0x2CE9U, 0x5A5DU, 0xC181U, 0xB735U, 0xE618U, 0x90ACU, 0x0B70U, 0x7DC4U, 0xA92AU, 0xDF9EU, 0x4442U, 0x32F6U,
+        0x63DBU, 0x156FU, 0x8EB3U, 0xF807U, 0x6E9CU, 0x1828U, 0x83F4U, 0xF540U, 0xA46DU, 0xD2D9U, 0x4905U, 0x3FB1U,
+        0xEB5FU, 0x9DEBU, 0x0637U, 0x7083U, 0x21AEU, 0x571AU, 0xCCC6U, 0xBA72U, 0x753BU, 0x038FU, 0x9853U, 0xEEE7U,
+        0xBFCAU, 0xC97EU, 0x52A2U, 0x2416U, 0xF0F8U, 0x864CU, 0x1D90U, 0x6B24U, 0x3A09U, 0x4CBDU, 0xD761U, 0xA1D5U,
+        0x59D2U, 0x2F66U, 0xB4BAU, 0xC20EU, 0x9323U, 0xE597U, 0x7E4BU, 0x08FFU, 0xDC11U, 0xAAA5U, 0x3179U, 0x47CDU,
+        0x16E0U, 0x6054U, 0xFB88U, 0x8D3CU, 0x4275U, 0x34C1U, 0xAF1DU, 0xD9A9U, 0x8884U, 0xFE30U, 0x65ECU, 0x1358U,
+        0xC7B6U, 0xB102U, 0x2ADEU, 0x5C6AU, 0x0D47U, 0x7BF3U, 0xE02FU, 0x969BU, 0xDD38U, 0xAB8CU, 0x3050U, 0x46E4U,
+        0x17C9U, 0x617DU, 0xFAA1U, 0x8C15U, 0x58FBU, 0x2E4FU, 0xB593U, 0xC327U, 0x920AU, 0xE4BEU, 0x7F62U, 0x09D6U,
+        0xC69FU, 0xB02BU, 0x2BF7U, 0x5D43U, 0x0C6EU, 0x7ADAU, 0xE106U, 0x97B2U, 0x435CU, 0x35E8U, 0xAE34U, 0xD880U,
+        0x89ADU, 0xFF19U, 0x64C5U, 0x1271U, 0xEA76U, 0x9CC2U, 0x071EU, 0x71AAU, 0x2087U, 0x5633U, 0xCDEFU, 0xBB5BU,
+        0x6FB5U, 0x1901U, 0x82DDU, 0xF469U, 0xA544U, 0xD3F0U, 0x482CU, 0x3E98U, 0xF1D1U, 0x8765U, 0x1CB9U, 0x6A0DU,
+        0x3B20U, 0x4D94U, 0xD648U, 0xA0FCU, 0x7412U, 0x02A6U, 0x997AU, 0xEFCEU, 0xBEE3U, 0xC857U, 0x538BU, 0x253FU,
+        0xB3A4U, 0xC510U, 0x5ECCU, 0x2878U, 0x7955U, 0x0FE1U, 0x943DU, 0xE289U, 0x3667U, 0x40D3U, 0xDB0FU, 0xADBBU,
+        0xFC96U, 0x8A22U, 0x11FEU, 0x674AU, 0xA803U, 0xDEB7U, 0x456BU, 0x33DFU, 0x62F2U, 0x1446U, 0x8F9AU, 0xF92EU,
+        0x2DC0U, 0x5B74U, 0xC0A8U, 0xB61CU, 0xE731U, 0x9185U, 0x0A59U, 0x7CEDU, 0x84EAU, 0xF25EU, 0x6982U, 0x1F36U,
+        0x4E1BU, 0x38AFU, 0xA373U, 0xD5C7U, 0x0129U, 0x779DU, 0xEC41U, 0x9AF5U, 0xCBD8U, 0xBD6CU, 0x26B0U, 0x5004U,
+        0x9F4DU, 0xE9F9U, 0x7225U, 0x0491U, 0x55BCU, 0x2308U, 0xB8D4U, 0xCE60U, 0x1A8EU, 0x6C3AU, 0xF7E6U, 0x8152U,
+        0xD07FU, 0xA6CBU, 0x3D17U, 0x4BA3U,
+    },
+#    endif
+#    if (CANARD_CRC_TABLE >= 8)
+    {
+        0x0000U, 0xAA51U, 0x4483U, 0xEED2U, 0x8906U, 0x2357U, 0xCD85U, 0x67D4U, 0x022DU, 0xA87CU, 0x46AEU, 0xECFFU,
+        0x8B2BU, 0x217AU, 0xCFA8U, 0x65F9U, 0x045AU, 0xAE0BU, 0x40D9U, 0xEA88U, 0x8D5CU, 0x270DU, 0xC9DFU, 0x638EU,
+        0x0677U, 0xAC26U, 0x42F4U, 0xE8A5U, 0x8F71U, 0x2520U, 0xCBF2U, 0x61A3U, 0x08B4U, 0xA2E5U, 0x4C37U, 0xE666U,
+        0x81B2U, 0x2BE3U, 0xC531U, 0x6F60U, 0x0A99U, 0xA0C8U, 0x4E1AU, 0xE44BU, 0x839FU, 0x29CEU, 0xC71CU, 0x6D4DU,
+        0x0CEEU, 0xA6BFU, 0x486DU, 0xE23CU, 0x85E8U, 0x2FB9U, 0xC16BU, 0x6B3AU, 0x0EC3U, 0xA492U, 0x4A40U, 0xE011U,
+        0x87C5U, 0x2D94U, 0xC346U, 0x6917U, 0x1168U, 0xBB39U, 0x55EBU, 0xFFBAU, 0x986EU, 0x323FU, 0xDCEDU, 0x76BCU,
+        0x1345U, 0xB914U, 0x57C6U, 0xFD97U, 0x9A43U, 0x3012U, 0xDEC0U, 0x7491U, 0x1532U, 0xBF63U, 0x51B1U, 0xFBE0U,
+        0x9C34U, 0x3665U, 0xD8B7U, 0x72E6U, 0x171FU, 0xBD4EU, 0x539CU, 0xF9CDU, 0x9E19U, 0x3448U, 0xDA9AU, 0x70CBU,
+        0x19DCU, 0xB38DU, 0x5D5FU, 0xF70EU, 0x90DAU, 0x3A8BU, 0xD459U, 0x7E08U, 0x1BF1U, 0xB1A0U, 0x5F72U, 0xF523U,
+        0x92F7U, 0x38A6U, 0xD674U, 0x7C25U, 0x1D86U, 0xB7D7U, 0x5905U, 0xF354U, 0x9480U, 0x3ED1U, 0xD003U, 0x7A52U,
+        0x1FABU, 0xB5FAU, 0x5B28U, 0xF179U, 0x96ADU, 0x3CFCU, 0xD22EU, 0x787FU, 0x22D0U, 0x8881U, 0x6653U, 0xCC02U,
+        0xABD6U, 0x0187U, 0xEF55U, 0x4504U, 0x20FDU, 0x8AACU, 0x647EU, 0xCE2FU, 0xA9FBU, 0x03AAU, 0xED78U, 0x4729U,
+        0x268AU, 0x8CDBU, 0x6209U, 0xC858U, 0xAF8CU, 0x05DDU, 0xEB0FU, 0x415EU, 0x24A7U, 0x8EF6U, 0x6024U, 0xCA75U,
+        0xADA1U, 0x07F0U, 0xE922U, 0x4373U, 0x2A64U, 0x8035U, 0x6EE7U, 0xC4B6U, 0xA362U, 0x0933U, 0xE7E1U, 0x4DB0U,
+        0x2849U, 0x8218U, 0x6CCAU, 0xC69BU, 0xA14FU, 0x0B1EU, 0xE5CCU, 0x4F9DU, 0x2E3EU, 0x846FU, 0x6ABDU, 0xC0ECU,
+        0xA738U, 0x0D69U, 0xE3BBU, 0x49EAU, 0x2C13U, 0x8642U, 0x6890U, 0xC2C1U, 0xA515U, 0x0F44U, 0xE196U, 0x4BC7U,
+        0x33B8U, 0x99E9U, 0x773BU, 0xDD6AU, 0xBABEU, 0x10EFU, 0xFE3DU, 0x546CU, 0x3195U, 0x9BC4U, 0x7516U, 0xDF47U,
+        0xB893U, 0x12C2U, 0xFC10U, 0x5641U, 0x37E2U, 0x9DB3U, 0x7361U, 0xD930U, 0xBEE4U, 0x14B5U, 0xFA67U, 0x5036U,
+        0x35CFU, 0x9F9EU, 0x714CU, 0xDB1DU, 0xBCC9U, 0x1698U, 0xF84AU, 0x521BU, 0x3B0CU, 0x915DU, 0x7F8FU, 0xD5DEU,
+        0xB20AU, 0x185BU, 0xF689U, 0x5CD8U, 0x3921U, 0x9370U, 0x7DA2U, 0xD7F3U, 0xB027U, 0x1A76U, 0xF4A4U, 0x5EF5U,
+        0x3F56U, 0x9507U, 0x7BD5U, 0xD184U, 0xB650U, 0x1C01U, 0xF2D3U, 0x5882U, 0x3D7BU, 0x972AU, 0x79F8U, 0xD3A9U,
+        0xB47DU, 0x1E2CU, 0xF0FEU, 0x5AAFU,
+    },
+    {
+        0x0000U, 0x45A0U, 0x8B40U, 0xCEE0U, 0x06A1U, 0x4301U, 0x8DE1U, 0xC841U, 0x0D42U, 0x48E2U, 0x8602U, 0xC3A2U,
+        0x0BE3U, 0x4E43U, 0x80A3U, 0xC503U, 0x1A84U, 0x5F24U, 0x91C4U, 0xD464U, 0x1C25U, 0x5985U, 0x9765U, 0xD2C5U,
+        0x17C6U, 0x5266U, 0x9C86U, 0xD926U, 0x1167U, 0x54C7U, 0x9A27U, 0xDF87U, 0x3508U, 0x70A8U, 0xBE48U, 0xFBE8U,
+        0x33A9U, 0x7609U, 0xB8E9U, 0xFD49U, 0x384AU, 0x7DEAU, 0xB30AU, 0xF6AAU, 0x3EEBU, 0x7B4BU, 0xB5ABU, 0xF00BU,
+        0x2F8CU, 0x6A2CU, 0xA4CCU, 0xE16CU, 0x292DU, 0x6C8DU, 0xA26DU, 0xE7CDU, 0x22CEU, 0x676EU, 0xA98EU, 0xEC2EU,
+        0x246FU, 0x61CFU, 0xAF2FU, 0xEA8FU, 0x6A10U, 0x2FB0U, 0xE150U, 0xA4F0U, 0x6CB1U, 0x2911U, 0xE7F1U, 0xA251U,
+        0x6752U, 0x22F2U, 0xEC12U, 0xA9B2U, 0x61F3U, 0x2453U, 0xEAB3U, 0xAF13U, 0x7094U, 0x3534U, 0xFBD4U, 0xBE74U,
+        0x7635U, 0x3395U, 0xFD75U, 0xB8D5U, 0x7DD6U, 0x3876U, 0xF696U, 0xB336U, 0x7B77U, 0x3ED7U, 0xF037U, 0xB597U,
+        0x5F18U, 0x1AB8U, 0xD458U, 0x91F8U, 0x59B9U, 0x1C19U, 0xD2F9U, 0x9759U, 0x525AU, 0x17FAU, 0xD91AU, 0x9CBAU,
+        0x54FBU, 0x115BU, 0xDFBBU, 0x9A1BU, 0x459CU, 0x003CU, 0xCEDCU, 0x8B7CU, 0x433DU, 0x069DU, 0xC87DU, 0x8DDDU,
+        0x48DEU, 0x0D7EU, 0xC39EU, 0x863EU, 0x4E7FU, 0x0BDFU, 0xC53FU, 0x809FU, 0xD420U, 0x9180U, 0x5F60U, 0x1AC0U,
+        0xD281U, 0x9721U, 0x59C1U, 0x1C61U, 0xD962U, 0x9CC2U, 0x5222U, 0x1782U, 0xDFC3U, 0x9A63U, 0x5483U, 0x1123U,
+        0xCEA4U, 0x8B04U, 0x45E4U, 0x0044U, 0xC805U, 0x8DA5U, 0x4345U, 0x06E5U, 0xC3E6U, 0x8646U, 0x48A6U, 0x0D06U,
+        0xC547U, 0x80E7U, 0x4E07U, 0x0BA7U, 0xE128U, 0xA488U, 0x6A68U, 0x2FC8U, 0xE789U, 0xA229U, 0x6CC9U, 0x2969U,
+        0xEC6AU, 0xA9CAU, 0x672AU, 0x228AU, 0xEACBU, 0xAF6BU, 0x618BU, 0x242BU, 0xFBACU, 0xBE0CU, 0x70ECU, 0x354CU,
+        0xFD0DU, 0xB8ADU, 0x764DU, 0x33EDU, 0xF6EEU, 0xB34EU, 0x7DAEU, 0x380EU, 0xF04FU, 0xB5EFU, 0x7B0FU, 0x3EAFU,
+        0xBE30U, 0xFB90U, 0x3570U, 0x70D0U, 0xB891U, 0xFD31U, 0x33D1U, 0x7671U, 0xB372U, 0xF6D2U, 0x3832U, 0x7D92U,
+        0xB5D3U, 0xF073U, 0x3E93U, 0x7B33U, 0xA4B4U, 0xE114U, 0x2FF4U, 0x6A54U, 0xA215U, 0xE7B5U, 0x2955U, 0x6CF5U,
+        0xA9F6U, 0xEC56U, 0x22B6U, 0x6716U, 0xAF57U, 0xEAF7U, 0x2417U, 0x61B7U, 0x8B38U, 0xCE98U, 0x0078U, 0x45D8U,
+        0x8D99U, 0xC839U, 0x06D9U, 0x4379U, 0x867AU, 0xC3DAU, 0x0D3AU, 0x489AU, 0x80DBU, 0xC57BU, 0x0B9BU, 0x4E3BU,
+        0x91BCU, 0xD41CU, 0x1AFCU, 0x5F5CU, 0x971DU, 0xD2BDU, 0x1C5DU, 0x59FDU, 0x9CFEU, 0xD95EU, 0x17BEU, 0x521EU,
+        0x9A5FU, 0xDFFFU, 0x111FU, 0x54BFU,
+    },
+    {
+        0x0000U, 0xB861U, 0x60E3U, 0xD882U, 0xC1C6U, 0x79A7U, 0xA125U, 0x1944U, 0x93ADU, 0x2BCCU, 0xF34EU, 0x4B2FU,
+        0x526BU, 0xEA0AU, 0x3288U, 0x8AE9U, 0x377BU, 0x8F1AU, 0x5798U, 0xEFF9U, 0xF6BDU, 0x4EDCU, 0x965EU, 0x2E3FU,
+        0xA4D6U, 0x1CB7U, 0xC435U, 0x7C54U, 0x6510U, 0xDD71U, 0x05F3U, 0xBD92U, 0x6EF6U, 0xD697U, 0x0E15U, 0xB674U,
+        0xAF30U, 0x1751U, 0xCFD3U, 0x77B2U, 0xFD5BU, 0x453AU, 0x9DB8U, 0x25D9U, 0x3C9DU, 0x84FCU, 0x5C7EU, 0xE41FU,
+        0x598DU, 0xE1ECU, 0x396EU, 0x810FU, 0x984BU, 0x202AU, 0xF8A8U, 0x40C9U, 0xCA20U, 0x7241U, 0xAAC3U, 0x12A2U,
+        0x0BE6U, 0xB387U, 0x6B05U, 0xD364U, 0xDDECU, 0x658DU, 0xBD0FU, 0x056EU, 0x1C2AU, 0xA44BU, 0x7CC9U, 0xC4A8U,
+        0x4E41U, 0xF620U, 0x2EA2U, 0x96C3U, 0x8F87U, 0x37E6U, 0xEF64U, 0x5705U, 0xEA97U, 0x52F6U, 0x8A74U, 0x3215U,
+        0x2B51U, 0x9330U, 0x4BB2U, 0xF3D3U, 0x793AU, 0xC15BU, 0x19D9U, 0xA1B8U, 0xB8FCU, 0x009DU, 0xD81FU, 0x607EU,
+        0xB31AU, 0x0B7BU, 0xD3F9U, 0x6B98U, 0x72DCU, 0xCABDU, 0x123FU, 0xAA5EU, 0x20B7U, 0x98D6U, 0x4054U, 0xF835U,
+        0xE171U, 0x5910U, 0x8192U, 0x39F3U, 0x8461U, 0x3C00U, 0xE482U, 0x5CE3U, 0x45A7U, 0xFDC6U, 0x2544U, 0x9D25U,
+        0x17CCU, 0xAFADU, 0x772FU, 0xCF4EU, 0xD60AU, 0x6E6BU, 0xB6E9U, 0x0E88U, 0xABF9U, 0x1398U, 0xCB1AU, 0x737BU,
+        0x6A3FU, 0xD25EU, 0x0ADCU, 0xB2BDU, 0x3854U, 0x8035U, 0x58B7U, 0xE0D6U, 0xF992U, 0x41F3U, 0x9971U, 0x2110U,
+        0x9C82U, 0x24E3U, 0xFC61U, 0x4400U, 0x5D44U, 0xE525U, 0x3DA7U, 0x85C6U, 0x0F2FU, 0xB74EU, 0x6FCCU, 0xD7ADU,
+        0xCEE9U, 0x7688U, 0xAE0AU, 0x166BU, 0xC50FU, 0x7D6EU, 0xA5ECU, 0x1D8DU, 0x04C9U, 0xBCA8U, 0x642AU, 0xDC4BU,
+        0x56A2U, 0xEEC3U, 0x3641U, 0x8E20U, 0x9764U, 0x2F05U, 0xF787U, 0x4FE6U, 0xF274U, 0x4A15U, 0x9297U, 0x2AF6U,
+        0x33B2U, 0x8BD3U, 0x5351U, 0xEB30U, 0x61D9U, 0xD9B8U, 0x013AU, 0xB95BU, 0xA01FU, 0x187EU, 0xC0FCU, 0x789DU,
+        0x7615U, 0xCE74U, 0x16F6U, 0xAE97U, 0xB7D3U, 0x0FB2U, 0xD730U, 0x6F51U, 0xE5B8U, 0x5DD9U, 0x855BU, 0x3D3AU,
+        0x247EU, 0x9C1FU, 0x449DU, 0xFCFCU, 0x416EU, 0xF90FU, 0x218DU, 0x99ECU, 0x80A8U, 0x38C9U, 0xE04BU, 0x582AU,
+        0xD2C3U, 0x6AA2U, 0xB220U, 0x0A41U, 0x1305U, 0xAB64U, 0x73E6U, 0xCB87U, 0x18E3U, 0xA082U, 0x7800U, 0xC061U,
+        0xD925U, 0x6144U, 0xB9C6U, 0x01A7U, 0x8B4EU, 0x332FU, 0xEBADU, 0x53CCU, 0x4A88U, 0xF2E9U, 0x2A6BU, 0x920AU,
+        0x2F98U, 0x97F9U, 0x4F7BU, 0xF71AU, 0xEE5EU, 0x563FU, 0x8EBDU, 0x36DCU, 0xBC35U, 0x0454U, 0xDCD6U, 0x64B7U,
+        0x7DF3U, 0xC592U, 0x1D10U, 0xA571U,
+    },
+    {
+        0x0000U, 0x47D3U, 0x8FA6U, 0xC875U, 0x0F6DU, 0x48BEU, 0x80CBU, 0xC718U, 0x1EDAU, 0x5909U, 0x917CU, 0xD6AFU,
+        0x11B7U, 0x5664U, 0x9E11U, 0xD9C2U, 0x3DB4U, 0x7A67U, 0xB212U, 0xF5C1U, 0x32D9U, 0x750AU, 0xBD7FU, 0xFAACU,
+        0x236EU, 0x64BDU, 0xACC8U, 0xEB1BU, 0x2C03U, 0x6BD0U, 0xA3A5U, 0xE476U, 0x7B68U, 0x3CBBU, 0xF4CEU, 0xB31DU,
+        0x7405U, 0x33D6U, 0xFBA3U, 0xBC70U, 0x65B2U, 0x2261U, 0xEA14U, 0xADC7U, 0x6ADFU, 0x2D0CU, 0xE579U, 0xA2AAU,
+        0x46DCU, 0x010FU, 0xC97AU, 0x8EA9U, 0x49B1U, 0x0E62U, 0xC617U, 0x81C4U, 0x5806U, 0x1FD5U, 0xD7A0U, 0x9073U,
+        0x576BU, 0x10B8U, 0xD8CDU, 0x9F1EU, 0xF6D0U, 0xB103U, 0x7976U, 0x3EA5U, 0xF9BDU, 0xBE6EU, 0x761BU, 0x31C8U,
+        0xE80AU, 0xAFD9U, 0x67ACU, 0x207FU, 0xE767U, 0xA0B4U, 0x68C1U, 0x2F12U, 0xCB64U, 0x8CB7U, 0x44C2U, 0x0311U,
+        0xC409U, 0x83DAU, 0x4BAFU, 0x0C7CU, 0xD5BEU, 0x926DU, 0x5A18U, 0x1DCBU, 0xDAD3U, 0x9D00U, 0x5575U, 0x12A6U,
+        0x8DB8U, 0xCA6BU, 0x021EU, 0x45CDU, 0x82D5U, 0xC506U, 0x0D73U, 0x4AA0U, 0x9362U, 0xD4B1U, 0x1CC4U, 0x5B17U,
+        0x9C0FU, 0xDBDCU, 0x13A9U, 0x547AU, 0xB00CU, 0xF7DFU, 0x3FAAU, 0x7879U, 0xBF61U, 0xF8B2U, 0x30C7U, 0x7714U,
+        0xAED6U, 0xE905U, 0x2170U, 0x66A3U, 0xA1BBU, 0xE668U, 0x2E1DU, 0x69CEU, 0xFD81U, 0xBA52U, 0x7227U, 0x35F4U,
+        0xF2ECU, 0xB53FU, 0x7D4AU, 0x3A99U, 0xE35BU, 0xA488U, 0x6CFDU, 0x2B2EU, 0xEC36U, 0xABE5U, 0x6390U, 0x2443U,
+        0xC035U, 0x87E6U, 0x4F93U, 0x0840U, 0xCF58U, 0x888BU, 0x40FEU, 0x072DU, 0xDEEFU, 0x993CU, 0x5149U, 0x169AU,
+        0xD182U, 0x9651U, 0x5E24U, 0x19F7U, 0x86E9U, 0xC13AU, 0x094FU, 0x4E9CU, 0x8984U, 0xCE57U, 0x0622U, 0x41F1U,
+        0x9833U, 0xDFE0U, 0x1795U, 0x5046U, 0x975EU, 0xD08DU, 0x18F8U, 0x5F2BU, 0xBB5DU, 0xFC8EU, 0x34FBU, 0x7328U,
+        0xB430U, 0xF3E3U, 0x3B96U, 0x7C45U, 0xA587U, 0xE254U, 0x2A21U, 0x6DF2U, 0xAAEAU, 0xED39U, 0x254CU, 0x629FU,
+        0x0B51U, 0x4C82U, 0x84F7U, 0xC324U, 0x043CU, 0x43EFU, 0x8B9AU, 0xCC49U, 0x158BU, 0x5258U, 0x9A2DU, 0xDDFEU,
+        0x1AE6U, 0x5D35U, 0x9540U, 0xD293U, 0x36E5U, 0x7136U, 0xB943U, 0xFE90U, 0x3988U, 0x7E5BU, 0xB62EU, 0xF1FDU,
+        0x283FU, 0x6FECU, 0xA799U, 0xE04AU, 0x2752U, 0x6081U, 0xA8F4U, 0xEF27U, 0x7039U, 0x37EAU, 0xFF9FU, 0xB84CU,
+        0x7F54U, 0x3887U, 0xF0F2U, 0xB721U, 0x6EE3U, 0x2930U, 0xE145U, 0xA696U, 0x618EU, 0x265DU, 0xEE28U, 0xA9FBU,
+        0x4D8DU, 0x0A5EU, 0xC22BU, 0x85F8U, 0x42E0U, 0x0533U, 0xCD46U, 0x8A95U, 0x5357U, 0x1484U, 0xDCF1U, 0x9B22U,
+        0x5C3AU, 0x1BE9U, 0xD39CU, 0x944FU,
+    },
+#    endif
 };
 #endif
 
@@ -109,7 +341,7 @@ CANARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte)
 {
 #if (CANARD_CRC_TABLE != 0)
     return (uint16_t) ((uint16_t) (crc << BITS_PER_BYTE) ^
-                       CRCTable[(uint16_t) ((uint16_t) (crc >> BITS_PER_BYTE) ^ byte) & BYTE_MAX]);
+                       CRCTable[0][(uint16_t) ((uint16_t) (crc >> BITS_PER_BYTE) ^ byte) & BYTE_MAX]);
 #else
     static const TransferCRC Top  = 0x8000U;
     static const TransferCRC Poly = 0x1021U;
@@ -131,14 +363,177 @@ CANARD_PRIVATE TransferCRC crcAddByte(const TransferCRC crc, const uint8_t byte)
 CANARD_PRIVATE TransferCRC crcAdd(const TransferCRC crc, const size_t size, const void* const data)
 {
     CANARD_ASSERT((data != NULL) || (size == 0U));
+#ifdef CANARD_CRC_HOOK
+    return (size > 0U) ? (TransferCRC) CANARD_CRC_HOOK(crc, size, data) : crc;
+#else
     TransferCRC    out = crc;
     const uint8_t* p   = (const uint8_t*) data;
-    for (size_t i = 0; i < size; i++)
+    size_t         i   = 0U;
+#    if (CANARD_CRC_TABLE >= 4)
+    // The first two bytes of each slice are combined with the current CRC value, the rest are looked up directly.
+    // Each byte goes through its own table row that accounts for the number of bytes following it in the slice.
+    for (; (size - i) >= CRC_TABLE_SLICES; i += CRC_TABLE_SLICES)
+    {
+        const uint16_t x = (uint16_t) (out ^ (uint16_t) ((uint16_t) (p[0] << BITS_PER_BYTE) | p[1]));
+        out              = (uint16_t) (CRCTable[CRC_TABLE_SLICES - 1U][x >> BITS_PER_BYTE] ^
+                          CRCTable[CRC_TABLE_SLICES - 2U][x & BYTE_MAX]);
+        for (size_t k = 2U; k < CRC_TABLE_SLICES; k++)
+        {
+            out ^= CRCTable[CRC_TABLE_SLICES - 1U - k][p[k]];
+        }
+        p += CRC_TABLE_SLICES;
+    }
+#    endif
+    for (; i < size; i++)
     {
         out = crcAddByte(out, *p);
         ++p;
     }
     return out;
+#endif
+}
+
+// --------------------------------------------- FIXED-SIZE BLOCK POOL ---------------------------------------------
+
+/// Free blocks are linked into a singly-linked list through their first bytes.
+typedef struct CanardInternalPoolBlock
+{
+    struct CanardInternalPoolBlock* next;
+} PoolBlock;
+
+/// The block size is rounded up to a multiple of the size of this type to keep every block suitably aligned
+/// for any object that the library may place into it.
+typedef union
+{
+    void*             ptr;
+    size_t            size;
+    CanardMicrosecond usec;
+} PoolAlignment;
+
+/// Returns the size of the pool blocks that can accommodate objects of the specified size.
+CANARD_PRIVATE size_t poolRoundBlockSize(const size_t object_size)
+{
+    return ((object_size + sizeof(PoolAlignment)) - 1U) / sizeof(PoolAlignment) * sizeof(PoolAlignment);
+}
+
+/// The pool is empty (zero capacity) if the storage cannot accommodate at least one block.
+CANARD_PRIVATE void poolInit(CanardPool* const pool,
+                             void* const       storage,
+                             const size_t      storage_size,
+                             const size_t      block_size)
+{
+    CANARD_ASSERT(pool != NULL);
+    CANARD_ASSERT(block_size > 0U);
+    pool->free_list  = NULL;
+    pool->block_size = poolRoundBlockSize(block_size);
+    pool->capacity   = (storage != NULL) ? (storage_size / pool->block_size) : 0U;
+    pool->used       = 0U;
+    uint8_t* const bytes = (uint8_t*) storage;
+    // Link the blocks in the reverse order so that they are allocated in the order of increasing address.
+    for (size_t i = pool->capacity; i > 0U; i--)
+    {
+        // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+        PoolBlock* const blk = (PoolBlock*) (void*) &bytes[(i - 1U) * pool->block_size];  // NOSONAR
+        blk->next            = pool->free_list;
+        pool->free_list      = blk;
+    }
+}
+
+/// Returns NULL if the pool is exhausted. Constant complexity.
+CANARD_PRIVATE void* poolAllocate(CanardPool* const pool)
+{
+    CANARD_ASSERT(pool != NULL);
+    PoolBlock* const out = pool->free_list;
+    if (out != NULL)
+    {
+        pool->free_list = out->next;
+        pool->used++;
+        CANARD_ASSERT(pool->used <= pool->capacity);
+    }
+    return out;
+}
+
+/// The pointer may be NULL, in which case the function has no effect. Constant complexity.
+CANARD_PRIVATE void poolFree(CanardPool* const pool, void* const pointer)
+{
+    CANARD_ASSERT(pool != NULL);
+    if (pointer != NULL)
+    {
+        CANARD_ASSERT(pool->used > 0U);
+        PoolBlock* const blk = (PoolBlock*) pointer;
+        blk->next            = pool->free_list;
+        pool->free_list      = blk;
+        pool->used--;
+    }
+}
+
+// --------------------------------------------- STATISTICS ---------------------------------------------
+
+/// All heap allocations of the library go through this function to keep the statistics; see CANARD_STATS.
+CANARD_PRIVATE void* insAllocate(CanardInstance* const ins, const size_t amount)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->memory_allocate != NULL));
+    void* const out = ins->memory_allocate(ins, amount);
+#if CANARD_STATS
+    if (out != NULL)
+    {
+        ins->memory_allocations++;
+        ins->memory_allocated_bytes += amount;
+    }
+#endif
+    return out;
+}
+
+/// Invokes the trace hook of the instance if there is one. The metadata may be NULL. No effect if CANARD_STATS is off.
+CANARD_PRIVATE void insTrace(CanardInstance* const               ins,
+                             const CanardTraceEvent              event,
+                             const CanardTransferMetadata* const metadata)
+{
+    CANARD_ASSERT(ins != NULL);
+#if CANARD_STATS
+    if (ins->trace_hook != NULL)
+    {
+        ins->trace_hook(ins, event, metadata);
+    }
+#else
+    (void) ins;
+    (void) event;
+    (void) metadata;
+#endif
+}
+
+/// Updates the TX statistics after an attempt to push the specified number of transfers into the queue.
+/// The result is the value returned by the push function. The metadata may be NULL; it is only used for tracing.
+CANARD_PRIVATE void txRecordPush(CanardTxQueue* const                que,
+                                 CanardInstance* const               ins,
+                                 const size_t                        transfer_count,
+                                 const int32_t                       result,
+                                 const CanardTransferMetadata* const metadata)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL));
+#if CANARD_STATS
+    if (result > 0)
+    {
+        que->stats.transfers += (uint32_t) transfer_count;
+        que->stats.frames += (uint32_t) result;
+        que->stats.peak_size = (que->size > que->stats.peak_size) ? que->size : que->stats.peak_size;
+    }
+    else if (-CANARD_ERROR_OUT_OF_MEMORY == result)
+    {
+        que->stats.oom_errors++;
+        insTrace(ins, CanardTraceEventTxOutOfMemory, metadata);
+    }
+    else
+    {
+        (void) 0;  // Invalid arguments are not counted.
+    }
+#else
+    (void) que;
+    (void) ins;
+    (void) transfer_count;
+    (void) result;
+    (void) metadata;
+#endif
 }
 
 // --------------------------------------------- TRANSMISSION ---------------------------------------------
@@ -156,9 +551,34 @@ typedef struct TxItem
     //  - Make the payload pointer point to the remainder of the allocated memory following this structure.
     //    The pointer is bad because it requires us to use pointer arithmetics.
     //  - Use a separate memory allocation for data. This is terribly wasteful (both time & memory).
+    // If the MTU is fixed at compile time, the storage is fixed-size, so every item has the same size.
+#if CANARD_FIXED_MTU
+    uint8_t payload_buffer[CANARD_FIXED_MTU];
+#else
     uint8_t payload_buffer[];  // NOSONAR
+#endif
 } TxItem;
 
+/// The payload of a lazily materialized transfer that is shared by all of its frames.
+/// The block is deallocated when the last frame referencing it is freed.
+typedef struct CanardInternalTxSharedPayload
+{
+    size_t ref_count;
+
+    // Intentional violation of MISRA: this flex array is used for the same reasons as in TxItem.
+    uint8_t data[];  // NOSONAR
+} TxSharedPayload;
+
+/// A lazily materialized frame (whose payload pointer is NULL) stores this reference at the beginning of its buffer,
+/// followed by the bytes of the frame that are not located in the shared block: padding, CRC, and the tail byte.
+/// The reference is accessed via memcpy() only because the alignment of the buffer is not guaranteed.
+typedef struct
+{
+    TxSharedPayload* shared;
+    size_t           offset;  ///< The offset of the first shared byte of the frame in the shared block.
+    size_t           size;    ///< The number of leading bytes of the frame located in the shared block.
+} TxSharedPayloadRef;
+
 /// Chain of TX frames prepared for insertion into a TX queue.
 typedef struct
 {
@@ -167,6 +587,92 @@ typedef struct
     size_t  size;
 } TxChain;
 
+/// Sequential reader of a transfer payload that may be scattered across several fragments.
+typedef struct
+{
+    const CanardPayloadFragment* fragments;
+    size_t                       fragment_count;
+    size_t                       fragment_index;   ///< The fragment that is currently being read.
+    size_t                       fragment_offset;  ///< The offset of the next byte within the current fragment.
+    /// If the payload is located in a shared block (see canardTxPushShared()), this points to the block, and the
+    /// frames of multi-frame transfers refer to it instead of copying the payload. NULL otherwise.
+    struct CanardInternalTxSharedPayload* shared;
+    /// If the payload is provided by a stream (see canardTxStreamInit()), this points to the stream, and the fragments
+    /// are not used; fragment_offset is then the offset of the next byte within the payload. NULL otherwise.
+    CanardTxStream* stream;
+} TxPayloadReader;
+
+CANARD_PRIVATE TxPayloadReader txPayloadReaderInit(const size_t                       fragment_count,
+                                                   const CanardPayloadFragment* const fragments)
+{
+    CANARD_ASSERT((fragments != NULL) || (fragment_count == 0U));
+    const TxPayloadReader out = {
+        .fragments       = fragments,
+        .fragment_count  = fragment_count,
+        .fragment_index  = 0U,
+        .fragment_offset = 0U,
+        .shared          = NULL,
+        .stream          = NULL,
+    };
+    return out;
+}
+
+/// Copies the next bytes of the payload into the destination buffer, crossing fragment boundaries as necessary.
+/// Returns the number of bytes copied, which is less than the requested amount only if the payload is exhausted.
+CANARD_PRIVATE size_t txPayloadRead(TxPayloadReader* const reader, const size_t size, uint8_t* const destination)
+{
+    CANARD_ASSERT(reader != NULL);
+    CANARD_ASSERT((destination != NULL) || (size == 0U));
+    size_t out = 0U;
+    if ((reader->stream != NULL) && (size > 0U))
+    {
+        CANARD_ASSERT((reader->fragment_offset + size) <= reader->stream->payload_size);
+        reader->stream->read(reader->stream, reader->fragment_offset, size, destination);
+        reader->fragment_offset += size;
+        out = size;
+    }
+    while ((out < size) && (reader->fragment_index < reader->fragment_count))
+    {
+        const CanardPayloadFragment* const frag = &reader->fragments[reader->fragment_index];
+        CANARD_ASSERT(reader->fragment_offset <= frag->size);
+        size_t move_size = frag->size - reader->fragment_offset;
+        if (move_size > (size - out))
+        {
+            move_size = size - out;
+        }
+        if (move_size > 0U)  // The check is needed to avoid calling memcpy() with a NULL pointer, it's an UB.
+        {
+            CANARD_ASSERT(frag->data != NULL);
+            // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+            (void) memcpy(&destination[out],
+                          &((const uint8_t*) frag->data)[reader->fragment_offset],
+                          move_size);  // NOLINT NOSONAR
+            out += move_size;
+            reader->fragment_offset += move_size;
+        }
+        if (reader->fragment_offset >= frag->size)
+        {
+            reader->fragment_index++;
+            reader->fragment_offset = 0U;
+        }
+    }
+    return out;
+}
+
+/// Computes the CRC of the entire scattered payload.
+CANARD_PRIVATE TransferCRC txPayloadCRC(const size_t fragment_count, const CanardPayloadFragment* const fragments)
+{
+    CANARD_ASSERT((fragments != NULL) || (fragment_count == 0U));
+    TransferCRC out = CRC_INITIAL;
+    for (size_t i = 0U; i < fragment_count; i++)
+    {
+        out = crcAdd(out, fragments[i].size, fragments[i].data);
+    }
+    return out;
+}
+
 CANARD_PRIVATE uint32_t txMakeMessageSessionSpecifier(const CanardPortID subject_id, const CanardNodeID src_node_id)
 {
     CANARD_ASSERT(src_node_id <= CANARD_NODE_ID_MAX);
@@ -189,8 +695,13 @@ CANARD_PRIVATE uint32_t txMakeServiceSessionSpecifier(const CanardPortID service
 }
 
 /// This is the transport MTU rounded up to next full DLC minus the tail byte.
+/// If the MTU is fixed at compile time, the argument is ignored and the result is a constant.
 CANARD_PRIVATE size_t adjustPresentationLayerMTU(const size_t mtu_bytes)
 {
+#if CANARD_FIXED_MTU
+    (void) mtu_bytes;
+    return CANARD_FIXED_MTU - 1U;
+#else
     const size_t max_index = (sizeof(CanardCANLengthToDLC) / sizeof(CanardCANLengthToDLC[0])) - 1U;
     size_t       mtu       = 0U;
     if (mtu_bytes < CANARD_MTU_CAN_CLASSIC)
@@ -206,13 +717,16 @@ CANARD_PRIVATE size_t adjustPresentationLayerMTU(const size_t mtu_bytes)
         mtu = CanardCANDLCToLength[CanardCANLengthToDLC[max_index]];
     }
     return mtu - 1U;
+#endif
 }
 
-CANARD_PRIVATE int32_t txMakeCANID(const CanardTransferMetadata* const tr,
-                                   const size_t                        payload_size,
-                                   const void* const                   payload,
-                                   const CanardNodeID                  local_node_id,
-                                   const size_t                        presentation_layer_mtu)
+/// The payload is only needed for anonymous transfers because their pseudo node-ID is derived from the payload CRC.
+CANARD_PRIVATE int32_t txMakeCANIDV(const CanardTransferMetadata* const tr,
+                                    const size_t                        payload_size,
+                                    const size_t                        fragment_count,
+                                    const CanardPayloadFragment* const  fragments,
+                                    const CanardNodeID                  local_node_id,
+                                    const size_t                        presentation_layer_mtu)
 {
     CANARD_ASSERT(tr != NULL);
     CANARD_ASSERT(presentation_layer_mtu > 0);
@@ -227,8 +741,7 @@ CANARD_PRIVATE int32_t txMakeCANID(const CanardTransferMetadata* const tr,
         }
         else if (payload_size <= presentation_layer_mtu)
         {
-            CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
-            const CanardNodeID c    = (CanardNodeID) (crcAdd(CRC_INITIAL, payload_size, payload) & CANARD_NODE_ID_MAX);
+            const CanardNodeID c    = (CanardNodeID) (txPayloadCRC(fragment_count, fragments) & CANARD_NODE_ID_MAX);
             const uint32_t     spec = txMakeMessageSessionSpecifier(tr->port_id, c) | FLAG_ANONYMOUS_MESSAGE;
             CANARD_ASSERT(spec <= CAN_EXT_ID_MASK);
             out = (int32_t) spec;
@@ -275,6 +788,17 @@ CANARD_PRIVATE int32_t txMakeCANID(const CanardTransferMetadata* const tr,
     return out;
 }
 
+CANARD_PRIVATE int32_t txMakeCANID(const CanardTransferMetadata* const tr,
+                                   const size_t                        payload_size,
+                                   const void* const                   payload,
+                                   const CanardNodeID                  local_node_id,
+                                   const size_t                        presentation_layer_mtu)
+{
+    CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
+    const CanardPayloadFragment frag = {.size = payload_size, .data = payload};
+    return txMakeCANIDV(tr, payload_size, 1U, &frag, local_node_id, presentation_layer_mtu);
+}
+
 CANARD_PRIVATE uint8_t txMakeTailByte(const bool             start_of_transfer,
                                       const bool             end_of_transfer,
                                       const bool             toggle,
@@ -287,24 +811,87 @@ CANARD_PRIVATE uint8_t txMakeTailByte(const bool             start_of_transfer,
 }
 
 /// Takes a frame payload size, returns a new size that is >=x and is rounded up to the nearest valid DLC.
+/// Every length up to the Classic CAN MTU is a valid DLC, so in the Classic-only build this is the identity function.
 CANARD_PRIVATE size_t txRoundFramePayloadSizeUp(const size_t x)
 {
     CANARD_ASSERT(x < (sizeof(CanardCANLengthToDLC) / sizeof(CanardCANLengthToDLC[0])));
+#if (CANARD_FIXED_MTU == CANARD_MTU_CAN_CLASSIC)
+    CANARD_ASSERT(x <= CANARD_MTU_CAN_CLASSIC);
+    return x;
+#else
     // Suppressing a false-positive out-of-bounds access error from Sonar. Its control flow analyser is misbehaving.
     const size_t y = CanardCANLengthToDLC[x];  // NOSONAR
     CANARD_ASSERT(y < (sizeof(CanardCANDLCToLength) / sizeof(CanardCANDLCToLength[0])));
     return CanardCANDLCToLength[y];
+#endif
+}
+
+/// Takes a frame payload size, returns a new size that is <=x and is rounded down to the nearest valid DLC.
+CANARD_PRIVATE size_t txRoundFramePayloadSizeDown(const size_t x)
+{
+    const size_t max_index = (sizeof(CanardCANLengthToDLC) / sizeof(CanardCANLengthToDLC[0])) - 1U;
+    const size_t clamped   = (x > max_index) ? max_index : x;
+    size_t       y         = CanardCANLengthToDLC[clamped];
+    if (CanardCANDLCToLength[y] > clamped)
+    {
+        CANARD_ASSERT(y > 0U);
+        y--;
+    }
+    return CanardCANDLCToLength[y];
+}
+
+/// The size of the memory block needed to store a TX queue item with the specified frame payload size (tail included).
+CANARD_PRIVATE size_t txGetItemSize(const size_t payload_size)
+{
+#if CANARD_FIXED_MTU
+    CANARD_ASSERT(payload_size <= CANARD_FIXED_MTU);
+    (void) payload_size;
+    return sizeof(TxItem);
+#else
+    return sizeof(TxItem) + payload_size;
+#endif
+}
+
+/// The presentation layer MTU currently in effect for the queue. If the queue is backed by a frame pool,
+/// the MTU is additionally limited by the size of the pool blocks. If the MTU is fixed, this is a constant.
+CANARD_PRIVATE size_t txGetPresentationLayerMTU(const CanardTxQueue* const que)
+{
+    CANARD_ASSERT(que != NULL);
+    size_t out = adjustPresentationLayerMTU(que->mtu_bytes);
+#if CANARD_FIXED_MTU
+    CANARD_ASSERT((0U == que->pool.block_size) || (que->pool.block_size >= sizeof(TxItem)));
+#else
+    if (que->pool.block_size > 0U)
+    {
+        CANARD_ASSERT(que->pool.block_size >= (sizeof(TxItem) + CANARD_MTU_CAN_CLASSIC));
+        const size_t pool_mtu = txRoundFramePayloadSizeDown(que->pool.block_size - sizeof(TxItem)) - 1U;
+        out                   = (out > pool_mtu) ? pool_mtu : out;
+    }
+#endif
+    return out;
 }
 
 /// The item is only allocated and initialized, but NOT included into the queue! The caller needs to do that.
-CANARD_PRIVATE TxItem* txAllocateQueueItem(CanardInstance* const   ins,
+/// If the queue is backed by a frame pool, the item is taken from the pool; otherwise, the instance allocator is used.
+CANARD_PRIVATE TxItem* txAllocateQueueItem(CanardTxQueue* const    que,
+                                           CanardInstance* const   ins,
                                            const uint32_t          id,
                                            const CanardMicrosecond deadline_usec,
                                            const size_t            payload_size)
 {
+    CANARD_ASSERT(que != NULL);
     CANARD_ASSERT(ins != NULL);
     CANARD_ASSERT(payload_size > 0U);
-    TxItem* const out = (TxItem*) ins->memory_allocate(ins, sizeof(TxItem) + payload_size);
+    TxItem* out = NULL;
+    if (que->pool.block_size > 0U)
+    {
+        CANARD_ASSERT(txGetItemSize(payload_size) <= que->pool.block_size);
+        out = (TxItem*) poolAllocate(&que->pool);
+    }
+    else
+    {
+        out = (TxItem*) insAllocate(ins, txGetItemSize(payload_size));
+    }
     if (out != NULL)
     {
         out->base.base.up    = NULL;
@@ -312,6 +899,14 @@ CANARD_PRIVATE TxItem* txAllocateQueueItem(CanardInstance* const   ins,
         out->base.base.lr[1] = NULL;
         out->base.base.bf    = 0;
 
+#if CANARD_TX_DEADLINE_INDEX
+        out->base.deadline.base.up    = NULL;
+        out->base.deadline.base.lr[0] = NULL;
+        out->base.deadline.base.lr[1] = NULL;
+        out->base.deadline.base.bf    = 0;
+        out->base.deadline.owner      = &out->base;
+#endif
+
         out->base.next_in_transfer = NULL;  // Last by default.
         out->base.tx_deadline_usec = deadline_usec;
 
@@ -322,6 +917,90 @@ CANARD_PRIVATE TxItem* txAllocateQueueItem(CanardInstance* const   ins,
     return out;
 }
 
+/// The data pointer shall be obtained from canardTxAllocatePayload().
+CANARD_PRIVATE TxSharedPayload* txSharedPayloadFromData(void* const data)
+{
+    CANARD_ASSERT(data != NULL);
+    // Intentional violation of MISRA: pointer arithmetics. This is the inverse of taking the address of the flex array.
+    return (TxSharedPayload*) (void*) (((uint8_t*) data) - offsetof(TxSharedPayload, data));  // NOSONAR
+}
+
+/// Returns false if the frame is not lazily materialized, in which case the reference is not populated.
+/// The fixed-size frames are always materialized eagerly because the reference may not even fit into them.
+CANARD_PRIVATE bool txGetSharedPayloadRef(const CanardTxQueueItem* const item, TxSharedPayloadRef* const out_ref)
+{
+    CANARD_ASSERT((item != NULL) && (out_ref != NULL));
+#if CANARD_FIXED_MTU
+    CANARD_ASSERT(item->frame.payload != NULL);
+    (void) item;
+    (void) out_ref;
+    return false;
+#else
+    const bool out = (NULL == item->frame.payload);
+    if (out)
+    {
+        // NOLINTNEXTLINE the safe functions like memcpy_s() are poorly supported; see txPayloadRead().
+        (void) memcpy(out_ref, &((const TxItem*) (const void*) item)->payload_buffer[0], sizeof(TxSharedPayloadRef));
+    }
+    return out;
+#endif
+}
+
+/// The number of bytes of the frame stored in the item itself: all of them unless the frame is lazily materialized.
+CANARD_PRIVATE size_t txGetItemBufferSize(const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT(item != NULL);
+    TxSharedPayloadRef ref = {NULL, 0U, 0U};
+    return txGetSharedPayloadRef(item, &ref) ? ((item->frame.payload_size - ref.size) + sizeof(TxSharedPayloadRef))
+                                             : item->frame.payload_size;
+}
+
+/// The tail byte is always stored in the item itself, even if the frame is lazily materialized.
+CANARD_PRIVATE uint8_t txGetTailByte(const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((item != NULL) && (item->frame.payload_size > 0U));
+    TxSharedPayloadRef ref    = {NULL, 0U, 0U};
+    const size_t       offset = txGetSharedPayloadRef(item, &ref)
+                                    ? ((item->frame.payload_size - ref.size) + sizeof(TxSharedPayloadRef))
+                                    : item->frame.payload_size;
+    return ((const TxItem*) (const void*) item)->payload_buffer[offset - 1U];
+}
+
+/// Drops one reference to the shared block and deallocates it if it is no longer referenced. The pointer may be NULL.
+CANARD_PRIVATE void txSharedPayloadRelease(CanardInstance* const ins, TxSharedPayload* const shared)
+{
+    CANARD_ASSERT(ins != NULL);
+    if (shared != NULL)
+    {
+        CANARD_ASSERT(shared->ref_count > 0U);
+        shared->ref_count--;
+        if (0U == shared->ref_count)
+        {
+            ins->memory_free(ins, shared);
+        }
+    }
+}
+
+/// The counterpart of txAllocateQueueItem(). The item shall not be in the queue. The pointer may be NULL.
+CANARD_PRIVATE void txFreeQueueItem(CanardTxQueue* const que, CanardInstance* const ins, CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT(que != NULL);
+    CANARD_ASSERT(ins != NULL);
+    TxSharedPayloadRef ref = {NULL, 0U, 0U};
+    if ((item != NULL) && txGetSharedPayloadRef(item, &ref))
+    {
+        txSharedPayloadRelease(ins, ref.shared);
+    }
+    if (que->pool.block_size > 0U)
+    {
+        poolFree(&que->pool, item);
+    }
+    else
+    {
+        ins->memory_free(ins, item);
+    }
+}
+
 /// Frames with identical CAN ID that are added later always compare greater than their counterparts with same CAN ID.
 /// This ensures that CAN frames with the same CAN ID are transmitted in the FIFO order.
 /// Frames that should be transmitted earlier compare smaller (i.e., put on the left side of the tree).
@@ -334,84 +1013,649 @@ CANARD_PRIVATE int8_t txAVLPredicate(void* const user_reference,  // NOSONAR Cav
     return (target->frame.extended_can_id >= other->frame.extended_can_id) ? +1 : -1;
 }
 
-/// Returns the number of frames enqueued or error (i.e., =1 or <0).
-CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
-                                         CanardInstance* const   ins,
-                                         const CanardMicrosecond deadline_usec,
-                                         const uint32_t          can_id,
-                                         const CanardTransferID  transfer_id,
-                                         const size_t            payload_size,
-                                         const void* const       payload)
+/// The number of frames needed to transmit a transfer with the specified payload size.
+CANARD_PRIVATE size_t txCountFrames(const size_t presentation_layer_mtu, const size_t payload_size)
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT((payload != NULL) || (payload_size == 0));
-    const size_t frame_payload_size = txRoundFramePayloadSizeUp(payload_size + 1U);
-    CANARD_ASSERT(frame_payload_size > payload_size);
-    const size_t padding_size = frame_payload_size - payload_size - 1U;
-    CANARD_ASSERT((padding_size + payload_size + 1U) == frame_payload_size);
-    int32_t       out = 0;
-    TxItem* const tqi =
-        (que->size < que->capacity) ? txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size) : NULL;
-    if (tqi != NULL)
+    CANARD_ASSERT(presentation_layer_mtu > 0U);
+    size_t out = 1U;
+    if (payload_size > presentation_layer_mtu)
     {
-        if (payload_size > 0U)  // The check is needed to avoid calling memcpy() with a NULL pointer, it's an UB.
-        {
-            CANARD_ASSERT(payload != NULL);
-            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            (void) memcpy(&tqi->payload_buffer[0], payload, payload_size);  // NOLINT
-        }
-        // Clang-Tidy raises an error recommending the use of memset_s() instead.
-        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-        (void) memset(&tqi->payload_buffer[payload_size], PADDING_BYTE_VALUE, padding_size);  // NOLINT
-        tqi->payload_buffer[frame_payload_size - 1U] = txMakeTailByte(true, true, true, transfer_id);
-        // Insert the newly created TX item into the queue.
-        const CanardTreeNode* const res = cavlSearch(&que->root, &tqi->base.base, &txAVLPredicate, &avlTrivialFactory);
-        (void) res;
-        CANARD_ASSERT(res == &tqi->base.base);
-        que->size++;
-        CANARD_ASSERT(que->size <= que->capacity);
-        out = 1;  // One frame enqueued.
+        const size_t payload_size_with_crc = payload_size + CRC_SIZE_BYTES;
+        out = ((payload_size_with_crc + presentation_layer_mtu) - 1U) / presentation_layer_mtu;
+        CANARD_ASSERT(out >= 2U);
     }
-    else
+    return out;
+}
+
+#if CANARD_TX_DEADLINE_INDEX
+/// Orders the deadline index by deadline. Frames with identical deadline are FIFO-ordered, same as txAVLPredicate().
+CANARD_PRIVATE int8_t
+txDeadlinePredicate(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
+                    const CanardTreeNode* const node)
+{
+    const CanardTxQueueItem* const target = (const CanardTxQueueItem*) user_reference;
+    const CanardTxQueueItem* const other  = ((const CanardTxDeadlineNode*) node)->owner;
+    CANARD_ASSERT((target != NULL) && (other != NULL));
+    return (target->tx_deadline_usec >= other->tx_deadline_usec) ? +1 : -1;
+}
+
+CANARD_PRIVATE CanardTreeNode* txDeadlineFactory(void* const user_reference)
+{
+    return &((CanardTxQueueItem*) user_reference)->deadline.base;
+}
+#endif
+
+CANARD_PRIVATE size_t txGetPriority(const uint32_t can_id)
+{
+    return (size_t) ((can_id >> OFFSET_PRIORITY) & CANARD_PRIORITY_MAX);
+}
+
+/// Bucket engine: the bucket index is the priority level of the frame.
+CANARD_PRIVATE size_t txBucketOf(const CanardTreeNode* const node)
+{
+    return txGetPriority(((const CanardTxQueueItem*) node)->frame.extended_can_id);
+}
+
+/// True if the specified number of new frames per priority level can be accepted considering the capacity
+/// reservations; see CanardTxQueue.reserved. Without reservations, this is equivalent to (size + demand) <= capacity.
+/// The new frames that fit into the reservations of their levels are accepted even if the shared part is overcommitted.
+CANARD_PRIVATE bool txHasRoom(const CanardTxQueue* const que, const size_t* const demand)
+{
+    CANARD_ASSERT((que != NULL) && (demand != NULL));
+    size_t total    = que->size;
+    size_t reserved = 0U;
+    size_t overflow = 0U;  // The number of frames beyond the reservations of their levels; they use the shared part.
+    bool   grows    = false;
+    for (size_t i = 0U; i <= CANARD_PRIORITY_MAX; i++)
     {
-        out = -CANARD_ERROR_OUT_OF_MEMORY;
+        const size_t wanted = que->size_by_priority[i] + demand[i];
+        total += demand[i];
+        reserved += que->reserved[i];
+        overflow += (wanted > que->reserved[i]) ? (wanted - que->reserved[i]) : 0U;
+        grows = grows || ((demand[i] > 0U) && (wanted > que->reserved[i]));
     }
-    CANARD_ASSERT((out < 0) || (out == 1));
-    return out;
+    const size_t shared = (que->capacity > reserved) ? (que->capacity - reserved) : 0U;
+    return (total <= que->capacity) && ((!grows) || (overflow <= shared));
 }
 
-/// Produces a chain of Tx queue items for later insertion into the Tx queue. The tail is NULL if OOM.
-CANARD_PRIVATE TxChain txGenerateMultiFrameChain(CanardInstance* const   ins,
-                                                 const size_t            presentation_layer_mtu,
-                                                 const CanardMicrosecond deadline_usec,
-                                                 const uint32_t          can_id,
-                                                 const CanardTransferID  transfer_id,
-                                                 const size_t            payload_size,
-                                                 const void* const       payload)
+/// A shortcut for txHasRoom() where all new frames share the priority level of the CAN ID.
+CANARD_PRIVATE bool txHasRoomAt(const CanardTxQueue* const que, const uint32_t can_id, const size_t num_frames)
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(presentation_layer_mtu > 0U);
-    CANARD_ASSERT(payload_size > presentation_layer_mtu);  // Otherwise, a single-frame transfer should be used.
-    CANARD_ASSERT(payload != NULL);
+    size_t demand[CANARD_PRIORITY_MAX + 1U] = {0U};
+    demand[txGetPriority(can_id)]           = num_frames;
+    return txHasRoom(que, demand);
+}
 
-    TxChain        out                   = {NULL, NULL, 0};
-    const size_t   payload_size_with_crc = payload_size + CRC_SIZE_BYTES;
-    size_t         offset                = 0U;
-    TransferCRC    crc                   = crcAdd(CRC_INITIAL, payload_size, payload);
-    bool           toggle                = INITIAL_TOGGLE_STATE;
-    const uint8_t* payload_ptr           = (const uint8_t*) payload;
-    while (offset < payload_size_with_crc)
+/// Bucket engine: the top element is the head of the highest-priority non-empty bucket. Constant complexity.
+CANARD_PRIVATE CanardTreeNode* txBucketFindTop(const CanardTxQueue* const que)
+{
+    CANARD_ASSERT(que != NULL);
+    CanardTreeNode* out = NULL;
+    if (que->bucket_mask != 0U)
     {
-        out.size++;
-        const size_t frame_payload_size_with_tail =
-            ((payload_size_with_crc - offset) < presentation_layer_mtu)
-                ? txRoundFramePayloadSizeUp((payload_size_with_crc - offset) + 1U)  // Padding in the last frame only.
-                : (presentation_layer_mtu + 1U);
-        TxItem* const tqi = txAllocateQueueItem(ins, can_id, deadline_usec, frame_payload_size_with_tail);
-        if (NULL == out.head)
+        size_t i = 0U;
+        while ((que->bucket_mask & (1U << i)) == 0U)
         {
-            out.head = tqi;
+            ++i;
+        }
+        CANARD_ASSERT(i <= CANARD_PRIORITY_MAX);
+        out = que->bucket_head[i];
+        CANARD_ASSERT(out != NULL);
+    }
+    return out;
+}
+
+/// Bucket engine: each bucket is a doubly-linked list ordered by CAN ID, where lr[0] points to the previous element
+/// and lr[1] points to the next one. The list is scanned from the tail, so pushing frames in the order of
+/// non-decreasing CAN ID is O(1). Frames with identical CAN ID are kept in the FIFO order.
+CANARD_PRIVATE void txBucketInsert(CanardTxQueue* const que, CanardTreeNode* const node)
+{
+    CANARD_ASSERT((que != NULL) && (node != NULL));
+    const size_t    bucket = txBucketOf(node);
+    const uint32_t  can_id = ((const CanardTxQueueItem*) node)->frame.extended_can_id;
+    CanardTreeNode* prev   = que->bucket_tail[bucket];
+    while ((prev != NULL) && (((const CanardTxQueueItem*) prev)->frame.extended_can_id > can_id))
+    {
+        prev = prev->lr[0];
+    }
+    node->up    = NULL;
+    node->lr[0] = prev;
+    node->lr[1] = (prev != NULL) ? prev->lr[1] : que->bucket_head[bucket];
+    if (node->lr[1] != NULL)
+    {
+        node->lr[1]->lr[0] = node;
+    }
+    else
+    {
+        que->bucket_tail[bucket] = node;
+    }
+    if (prev != NULL)
+    {
+        prev->lr[1] = node;
+    }
+    else
+    {
+        que->bucket_head[bucket] = node;
+    }
+    que->bucket_mask = (uint8_t) (que->bucket_mask | (1U << bucket));
+    if ((NULL == que->root) || (can_id < ((const CanardTxQueueItem*) que->root)->frame.extended_can_id))
+    {
+        que->root = node;  // Frames with identical CAN ID are FIFO-ordered so the new one cannot become the top.
+    }
+}
+
+CANARD_PRIVATE void txBucketRemove(CanardTxQueue* const que, CanardTreeNode* const node)
+{
+    CANARD_ASSERT((que != NULL) && (node != NULL));
+    const size_t bucket = txBucketOf(node);
+    if (node->lr[0] != NULL)
+    {
+        node->lr[0]->lr[1] = node->lr[1];
+    }
+    else
+    {
+        CANARD_ASSERT(que->bucket_head[bucket] == node);
+        que->bucket_head[bucket] = node->lr[1];
+    }
+    if (node->lr[1] != NULL)
+    {
+        node->lr[1]->lr[0] = node->lr[0];
+    }
+    else
+    {
+        CANARD_ASSERT(que->bucket_tail[bucket] == node);
+        que->bucket_tail[bucket] = node->lr[0];
+    }
+    node->lr[0] = NULL;
+    node->lr[1] = NULL;
+    if (NULL == que->bucket_head[bucket])
+    {
+        que->bucket_mask = (uint8_t) (que->bucket_mask & ~(1U << bucket));
+    }
+    que->root = txBucketFindTop(que);
+}
+
+/// Tree engine: updates the cached top after the item has been inserted into the tree.
+/// Frames with identical CAN ID are FIFO-ordered so the new one becomes the top only if its CAN ID is strictly lower.
+CANARD_PRIVATE void txTreeUpdateTopOnInsert(CanardTxQueue* const que, CanardTreeNode* const node)
+{
+    if ((NULL == que->tree_top) || (((const CanardTxQueueItem*) node)->frame.extended_can_id <
+                                    ((const CanardTxQueueItem*) que->tree_top)->frame.extended_can_id))
+    {
+        que->tree_top = node;
+    }
+    CANARD_ASSERT(que->tree_top == cavlFindExtremum(que->root, false));
+}
+
+/// Inserts one frame into the queue. The size of the queue is not updated; this is the responsibility of the caller.
+/// The size per priority level is updated here.
+CANARD_PRIVATE void txQueueInsert(CanardTxQueue* const que, TxItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    if (CanardTxQueueEngineBuckets == que->engine)
+    {
+        txBucketInsert(que, &item->base.base);
+    }
+    else
+    {
+        const CanardTreeNode* const res = cavlSearch(&que->root, &item->base.base, &txAVLPredicate, &avlTrivialFactory);
+        (void) res;
+        CANARD_ASSERT(res == &item->base.base);
+        txTreeUpdateTopOnInsert(que, &item->base.base);
+    }
+    que->size_by_priority[txGetPriority(item->base.frame.extended_can_id)]++;
+    CANARD_ASSERT(que->root != NULL);
+#if CANARD_TX_DEADLINE_INDEX
+    if (item->base.tx_deadline_usec > 0U)  // Zero deadline means that the deadline is not used.
+    {
+        const CanardTreeNode* const res =
+            cavlSearch(&que->deadline_root, &item->base, &txDeadlinePredicate, &txDeadlineFactory);
+        (void) res;
+        CANARD_ASSERT(res == &item->base.deadline.base);
+    }
+#endif
+}
+
+/// Inserts the frame immediately after the previous frame of the same transfer without searching the trees.
+/// This is valid because all frames of a transfer share the CAN ID and the deadline, and the trees order equal keys
+/// FIFO, so no other frame can be placed between the two. The size of the queue is not updated (but see txQueueInsert).
+CANARD_PRIVATE void txQueueInsertAfter(CanardTxQueue* const     que,
+                                       CanardTxQueueItem* const prev,
+                                       CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (prev != NULL) && (item != NULL));
+    CANARD_ASSERT(prev->frame.extended_can_id == item->frame.extended_can_id);
+    CANARD_ASSERT(prev->tx_deadline_usec == item->tx_deadline_usec);
+    if (CanardTxQueueEngineBuckets == que->engine)
+    {
+        txBucketInsert(que, &item->base);  // The bucket engine scans from the tail so it is already fast here.
+    }
+    else
+    {
+        cavlInsertAfter(&que->root, &prev->base, &item->base);
+        CANARD_ASSERT(que->tree_top == cavlFindExtremum(que->root, false));  // Cannot be the new top.
+    }
+    que->size_by_priority[txGetPriority(item->frame.extended_can_id)]++;
+#if CANARD_TX_DEADLINE_INDEX
+    if (item->tx_deadline_usec > 0U)
+    {
+        cavlInsertAfter(&que->deadline_root, &prev->deadline.base, &item->deadline.base);
+    }
+#endif
+}
+
+/// Removes one frame from the queue. The size of the queue is not updated; this is the responsibility of the caller.
+/// The size per priority level is updated here.
+CANARD_PRIVATE void txQueueRemove(CanardTxQueue* const que, CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    CANARD_ASSERT(que->size_by_priority[txGetPriority(item->frame.extended_can_id)] > 0U);
+    que->size_by_priority[txGetPriority(item->frame.extended_can_id)]--;
+    if (CanardTxQueueEngineBuckets == que->engine)
+    {
+        txBucketRemove(que, &item->base);
+    }
+    else
+    {
+        if (que->tree_top == &item->base)
+        {
+            que->tree_top = cavlNext(&item->base);  // The successor of the leftmost node is the new leftmost node.
+        }
+        cavlRemove(&que->root, &item->base);
+        CANARD_ASSERT(que->tree_top == cavlFindExtremum(que->root, false));
+        // Cavl does not reset the links of the removed node; we need that to tell enqueued items from removed ones.
+        item->base.up    = NULL;
+        item->base.lr[0] = NULL;
+        item->base.lr[1] = NULL;
+        item->base.bf    = 0;
+    }
+#if CANARD_TX_DEADLINE_INDEX
+    if (item->tx_deadline_usec > 0U)
+    {
+        cavlRemove(&que->deadline_root, &item->deadline.base);
+    }
+#endif
+}
+
+/// True if the item is currently in the queue; false if it has been removed or was never inserted.
+/// This relies on txQueueRemove() resetting the links of the removed items. Constant complexity.
+CANARD_PRIVATE bool txQueueContains(const CanardTxQueue* const que, const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    bool out = false;
+    if (CanardTxQueueEngineBuckets == que->engine)
+    {
+        out = (item->base.lr[0] != NULL) || (que->bucket_head[txBucketOf(&item->base)] == &item->base);
+    }
+    else
+    {
+        out = (item->base.up != NULL) || (que->root == &item->base);
+    }
+    return out;
+}
+
+/// Returns the next frame to transmit or NULL if the queue is empty.
+CANARD_PRIVATE CanardTxQueueItem* txQueueFindTop(const CanardTxQueue* const que)
+{
+    CANARD_ASSERT(que != NULL);
+    // Paragraph 6.7.2.1.15 of the C standard says:
+    //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
+    return (CanardTxQueueItem*) ((CanardTxQueueEngineBuckets == que->engine) ? que->root : que->tree_top);
+}
+
+/// Returns the frame that follows the specified one in the transmission order, or NULL if it is the last one.
+/// The bucket engine continues with the next non-empty bucket after the end of the current one.
+CANARD_PRIVATE CanardTxQueueItem* txQueueFindNext(const CanardTxQueue* const que, const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (item != NULL));
+    CanardTreeNode* out = NULL;
+    if (CanardTxQueueEngineBuckets == que->engine)
+    {
+        out = item->base.lr[1];
+        for (size_t i = txBucketOf(&item->base) + 1U; (NULL == out) && (i <= CANARD_PRIORITY_MAX); i++)
+        {
+            out = que->bucket_head[i];
+        }
+    }
+    else
+    {
+        out = cavlNext(&item->base);
+    }
+    return (CanardTxQueueItem*) out;
+}
+
+/// Removes an expired frame from the queue and deallocates it; see canardTxPurgeExpired().
+CANARD_PRIVATE void txPurgeItem(CanardTxQueue* const que, CanardInstance* const ins, CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (item != NULL));
+    txQueueRemove(que, item);
+    CANARD_ASSERT(que->size > 0U);
+    que->size--;
+    txFreeQueueItem(que, ins, item);
+#if CANARD_STATS
+    que->stats.frames_expired++;
+#endif
+    insTrace(ins, CanardTraceEventTxExpired, NULL);
+}
+
+/// Returns the shaper of the port the frame belongs to, or NULL if the port is not shaped.
+CANARD_PRIVATE CanardTxShaper* txShaperFind(const CanardTxQueue* const que, const uint32_t can_id)
+{
+    CANARD_ASSERT(que != NULL);
+    CanardTransferKind kind    = CanardTransferKindMessage;
+    CanardPortID       port_id = (CanardPortID) ((can_id >> OFFSET_SUBJECT_ID) & CANARD_SUBJECT_ID_MAX);
+    if ((can_id & FLAG_SERVICE_NOT_MESSAGE) != 0U)
+    {
+        kind    = ((can_id & FLAG_REQUEST_NOT_RESPONSE) != 0U) ? CanardTransferKindRequest : CanardTransferKindResponse;
+        port_id = (CanardPortID) ((can_id >> OFFSET_SERVICE_ID) & CANARD_SERVICE_ID_MAX);
+    }
+    CanardTxShaper* out = que->shapers;
+    while ((out != NULL) && ((out->transfer_kind != kind) || (out->port_id != port_id)))
+    {
+        out = out->next;
+    }
+    return out;
+}
+
+/// The credit of a full bucket; see CanardTxShaper.
+CANARD_PRIVATE int64_t txShaperGetCreditMax(const CanardTxShaper* const shaper)
+{
+    return ((int64_t) shaper->burst_bytes) * MICROSECONDS_PER_SECOND;
+}
+
+/// Brings the credit up to date. Time going backwards is ignored.
+CANARD_PRIVATE void txShaperRefill(CanardTxShaper* const shaper, const CanardMicrosecond now_usec)
+{
+    CANARD_ASSERT(shaper != NULL);
+    const int64_t credit_max = txShaperGetCreditMax(shaper);
+    if (now_usec > shaper->credit_timestamp_usec)
+    {
+        if ((shaper->credit < credit_max) && (shaper->rate_bytes_per_second > 0U))
+        {
+            // The elapsed time is limited before the multiplication to avoid the overflow.
+            const uint64_t deficit   = (uint64_t) (credit_max - shaper->credit);
+            const uint64_t fill_usec = (deficit / shaper->rate_bytes_per_second) + 1U;
+            const uint64_t dt_usec   = now_usec - shaper->credit_timestamp_usec;
+            shaper->credit += (int64_t) (((dt_usec < fill_usec) ? dt_usec : fill_usec) * shaper->rate_bytes_per_second);
+        }
+        shaper->credit_timestamp_usec = now_usec;
+    }
+    shaper->credit = (shaper->credit > credit_max) ? credit_max : shaper->credit;
+}
+
+/// The credit required to transmit the frame; a frame larger than the burst requires a full bucket.
+CANARD_PRIVATE int64_t txShaperGetCost(const CanardTxShaper* const shaper, const CanardTxQueueItem* const item)
+{
+    CANARD_ASSERT((shaper != NULL) && (item != NULL));
+    const int64_t cost       = ((int64_t) item->frame.payload_size) * MICROSECONDS_PER_SECOND;
+    const int64_t credit_max = txShaperGetCreditMax(shaper);
+    return (cost < credit_max) ? cost : credit_max;
+}
+
+/// Frees all items starting from the specified one following the next_in_transfer links. The items shall not be
+/// in the queue. The pointer may be NULL.
+CANARD_PRIVATE void txFreeChain(CanardTxQueue* const que, CanardInstance* const ins, CanardTxQueueItem* const head)
+{
+    CanardTxQueueItem* item = head;
+    while (item != NULL)
+    {
+        CanardTxQueueItem* const next = item->next_in_transfer;
+        txFreeQueueItem(que, ins, item);
+        item = next;
+    }
+}
+
+/// Serializes a transfer frame by frame into arbitrary buffers. This is the only place where the frame layout of the
+/// transfers is defined; all TX paths build their frames with it. The CRC is computed incrementally as the payload is
+/// being written, unless the payload is shared (see txFrameWriterShare()).
+typedef struct
+{
+    TxPayloadReader  reader;
+    size_t           presentation_layer_mtu;
+    size_t           payload_size;
+    size_t           payload_size_with_crc;  ///< Single-frame transfers have no CRC.
+    size_t           offset;                 ///< The number of bytes of the payload and the CRC written so far.
+    size_t           frame_count;            ///< The number of frames written so far.
+    TransferCRC      crc;
+    bool             toggle;
+    CanardTransferID transfer_id;
+    /// If not NULL, the payload bytes are referenced from this block by the frames instead of being written;
+    /// see txFrameWriterGetNextSharedSize().
+    TxSharedPayload* shared;
+} TxFrameWriter;
+
+CANARD_PRIVATE TxFrameWriter txFrameWriterInit(const size_t           presentation_layer_mtu,
+                                               const CanardTransferID transfer_id,
+                                               const size_t           payload_size,
+                                               const TxPayloadReader  reader)
+{
+    CANARD_ASSERT(presentation_layer_mtu > 0U);
+    const bool          multi_frame = payload_size > presentation_layer_mtu;
+    const TxFrameWriter out         = {
+        .reader                 = reader,
+        .presentation_layer_mtu = presentation_layer_mtu,
+        .payload_size           = payload_size,
+        .payload_size_with_crc  = multi_frame ? (payload_size + CRC_SIZE_BYTES) : payload_size,
+        .offset                 = 0U,
+        .frame_count            = 0U,
+        .crc                    = CRC_INITIAL,
+        .toggle                 = INITIAL_TOGGLE_STATE,
+        .transfer_id            = transfer_id,
+        .shared                 = NULL,
+    };
+    return out;
+}
+
+/// Makes the frames refer to the payload in the shared block instead of containing it. Only multi-frame transfers
+/// can be shared; the writer shall not have written anything yet. The CRC of the payload is computed here at once.
+CANARD_PRIVATE void txFrameWriterShare(TxFrameWriter* const writer, TxSharedPayload* const shared)
+{
+    CANARD_ASSERT((writer != NULL) && (shared != NULL));
+    CANARD_ASSERT((0U == writer->frame_count) && (writer->payload_size_with_crc > writer->payload_size));
+    writer->shared = shared;
+    writer->crc    = crcAdd(writer->crc, writer->payload_size, &shared->data[0]);
+}
+
+/// Returns the payload size of the next frame including the tail byte, or zero if all frames have been written.
+CANARD_PRIVATE size_t txFrameWriterGetNextSize(const TxFrameWriter* const writer)
+{
+    CANARD_ASSERT(writer != NULL);
+    size_t out = 0U;
+    if ((0U == writer->frame_count) || (writer->offset < writer->payload_size_with_crc))
+    {
+        const size_t remaining = writer->payload_size_with_crc - writer->offset;
+        out                    = (remaining < writer->presentation_layer_mtu)
+                                     ? txRoundFramePayloadSizeUp(remaining + 1U)  // Padding in the last frame only.
+                                     : (writer->presentation_layer_mtu + 1U);
+    }
+    return out;
+}
+
+/// Returns the number of leading bytes of the next frame that are referenced from the shared block rather than
+/// written by txFrameWriterWrite(). The frames that contain only the CRC are written entirely.
+CANARD_PRIVATE size_t txFrameWriterGetNextSharedSize(const TxFrameWriter* const writer)
+{
+    CANARD_ASSERT(writer != NULL);
+    size_t out = 0U;
+    if ((writer->shared != NULL) && (writer->offset < writer->payload_size))
+    {
+        const size_t frame_size = txFrameWriterGetNextSize(writer);
+        CANARD_ASSERT(frame_size > 0U);
+        out = writer->payload_size - writer->offset;
+        if (out > (frame_size - 1U))
+        {
+            out = frame_size - 1U;
+        }
+    }
+    return out;
+}
+
+/// Writes the next frame into the destination buffer, which shall be txFrameWriterGetNextSize() bytes large less
+/// the txFrameWriterGetNextSharedSize() leading bytes that are referenced from the shared block instead.
+CANARD_PRIVATE void txFrameWriterWrite(TxFrameWriter* const writer, uint8_t* const destination)
+{
+    CANARD_ASSERT((writer != NULL) && (destination != NULL));
+    const size_t frame_payload_size_with_tail = txFrameWriterGetNextSize(writer);
+    CANARD_ASSERT(frame_payload_size_with_tail > 0U);
+    const size_t frame_payload_size = frame_payload_size_with_tail - 1U;
+    const size_t shared_size        = txFrameWriterGetNextSharedSize(writer);
+    const bool   multi_frame        = writer->payload_size_with_crc > writer->payload_size;
+    size_t       frame_offset       = shared_size;  // The destination buffer begins after the shared bytes.
+    writer->offset += shared_size;
+    if ((0U == shared_size) && (writer->offset < writer->payload_size))
+    {
+        size_t move_size = writer->payload_size - writer->offset;
+        if (move_size > frame_payload_size)
+        {
+            move_size = frame_payload_size;
+        }
+        const size_t copied = txPayloadRead(&writer->reader, move_size, destination);
+        (void) copied;
+        CANARD_ASSERT(copied == move_size);
+        if (multi_frame)
+        {
+            writer->crc = crcAdd(writer->crc, move_size, destination);
+        }
+        frame_offset = move_size;
+        writer->offset += move_size;
+    }
+    if (writer->offset >= writer->payload_size)
+    {
+        // Insert padding -- only in the last frame. Don't forget to include padding into the CRC.
+        const size_t crc_size = multi_frame ? CRC_SIZE_BYTES : 0U;
+        while ((frame_offset + crc_size) < frame_payload_size)
+        {
+            destination[frame_offset - shared_size] = PADDING_BYTE_VALUE;
+            ++frame_offset;
+            writer->crc = crcAddByte(writer->crc, PADDING_BYTE_VALUE);
+        }
+        // Insert the CRC; it may be split between the last two frames.
+        if ((frame_offset < frame_payload_size) && (writer->offset == writer->payload_size))
+        {
+            // SonarQube incorrectly detects a buffer overflow here.
+            destination[frame_offset - shared_size] = (uint8_t) (writer->crc >> BITS_PER_BYTE);  // NOSONAR
+            ++frame_offset;
+            ++writer->offset;
+        }
+        if ((frame_offset < frame_payload_size) && (writer->offset > writer->payload_size))
+        {
+            destination[frame_offset - shared_size] = (uint8_t) (writer->crc & BYTE_MAX);
+            ++frame_offset;
+            ++writer->offset;
+        }
+    }
+    CANARD_ASSERT((frame_offset + 1U) == frame_payload_size_with_tail);
+    // SonarQube incorrectly detects a buffer overflow here.
+    destination[frame_offset - shared_size] = txMakeTailByte(0U == writer->frame_count,  // NOSONAR
+                                                             writer->offset >= writer->payload_size_with_crc,
+                                                             writer->toggle,
+                                                             writer->transfer_id);
+    writer->toggle = !writer->toggle;
+    writer->frame_count++;
+}
+
+/// Allocates and populates a single-frame transfer without inserting it into the queue. Returns NULL if OOM.
+CANARD_PRIVATE TxItem* txGenerateSingleFrame(CanardTxQueue* const    que,
+                                             CanardInstance* const   ins,
+                                             const size_t            presentation_layer_mtu,
+                                             const CanardMicrosecond deadline_usec,
+                                             const uint32_t          can_id,
+                                             const CanardTransferID  transfer_id,
+                                             const size_t            payload_size,
+                                             TxPayloadReader* const  reader)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(reader != NULL);
+    CANARD_ASSERT(payload_size <= presentation_layer_mtu);
+    TxFrameWriter writer = txFrameWriterInit(presentation_layer_mtu, transfer_id, payload_size, *reader);
+    TxItem* const tqi    = txAllocateQueueItem(que, ins, can_id, deadline_usec, txFrameWriterGetNextSize(&writer));
+    if (tqi != NULL)
+    {
+        txFrameWriterWrite(&writer, &tqi->payload_buffer[0]);
+        CANARD_ASSERT(0U == txFrameWriterGetNextSize(&writer));
+        *reader = writer.reader;
+    }
+    return tqi;
+}
+
+/// Returns the number of frames enqueued or error (i.e., =1 or <0).
+CANARD_PRIVATE int32_t txPushSingleFrame(CanardTxQueue* const    que,
+                                         CanardInstance* const   ins,
+                                         const size_t            presentation_layer_mtu,
+                                         const CanardMicrosecond deadline_usec,
+                                         const uint32_t          can_id,
+                                         const CanardTransferID  transfer_id,
+                                         const size_t            payload_size,
+                                         TxPayloadReader* const  reader)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(reader != NULL);
+    int32_t out = 0;
+    TxItem* tqi = NULL;
+    if (txHasRoomAt(que, can_id, 1U))
+    {
+        tqi = txGenerateSingleFrame(que,
+                                    ins,
+                                    presentation_layer_mtu,
+                                    deadline_usec,
+                                    can_id,
+                                    transfer_id,
+                                    payload_size,
+                                    reader);
+    }
+    if (tqi != NULL)
+    {
+        txQueueInsert(que, tqi);  // Insert the newly created TX item into the queue.
+        que->size++;
+        CANARD_ASSERT(que->size <= que->capacity);
+        out = 1;  // One frame enqueued.
+    }
+    else
+    {
+        out = -CANARD_ERROR_OUT_OF_MEMORY;
+    }
+    CANARD_ASSERT((out < 0) || (out == 1));
+    return out;
+}
+
+/// Produces a chain of Tx queue items for later insertion into the Tx queue. The tail is NULL if OOM.
+CANARD_PRIVATE TxChain txGenerateMultiFrameChain(CanardTxQueue* const    que,
+                                                 CanardInstance* const   ins,
+                                                 const size_t            presentation_layer_mtu,
+                                                 const CanardMicrosecond deadline_usec,
+                                                 const uint32_t          can_id,
+                                                 const CanardTransferID  transfer_id,
+                                                 const size_t            payload_size,
+                                                 TxPayloadReader* const  reader)
+{
+    CANARD_ASSERT(que != NULL);
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(presentation_layer_mtu > 0U);
+    CANARD_ASSERT(payload_size > presentation_layer_mtu);  // Otherwise, a single-frame transfer should be used.
+    CANARD_ASSERT(reader != NULL);
+
+    TxChain       out    = {NULL, NULL, 0};
+    TxFrameWriter writer = txFrameWriterInit(presentation_layer_mtu, transfer_id, payload_size, *reader);
+
+    // If the payload is shared, the frames refer to it instead of copying it. This is pointless with a frame pool,
+    // and also with the fixed-size item storage, where the reference would not even fit into a Classic CAN frame.
+    TxSharedPayload* const shared = ((0U == que->pool.block_size) && (0U == CANARD_FIXED_MTU)) ? reader->shared : NULL;
+    if (shared != NULL)
+    {
+        txFrameWriterShare(&writer, shared);
+    }
+    size_t frame_size = txFrameWriterGetNextSize(&writer);
+    while (frame_size > 0U)
+    {
+        out.size++;
+        // The own bytes of the frame follow the shared block reference (if any) in the frame buffer.
+        const size_t  shared_size = txFrameWriterGetNextSharedSize(&writer);
+        const size_t  own_offset  = (shared_size > 0U) ? sizeof(TxSharedPayloadRef) : 0U;
+        const size_t  own_size    = (frame_size - shared_size) + own_offset;
+        TxItem* const tqi         = txAllocateQueueItem(que, ins, can_id, deadline_usec, own_size);
+        if (NULL == out.head)
+        {
+            out.head = tqi;
         }
         else
         {
@@ -422,63 +1666,41 @@ CANARD_PRIVATE TxChain txGenerateMultiFrameChain(CanardInstance* const   ins,
         {
             break;
         }
-
-        // Copy the payload into the frame.
-        const size_t frame_payload_size = frame_payload_size_with_tail - 1U;
-        size_t       frame_offset       = 0U;
-        if (offset < payload_size)
+        if (shared_size > 0U)
         {
-            size_t move_size = payload_size - offset;
-            if (move_size > frame_payload_size)
-            {
-                move_size = frame_payload_size;
-            }
+            shared->ref_count++;
+            const TxSharedPayloadRef ref = {.shared = shared, .offset = writer.offset, .size = shared_size};
             // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
             // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            // SonarQube incorrectly detects a buffer overflow here.
-            (void) memcpy(&out.tail->payload_buffer[0], payload_ptr, move_size);  // NOLINT NOSONAR
-            frame_offset = frame_offset + move_size;
-            offset += move_size;
-            payload_ptr += move_size;
-        }
-
-        // Handle the last frame of the transfer: it is special because it also contains padding and CRC.
-        if (offset >= payload_size)
-        {
-            // Insert padding -- only in the last frame. Don't forget to include padding into the CRC.
-            while ((frame_offset + CRC_SIZE_BYTES) < frame_payload_size)
-            {
-                out.tail->payload_buffer[frame_offset] = PADDING_BYTE_VALUE;
-                ++frame_offset;
-                crc = crcAddByte(crc, PADDING_BYTE_VALUE);
-            }
-
-            // Insert the CRC.
-            if ((frame_offset < frame_payload_size) && (offset == payload_size))
-            {
-                // SonarQube incorrectly detects a buffer overflow here.
-                out.tail->payload_buffer[frame_offset] = (uint8_t) (crc >> BITS_PER_BYTE);  // NOSONAR
-                ++frame_offset;
-                ++offset;
-            }
-            if ((frame_offset < frame_payload_size) && (offset > payload_size))
-            {
-                out.tail->payload_buffer[frame_offset] = (uint8_t) (crc & BYTE_MAX);
-                ++frame_offset;
-                ++offset;
-            }
+            (void) memcpy(&out.tail->payload_buffer[0], &ref, sizeof(ref));  // NOLINT
+            out.tail->base.frame.payload      = NULL;
+            out.tail->base.frame.payload_size = frame_size;
         }
-
-        // Finalize the frame.
-        CANARD_ASSERT((frame_offset + 1U) == out.tail->base.frame.payload_size);
-        // SonarQube incorrectly detects a buffer overflow here.
-        out.tail->payload_buffer[frame_offset] =  // NOSONAR
-            txMakeTailByte(out.head == out.tail, offset >= payload_size_with_crc, toggle, transfer_id);
-        toggle = !toggle;
+        txFrameWriterWrite(&writer, &out.tail->payload_buffer[own_offset]);
+        frame_size = txFrameWriterGetNextSize(&writer);
     }
+    *reader = writer.reader;
     return out;
 }
 
+/// Inserts all frames of a complete chain into the queue. The capacity shall have been checked by the caller.
+/// Returns the number of frames enqueued.
+CANARD_PRIVATE int32_t txEnqueueChain(CanardTxQueue* const que, const TxChain* const chain)
+{
+    CANARD_ASSERT((que != NULL) && (chain != NULL) && (chain->head != NULL) && (chain->tail != NULL));
+    txQueueInsert(que, chain->head);  // Only the first frame requires a search; the rest follow it immediately.
+    CanardTxQueueItem* prev = &chain->head->base;
+    while (prev->next_in_transfer != NULL)
+    {
+        txQueueInsertAfter(que, prev, prev->next_in_transfer);
+        prev = prev->next_in_transfer;
+    }
+    que->size += chain->size;
+    CANARD_ASSERT(que->size <= que->capacity);
+    CANARD_ASSERT((chain->size + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
+    return (int32_t) chain->size;
+}
+
 /// Returns the number of frames enqueued or error.
 CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
                                         CanardInstance* const   ins,
@@ -487,53 +1709,34 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
                                         const uint32_t          can_id,
                                         const CanardTransferID  transfer_id,
                                         const size_t            payload_size,
-                                        const void* const       payload)
+                                        TxPayloadReader* const  reader)
 {
     CANARD_ASSERT((ins != NULL) && (que != NULL));
     CANARD_ASSERT(presentation_layer_mtu > 0U);
     CANARD_ASSERT(payload_size > presentation_layer_mtu);  // Otherwise, a single-frame transfer should be used.
 
-    int32_t      out                   = 0;  // The number of frames enqueued or negated error.
-    const size_t payload_size_with_crc = payload_size + CRC_SIZE_BYTES;
-    const size_t num_frames = ((payload_size_with_crc + presentation_layer_mtu) - 1U) / presentation_layer_mtu;
+    int32_t      out        = 0;  // The number of frames enqueued or negated error.
+    const size_t num_frames = txCountFrames(presentation_layer_mtu, payload_size);
     CANARD_ASSERT(num_frames >= 2);
-    if ((que->size + num_frames) <= que->capacity)  // Bail early if we can see that we won't fit anyway.
+    if (txHasRoomAt(que, can_id, num_frames))  // Bail early if we can see that we won't fit anyway.
     {
-        const TxChain sq = txGenerateMultiFrameChain(ins,
+        const TxChain sq = txGenerateMultiFrameChain(que,
+                                                     ins,
                                                      presentation_layer_mtu,
                                                      deadline_usec,
                                                      can_id,
                                                      transfer_id,
                                                      payload_size,
-                                                     payload);
+                                                     reader);
         if (sq.tail != NULL)
         {
-            CanardTxQueueItem* next = &sq.head->base;
-            do
-            {
-                const CanardTreeNode* const res =
-                    cavlSearch(&que->root, &next->base, &txAVLPredicate, &avlTrivialFactory);
-                (void) res;
-                CANARD_ASSERT(res == &next->base);
-                CANARD_ASSERT(que->root != NULL);
-                next = next->next_in_transfer;
-            } while (next != NULL);
             CANARD_ASSERT(num_frames == sq.size);
-            que->size += sq.size;
-            CANARD_ASSERT(que->size <= que->capacity);
-            CANARD_ASSERT((sq.size + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
-            out = (int32_t) sq.size;
+            out = txEnqueueChain(que, &sq);
         }
         else
         {
-            out                     = -CANARD_ERROR_OUT_OF_MEMORY;
-            CanardTxQueueItem* head = &sq.head->base;
-            while (head != NULL)
-            {
-                CanardTxQueueItem* const next = head->next_in_transfer;
-                ins->memory_free(ins, head);
-                head = next;
-            }
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+            txFreeChain(que, ins, &sq.head->base);
         }
     }
     else  // We predict that we're going to run out of queue, don't bother serializing the transfer.
@@ -544,14 +1747,498 @@ CANARD_PRIVATE int32_t txPushMultiFrame(CanardTxQueue* const    que,
     return out;
 }
 
-// --------------------------------------------- RECEPTION ---------------------------------------------
-
+/// Serializes one transfer of a batch and appends its frames to the batch chain. On failure, the partially generated
+/// frames (if any) are still appended to the chain so that the caller can free everything at once.
+/// The frames of different transfers are linked together via next_in_transfer of the last frame of each transfer;
+/// the links are broken by the caller before the frames are handed over to the application.
+/// Returns the number of frames appended or a negated error.
+CANARD_PRIVATE int32_t txGenerateBatchItem(CanardTxQueue* const           que,
+                                           CanardInstance* const          ins,
+                                           const size_t                   presentation_layer_mtu,
+                                           const CanardTxBatchItem* const item,
+                                           TxChain* const                 batch)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (item != NULL) && (batch != NULL));
+    const CanardPayloadFragment frag   = {.size = item->payload_size, .data = item->payload};
+    TxPayloadReader             reader = txPayloadReaderInit(1U, &frag);
+    int32_t out = txMakeCANIDV(&item->metadata, item->payload_size, 1U, &frag, ins->node_id, presentation_layer_mtu);
+    if (out >= 0)
+    {
+        TxChain sq = {NULL, NULL, 0};
+        if (item->payload_size <= presentation_layer_mtu)
+        {
+            sq.head = txGenerateSingleFrame(que,
+                                            ins,
+                                            presentation_layer_mtu,
+                                            item->tx_deadline_usec,
+                                            (uint32_t) out,
+                                            item->metadata.transfer_id,
+                                            item->payload_size,
+                                            &reader);
+            sq.tail = sq.head;
+            sq.size = 1U;
+        }
+        else
+        {
+            sq = txGenerateMultiFrameChain(que,
+                                           ins,
+                                           presentation_layer_mtu,
+                                           item->tx_deadline_usec,
+                                           (uint32_t) out,
+                                           item->metadata.transfer_id,
+                                           item->payload_size,
+                                           &reader);
+        }
+        if (sq.head != NULL)
+        {
+            if (NULL == batch->head)
+            {
+                batch->head = sq.head;
+            }
+            else
+            {
+                batch->tail->base.next_in_transfer = &sq.head->base;
+            }
+            batch->tail = sq.tail;  // NULL if OOM, which is fine because we are going to stop here.
+        }
+        if (sq.tail != NULL)
+        {
+            batch->size += sq.size;
+            CANARD_ASSERT((sq.size + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
+            out = (int32_t) sq.size;
+        }
+        else
+        {
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    return out;
+}
+
+/// Serializes a transfer into a new chain of frames for the queue without inserting it; the capacity of the queue is
+/// checked. On success, the chain is complete and the result is the number of frames in it. On failure, the frames
+/// allocated so far are freed, the chain is left empty, and the result is a negated error.
+CANARD_PRIVATE int32_t txGenerateChain(CanardTxQueue* const                que,
+                                       CanardInstance* const               ins,
+                                       const size_t                        presentation_layer_mtu,
+                                       const CanardMicrosecond             deadline_usec,
+                                       const CanardTransferMetadata* const metadata,
+                                       const size_t                        payload_size,
+                                       TxPayloadReader* const              reader,
+                                       TxChain* const                      out_chain)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (metadata != NULL) && (reader != NULL) && (out_chain != NULL));
+    TxChain       sq     = {NULL, NULL, 0};
+    int32_t       out    = -CANARD_ERROR_OUT_OF_MEMORY;
+    const int32_t can_id = txMakeCANIDV(metadata,
+                                        payload_size,
+                                        reader->fragment_count,
+                                        reader->fragments,
+                                        ins->node_id,
+                                        presentation_layer_mtu);
+    if (can_id < 0)
+    {
+        out = can_id;
+    }
+    else if (!txHasRoomAt(que, (uint32_t) can_id, txCountFrames(presentation_layer_mtu, payload_size)))
+    {
+        (void) 0;  // We predict that we're going to run out of queue, don't bother serializing the transfer.
+    }
+    else if (payload_size <= presentation_layer_mtu)
+    {
+        sq.head = txGenerateSingleFrame(que,
+                                        ins,
+                                        presentation_layer_mtu,
+                                        deadline_usec,
+                                        (uint32_t) can_id,
+                                        metadata->transfer_id,
+                                        payload_size,
+                                        reader);
+        sq.tail = sq.head;
+        sq.size = 1U;
+    }
+    else
+    {
+        sq = txGenerateMultiFrameChain(que,
+                                       ins,
+                                       presentation_layer_mtu,
+                                       deadline_usec,
+                                       (uint32_t) can_id,
+                                       metadata->transfer_id,
+                                       payload_size,
+                                       reader);
+    }
+    if (sq.tail != NULL)
+    {
+        CANARD_ASSERT((sq.size + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
+        out        = (int32_t) sq.size;
+        *out_chain = sq;
+    }
+    else
+    {
+        txFreeChain(que, ins, (sq.head != NULL) ? &sq.head->base : NULL);
+    }
+    return out;
+}
+
+/// Produces a copy of the frames of a transfer for another queue. The frames are copied verbatim, so the payload is
+/// neither serialized nor CRC-ed again, and lazily materialized frames share the payload block with the originals.
+/// The queue shall have the same presentation layer MTU and the same storage kind (pool or heap) as the queue that
+/// contains the original frames. The tail is NULL if OOM.
+CANARD_PRIVATE TxChain txCloneChain(CanardTxQueue* const           que,
+                                    CanardInstance* const          ins,
+                                    const CanardTxQueueItem* const head)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (head != NULL));
+    TxChain                  out = {NULL, NULL, 0};
+    const CanardTxQueueItem* src = head;
+    while (src != NULL)
+    {
+        out.size++;
+        TxSharedPayloadRef ref      = {NULL, 0U, 0U};
+        const bool         shared   = txGetSharedPayloadRef(src, &ref);
+        const size_t       own_size = txGetItemBufferSize(src);
+        TxItem* const      tqi =
+            txAllocateQueueItem(que, ins, (uint32_t) src->frame.extended_can_id, src->tx_deadline_usec, own_size);
+        if (NULL == out.head)
+        {
+            out.head = tqi;
+        }
+        else
+        {
+            out.tail->base.next_in_transfer = &tqi->base;
+        }
+        out.tail = tqi;
+        if (NULL == out.tail)
+        {
+            break;
+        }
+        // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+        (void) memcpy(&out.tail->payload_buffer[0],  // NOLINT
+                      &((const TxItem*) (const void*) src)->payload_buffer[0],
+                      own_size);
+        if (shared)
+        {
+            ref.shared->ref_count++;
+            out.tail->base.frame.payload      = NULL;
+            out.tail->base.frame.payload_size = src->frame.payload_size;
+        }
+        src = src->next_in_transfer;
+    }
+    return out;
+}
+
+/// The common part of the push functions. The reader shall be positioned at the beginning of the payload.
+CANARD_PRIVATE int32_t txPush(CanardTxQueue* const                que,
+                              CanardInstance* const               ins,
+                              const CanardMicrosecond             tx_deadline_usec,
+                              const CanardTransferMetadata* const metadata,
+                              const size_t                        payload_size,
+                              TxPayloadReader* const              reader)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (metadata != NULL) && (reader != NULL));
+    int32_t       out    = 0;
+    const size_t  pl_mtu = txGetPresentationLayerMTU(que);
+    const int32_t maybe_can_id =
+        txMakeCANIDV(metadata, payload_size, reader->fragment_count, reader->fragments, ins->node_id, pl_mtu);
+    if (maybe_can_id >= 0)
+    {
+        if (payload_size <= pl_mtu)
+        {
+            out = txPushSingleFrame(que,
+                                    ins,
+                                    pl_mtu,
+                                    tx_deadline_usec,
+                                    (uint32_t) maybe_can_id,
+                                    metadata->transfer_id,
+                                    payload_size,
+                                    reader);
+            CANARD_ASSERT((out < 0) || (out == 1));
+        }
+        else
+        {
+            out = txPushMultiFrame(que,
+                                   ins,
+                                   pl_mtu,
+                                   tx_deadline_usec,
+                                   (uint32_t) maybe_can_id,
+                                   metadata->transfer_id,
+                                   payload_size,
+                                   reader);
+            CANARD_ASSERT((out < 0) || (out >= 2));
+        }
+    }
+    else
+    {
+        out = maybe_can_id;
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+/// Writes the frames of the transfer into the sink for as long as it accepts them and enqueues the rest.
+/// The caller shall ensure that the queue is empty, otherwise, the transmission order would be violated.
+/// Returns the total number of frames produced or error.
+CANARD_PRIVATE int32_t txPushDirect(CanardTxQueue* const                que,
+                                    CanardInstance* const               ins,
+                                    CanardTxFrameSink* const            sink,
+                                    const CanardMicrosecond             tx_deadline_usec,
+                                    const CanardTransferMetadata* const metadata,
+                                    const size_t                        payload_size,
+                                    TxPayloadReader* const              reader)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (sink != NULL) && (metadata != NULL) && (reader != NULL));
+    CANARD_ASSERT((sink->acquire != NULL) && (sink->commit != NULL));
+    CANARD_ASSERT(0U == que->size);
+    int32_t       out    = -CANARD_ERROR_OUT_OF_MEMORY;
+    const size_t  pl_mtu = txGetPresentationLayerMTU(que);
+    const int32_t can_id =
+        txMakeCANIDV(metadata, payload_size, reader->fragment_count, reader->fragments, ins->node_id, pl_mtu);
+    if (can_id < 0)
+    {
+        out = can_id;
+    }
+    else if (!txHasRoomAt(que, (uint32_t) can_id, txCountFrames(pl_mtu, payload_size)))
+    {
+        (void) 0;  // The remainder might not fit into the queue after something is committed, so don't even start.
+    }
+    else
+    {
+        TxFrameWriter writer     = txFrameWriterInit(pl_mtu, metadata->transfer_id, payload_size, *reader);
+        size_t        frame_size = txFrameWriterGetNextSize(&writer);
+        // Write the frames into the sink until it is full.
+        void* buffer = sink->acquire(sink, frame_size);
+        while (buffer != NULL)
+        {
+            txFrameWriterWrite(&writer, (uint8_t*) buffer);
+            const CanardFrame frame = {
+                .extended_can_id = (uint32_t) can_id,
+                .payload_size    = frame_size,
+                .payload         = buffer,
+            };
+            sink->commit(sink, tx_deadline_usec, &frame);
+            frame_size = txFrameWriterGetNextSize(&writer);
+            buffer     = (frame_size > 0U) ? sink->acquire(sink, frame_size) : NULL;
+        }
+        const size_t committed = writer.frame_count;
+        // Enqueue the remainder.
+        TxChain sq = {NULL, NULL, 0};
+        while (frame_size > 0U)
+        {
+            TxItem* const tqi = txAllocateQueueItem(que, ins, (uint32_t) can_id, tx_deadline_usec, frame_size);
+            if (NULL == tqi)
+            {
+                break;
+            }
+            if (NULL == sq.head)
+            {
+                sq.head = tqi;
+            }
+            else
+            {
+                sq.tail->base.next_in_transfer = &tqi->base;
+            }
+            sq.tail = tqi;
+            sq.size++;
+            txFrameWriterWrite(&writer, &tqi->payload_buffer[0]);
+            frame_size = txFrameWriterGetNextSize(&writer);
+        }
+        if (frame_size > 0U)
+        {
+            txFreeChain(que, ins, (sq.head != NULL) ? &sq.head->base : NULL);
+        }
+        else
+        {
+            if (sq.head != NULL)
+            {
+                (void) txEnqueueChain(que, &sq);
+            }
+            CANARD_ASSERT(((committed + sq.size) + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
+            out = (int32_t) (committed + sq.size);
+        }
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+/// Restores the frame writer of a stream from its state; see txStreamSave().
+CANARD_PRIVATE TxFrameWriter txStreamLoad(CanardTxStream* const stream)
+{
+    CANARD_ASSERT((stream != NULL) && (stream->read != NULL));
+    TxPayloadReader reader = txPayloadReaderInit(0U, NULL);
+    reader.stream          = stream;
+    reader.fragment_offset = (stream->offset < stream->payload_size) ? stream->offset : stream->payload_size;
+    TxFrameWriter out =
+        txFrameWriterInit(stream->mtu_bytes, stream->metadata.transfer_id, stream->payload_size, reader);
+
+    out.offset      = stream->offset;
+    out.frame_count = stream->frame_count;
+    out.crc         = stream->crc;
+    out.toggle      = stream->toggle;
+    return out;
+}
+
+/// Stores the state of the frame writer of a stream after the specified number of frames have been written.
+CANARD_PRIVATE void txStreamSave(CanardTxStream* const stream, const TxFrameWriter* const writer, const size_t written)
+{
+    CANARD_ASSERT((stream != NULL) && (writer != NULL) && (written <= stream->remaining_frames));
+    stream->offset      = writer->offset;
+    stream->frame_count = writer->frame_count;
+    stream->remaining_frames -= written;
+    stream->crc    = writer->crc;
+    stream->toggle = writer->toggle;
+    CANARD_ASSERT((0U == stream->remaining_frames) == (0U == txFrameWriterGetNextSize(writer)));
+}
+
+/// Enqueues the next frames of the stream while the queue has room for them. Returns the number of frames enqueued
+/// or the out-of-memory error if none could be allocated.
+CANARD_PRIVATE int32_t txStreamPump(CanardTxQueue* const  que,
+                                    CanardInstance* const ins,
+                                    CanardTxStream* const stream,
+                                    const size_t          max_frames)
+{
+    CANARD_ASSERT((que != NULL) && (ins != NULL) && (stream != NULL));
+    TxFrameWriter writer     = txStreamLoad(stream);
+    size_t        frame_size = txFrameWriterGetNextSize(&writer);
+    TxChain       sq         = {NULL, NULL, 0};
+    bool          oom        = false;
+    while ((frame_size > 0U) && (sq.size < max_frames) && txHasRoomAt(que, stream->can_id, sq.size + 1U))
+    {
+        TxItem* const tqi = txAllocateQueueItem(que, ins, stream->can_id, stream->tx_deadline_usec, frame_size);
+        if (NULL == tqi)
+        {
+            oom = true;
+            break;
+        }
+        if (NULL == sq.head)
+        {
+            sq.head = tqi;
+        }
+        else
+        {
+            sq.tail->base.next_in_transfer = &tqi->base;
+        }
+        sq.tail = tqi;
+        sq.size++;
+        txFrameWriterWrite(&writer, &tqi->payload_buffer[0]);
+        frame_size = txFrameWriterGetNextSize(&writer);
+    }
+    txStreamSave(stream, &writer, sq.size);
+    int32_t out = 0;
+    if (sq.head != NULL)
+    {
+        out = txEnqueueChain(que, &sq);
+    }
+    else if (oom)
+    {
+        out = -CANARD_ERROR_OUT_OF_MEMORY;
+    }
+    else
+    {
+        (void) 0;  // The queue is full or the transfer is complete.
+    }
+    return out;
+}
+
+/// The common part of canardTxPushRedundant() and canardTxPushRedundantShared().
+CANARD_PRIVATE int32_t txPushRedundant(CanardTxQueue* const* const         ques,
+                                       const size_t                        que_count,
+                                       CanardInstance* const               ins,
+                                       const CanardMicrosecond             tx_deadline_usec,
+                                       const CanardTransferMetadata* const metadata,
+                                       const size_t                        payload_size,
+                                       const void* const                   payload,
+                                       const bool                          share,
+                                       int32_t* const                      out_results)
+{
+    int32_t out   = -CANARD_ERROR_INVALID_ARGUMENT;
+    bool    valid = (ques != NULL) && (que_count > 0U) && (ins != NULL) && (metadata != NULL) &&
+                 ((payload != NULL) || (0U == payload_size));
+    bool multi_frame = false;
+    for (size_t i = 0U; valid && (i < que_count); i++)
+    {
+        valid       = (ques[i] != NULL);
+        multi_frame = multi_frame || (valid && (payload_size > txGetPresentationLayerMTU(ques[i])));
+    }
+    if (valid)
+    {
+        out = 0;
+        // If sharing is requested and the transfer is multi-frame for any of the queues, copy the payload once into
+        // a shared block so that the frames of all queues can refer to it. If the block cannot be allocated,
+        // the frames are materialized eagerly. The fixed-size frames never refer to shared blocks.
+        void* shared = NULL;
+#if CANARD_FIXED_MTU
+        (void) multi_frame;
+        (void) share;
+#else
+        shared = (share && multi_frame) ? canardTxAllocatePayload(ins, payload_size) : NULL;
+        if (shared != NULL)
+        {
+            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+            (void) memcpy(shared, payload, payload_size);  // NOLINT
+        }
+#endif
+        const CanardPayloadFragment frag = {.size = payload_size, .data = (shared != NULL) ? shared : payload};
+        // The frames generated for one queue serve as the template for the subsequent queues of the same kind.
+        const CanardTxQueue*     template_que  = NULL;
+        const CanardTxQueueItem* template_head = NULL;
+        for (size_t i = 0U; i < que_count; i++)
+        {
+            CanardTxQueue* const que    = ques[i];
+            const size_t         pl_mtu = txGetPresentationLayerMTU(que);
+            TxChain              sq     = {NULL, NULL, 0};
+            int32_t              res    = -CANARD_ERROR_OUT_OF_MEMORY;
+            if ((template_head != NULL) && (pl_mtu == txGetPresentationLayerMTU(template_que)) &&
+                ((0U == que->pool.block_size) == (0U == template_que->pool.block_size)))
+            {
+                if (txHasRoomAt(que,
+                                ((uint32_t) metadata->priority) << OFFSET_PRIORITY,
+                                txCountFrames(pl_mtu, payload_size)))
+                {
+                    sq = txCloneChain(que, ins, template_head);
+                    if (NULL == sq.tail)
+                    {
+                        txFreeChain(que, ins, &sq.head->base);
+                    }
+                }
+            }
+            else
+            {
+                TxPayloadReader reader = txPayloadReaderInit(1U, &frag);
+                reader.shared          = (shared != NULL) ? txSharedPayloadFromData(shared) : NULL;
+                res = txGenerateChain(que, ins, pl_mtu, tx_deadline_usec, metadata, payload_size, &reader, &sq);
+                if (res > 0)
+                {
+                    template_que  = que;
+                    template_head = &sq.head->base;
+                }
+            }
+            if (sq.tail != NULL)
+            {
+                res = txEnqueueChain(que, &sq);
+                out++;
+            }
+            txRecordPush(que, ins, 1U, res, metadata);
+            if (out_results != NULL)
+            {
+                out_results[i] = res;
+            }
+        }
+        canardTxReleasePayload(ins, shared);  // The frames hold their own references now.
+    }
+    return out;
+}
+
+// --------------------------------------------- RECEPTION ---------------------------------------------
+
 #define RX_SESSIONS_PER_SUBSCRIPTION (CANARD_NODE_ID_MAX + 1U)
 
 /// The memory requirement model provided in the documentation assumes that the maximum size of this structure never
-/// exceeds 48 bytes on any conventional platform.
-/// A user that needs a detailed analysis of the worst-case memory consumption may compute the size of this structure
-/// for the particular platform at hand manually or by evaluating its sizeof().
+/// exceeds CANARD_RX_SESSION_SIZE_MAX bytes on any conventional platform.
+/// A user that needs a detailed analysis of the worst-case memory consumption may obtain the size of this structure
+/// for the particular platform at hand from canardRxSubscriptionWorstCaseBytes().
 /// The fields are ordered to minimize the amount of padding on all conventional platforms.
 typedef struct CanardInternalRxSession
 {
@@ -563,8 +2250,24 @@ typedef struct CanardInternalRxSession
     CanardTransferID  transfer_id;
     uint8_t           redundant_transport_index;  ///< Arbitrary value in [0, 255].
     bool              toggle;
+    CanardNodeID      source_node_id;
+    uint8_t           stream_carry[CRC_SIZE_BYTES];  ///< The streaming mode holds back the bytes that may be the CRC.
+
+    /// The sessions of the instance are linked in the order of their transfer timestamps; see canardRxCleanup().
+    struct CanardInternalRxSession* older;
+    struct CanardInternalRxSession* newer;
+    CanardRxSubscription*           subscription;  ///< The owner of this session.
 } CanardInternalRxSession;
 
+/// A session stored in the session pool; see CanardRxSessionPool.
+typedef struct CanardInternalRxPoolSession
+{
+    CanardInternalRxSession             base;      ///< Shall be the first member.
+    struct CanardInternalRxPoolSession* lru_prev;  ///< Towards the most recently used session.
+    struct CanardInternalRxPoolSession* lru_next;  ///< Towards the least recently used session.
+    uint32_t                            key;       ///< See rxPoolMakeKey().
+} RxPoolSession;
+
 /// High-level transport frame model.
 typedef struct
 {
@@ -591,7 +2294,7 @@ CANARD_PRIVATE bool rxTryParseFrame(const CanardMicrosecond  timestamp_usec,
     CANARD_ASSERT(frame->extended_can_id <= CAN_EXT_ID_MASK);
     CANARD_ASSERT(out != NULL);
     bool valid = false;
-    if (frame->payload_size > 0)
+    if ((frame->payload_size > 0) && ((CANARD_FIXED_MTU == 0U) || (frame->payload_size <= RX_FRAME_PAYLOAD_MAX)))
     {
         CANARD_ASSERT(frame->payload != NULL);
         out->timestamp_usec = timestamp_usec;
@@ -646,322 +2349,1284 @@ CANARD_PRIVATE bool rxTryParseFrame(const CanardMicrosecond  timestamp_usec,
         // A frame that is a part of a multi-frame transfer cannot be empty (tail byte not included).
         valid = valid && ((out->payload_size > 0) || (out->start_of_transfer && out->end_of_transfer));
     }
-    return valid;
+    return valid;
+}
+
+CANARD_PRIVATE void rxInitTransferMetadataFromFrame(const RxFrameModel* const     frame,
+                                                    CanardTransferMetadata* const out_transfer)
+{
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->payload != NULL);
+    CANARD_ASSERT(out_transfer != NULL);
+    out_transfer->priority       = frame->priority;
+    out_transfer->transfer_kind  = frame->transfer_kind;
+    out_transfer->port_id        = frame->port_id;
+    out_transfer->remote_node_id = frame->source_node_id;
+    out_transfer->transfer_id    = frame->transfer_id;
+}
+
+#if CANARD_STATS
+/// Returns the counter of the specified RX event in the statistics block.
+CANARD_PRIVATE uint32_t* rxGetStatsCounter(CanardRxStats* const stats, const CanardTraceEvent event)
+{
+    CANARD_ASSERT(stats != NULL);
+    uint32_t* out = NULL;
+    switch (event)
+    {
+    case CanardTraceEventRxDuplicate:
+        out = &stats->duplicates;
+        break;
+    case CanardTraceEventRxToggleError:
+        out = &stats->toggle_errors;
+        break;
+    case CanardTraceEventRxSOTMiss:
+        out = &stats->sot_misses;
+        break;
+    case CanardTraceEventRxCRCError:
+        out = &stats->crc_errors;
+        break;
+    case CanardTraceEventRxTruncation:
+        out = &stats->truncations;
+        break;
+    case CanardTraceEventRxOutOfMemory:
+        out = &stats->oom_errors;
+        break;
+    case CanardTraceEventRxMalformed:
+    case CanardTraceEventTxOutOfMemory:
+    case CanardTraceEventTxExpired:
+    default:
+        CANARD_ASSERT(false);  // These events are not counted in CanardRxStats.
+        break;
+    }
+    return out;
+}
+#endif
+
+/// Updates the RX statistics of the instance and of the subscription (if not NULL) and reports the event via the
+/// trace hook. The frame provides the metadata for the trace hook. No effect if CANARD_STATS is off.
+CANARD_PRIVATE void rxRecordEvent(CanardInstance* const       ins,
+                                  CanardRxSubscription* const subscription,
+                                  const CanardTraceEvent      event,
+                                  const RxFrameModel* const   frame)
+{
+    CANARD_ASSERT((ins != NULL) && (frame != NULL));
+#if CANARD_STATS
+    (*rxGetStatsCounter(&ins->rx_stats, event))++;
+    if (subscription != NULL)
+    {
+        (*rxGetStatsCounter(&subscription->stats, event))++;
+    }
+    if (ins->trace_hook != NULL)
+    {
+        CanardTransferMetadata metadata = {CanardPriorityExceptional, CanardTransferKindMessage, 0U, 0U, 0U};
+        rxInitTransferMetadataFromFrame(frame, &metadata);
+        ins->trace_hook(ins, event, &metadata);
+    }
+#else
+    (void) ins;
+    (void) subscription;
+    (void) event;
+    (void) frame;
+#endif
+}
+
+/// Counts a frame used for reassembly and, if the transfer is complete, the transfer. The subscription may be NULL.
+/// No effect if CANARD_STATS is off.
+CANARD_PRIVATE void rxRecordAccepted(CanardInstance* const       ins,
+                                     CanardRxSubscription* const subscription,
+                                     const bool                  transfer_completed)
+{
+    CANARD_ASSERT(ins != NULL);
+#if CANARD_STATS
+    const uint32_t transfers = transfer_completed ? 1U : 0U;
+    ins->rx_stats.frames_accepted++;
+    ins->rx_stats.transfers += transfers;
+    if (subscription != NULL)
+    {
+        subscription->stats.frames_accepted++;
+        subscription->stats.transfers += transfers;
+    }
+#else
+    (void) ins;
+    (void) subscription;
+    (void) transfer_completed;
+#endif
+}
+
+/// The implementation is borrowed from the Specification.
+CANARD_PRIVATE uint8_t rxComputeTransferIDDifference(const uint8_t a, const uint8_t b)
+{
+    CANARD_ASSERT(a <= CANARD_TRANSFER_ID_MAX);
+    CANARD_ASSERT(b <= CANARD_TRANSFER_ID_MAX);
+    int16_t diff = (int16_t) (((int16_t) a) - ((int16_t) b));
+    if (diff < 0)
+    {
+        const uint8_t modulo = 1U << CANARD_TRANSFER_ID_BIT_LENGTH;
+        diff                 = (int16_t) (diff + (int16_t) modulo);
+    }
+    return (uint8_t) diff;
+}
+
+/// Payload buffers are taken from the payload pool of the subscription if it has one, otherwise from the heap.
+/// The subscription may be NULL, in which case the heap is used.
+CANARD_PRIVATE void* rxPayloadAllocate(CanardInstance* const       ins,
+                                       CanardRxSubscription* const subscription,
+                                       const size_t                size)
+{
+    CANARD_ASSERT(ins != NULL);
+    void* out = NULL;
+    if ((subscription != NULL) && (subscription->payload_pool.block_size > 0U))
+    {
+        CANARD_ASSERT(size <= subscription->payload_pool.block_size);
+        out = poolAllocate(&subscription->payload_pool);
+    }
+    else
+    {
+        out = insAllocate(ins, size);
+    }
+    return out;
+}
+
+/// The counterpart of rxPayloadAllocate(). The payload may be NULL, in which case the function has no effect.
+CANARD_PRIVATE void rxPayloadFree(CanardInstance* const       ins,
+                                  CanardRxSubscription* const subscription,
+                                  void* const                 payload)
+{
+    CANARD_ASSERT(ins != NULL);
+    if ((subscription != NULL) && (subscription->payload_pool.block_size > 0U))
+    {
+        poolFree(&subscription->payload_pool, payload);
+    }
+    else
+    {
+        ins->memory_free(ins, payload);
+    }
+}
+
+CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
+                                            CanardInternalRxSession* const rxs,
+                                            const size_t                   extent,
+                                            const size_t                   payload_size,
+                                            const void* const              payload)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
+    CANARD_ASSERT(rxs->payload_size <= extent);  // This invariant is enforced by the subscription logic.
+    CANARD_ASSERT(rxs->payload_size <= rxs->total_payload_size);
+
+    rxs->total_payload_size += payload_size;
+
+    // Allocate the payload lazily, as late as possible.
+    if ((NULL == rxs->payload) && (extent > 0U))
+    {
+        CANARD_ASSERT(rxs->payload_size == 0);
+        rxs->payload = rxPayloadAllocate(ins, rxs->subscription, extent);
+    }
+
+    int8_t out = 0;
+    if (rxs->payload != NULL)
+    {
+        // Copy the payload into the contiguous buffer. Apply the implicit truncation rule if necessary.
+        size_t bytes_to_copy = payload_size;
+        if ((rxs->payload_size + bytes_to_copy) > extent)
+        {
+            CANARD_ASSERT(rxs->payload_size <= extent);
+            bytes_to_copy = extent - rxs->payload_size;
+            CANARD_ASSERT((rxs->payload_size + bytes_to_copy) == extent);
+            CANARD_ASSERT(bytes_to_copy < payload_size);
+        }
+        // This memcpy() call here is one of the two variable-complexity operations in the RX pipeline;
+        // the other one is the search of the matching subscription state.
+        // Excepting these two cases, the entire RX pipeline contains neither loops nor recursion.
+        // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+        // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+        (void) memcpy(&rxs->payload[rxs->payload_size], payload, bytes_to_copy);  // NOLINT NOSONAR
+        rxs->payload_size += bytes_to_copy;
+        CANARD_ASSERT(rxs->payload_size <= extent);
+    }
+    else
+    {
+        CANARD_ASSERT(rxs->payload_size == 0);
+        out = (extent > 0U) ? -CANARD_ERROR_OUT_OF_MEMORY : 0;
+    }
+    CANARD_ASSERT(out <= 0);
+    return out;
+}
+
+CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(rxs != NULL);
+    rxPayloadFree(ins, rxs->subscription, rxs->payload);  // May be NULL, which is OK.
+    rxs->total_payload_size = 0U;
+    rxs->payload_size       = 0U;
+    rxs->payload            = NULL;
+    rxs->calculated_crc     = CRC_INITIAL;
+    rxs->transfer_id        = (CanardTransferID) ((rxs->transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+    // The transport index is retained.
+    rxs->toggle = INITIAL_TOGGLE_STATE;
+}
+
+/// Delivers the data of the frame of a multi-frame transfer to the stream handler of the subscription; see
+/// CanardRxStreamHandler. The CRC shall be already updated. The last CRC_SIZE_BYTES received bytes are held back
+/// because they may turn out to be the transfer CRC, which is not exposed to the application.
+/// In the streaming mode, the session counts the delivered bytes in payload_size and the received ones in
+/// total_payload_size; the payload buffer is never allocated.
+CANARD_PRIVATE void rxSessionStreamFrame(CanardInstance* const          ins,
+                                         CanardInternalRxSession* const rxs,
+                                         const RxFrameModel* const      frame,
+                                         const size_t                   extent)
+{
+    CANARD_ASSERT((ins != NULL) && (rxs != NULL) && (frame != NULL) && (rxs->subscription != NULL));
+    CANARD_ASSERT(frame->payload_size <= RX_FRAME_PAYLOAD_MAX);
+    CANARD_ASSERT(rxs->subscription->stream_handler != NULL);
+    // The data of this frame is the carry followed by the frame payload; the last bytes become the new carry.
+    uint8_t      buf[CRC_SIZE_BYTES + RX_FRAME_PAYLOAD_MAX];
+    const size_t carry = (rxs->total_payload_size < CRC_SIZE_BYTES) ? rxs->total_payload_size : CRC_SIZE_BYTES;
+    // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+    // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+    (void) memcpy(&buf[0], &rxs->stream_carry[0], carry);                        // NOLINT
+    (void) memcpy(&buf[carry], frame->payload, frame->payload_size);             // NOLINT
+    const size_t available = carry + frame->payload_size;
+    const size_t data_size = (available > CRC_SIZE_BYTES) ? (available - CRC_SIZE_BYTES) : 0U;
+    rxs->total_payload_size += frame->payload_size;
+    if (!frame->end_of_transfer)
+    {
+        CANARD_ASSERT(available >= CRC_SIZE_BYTES);  // Non-last frames are never this short; see rxTryParseFrame().
+        (void) memcpy(&rxs->stream_carry[0], &buf[data_size], CRC_SIZE_BYTES);  // NOLINT
+    }
+    // Apply the implicit truncation rule: the data beyond the extent is not delivered.
+    CANARD_ASSERT(rxs->payload_size <= extent);
+    const size_t  room  = extent - rxs->payload_size;
+    CanardRxChunk chunk = {
+        .timestamp_usec  = rxs->transfer_timestamp_usec,
+        .offset          = rxs->payload_size,
+        .size            = (data_size < room) ? data_size : room,
+        .data            = &buf[0],
+        .crc             = rxs->calculated_crc,
+        .end_of_transfer = frame->end_of_transfer,
+        .valid           = frame->end_of_transfer && (rxs->total_payload_size >= CRC_SIZE_BYTES) &&
+                 (CRC_RESIDUE == rxs->calculated_crc),
+    };
+    rxInitTransferMetadataFromFrame(frame, &chunk.metadata);
+    rxs->payload_size += chunk.size;
+    rxs->subscription->stream_handler(ins, rxs->subscription, &chunk);
+    if (frame->end_of_transfer && (!chunk.valid))
+    {
+        rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxCRCError, frame);
+    }
+    else if (frame->end_of_transfer && ((rxs->total_payload_size - rxs->payload_size) > CRC_SIZE_BYTES))
+    {
+        rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxTruncation, frame);
+    }
+    else
+    {
+        (void) 0;  // The transfer is still in progress or it has been delivered completely.
+    }
+    rxRecordAccepted(ins, rxs->subscription, chunk.valid);
+}
+
+/// Delivers a single-frame transfer to the stream handler of the subscription as one chunk.
+CANARD_PRIVATE void rxStreamSingleFrame(CanardInstance* const       ins,
+                                        CanardRxSubscription* const subscription,
+                                        const RxFrameModel* const   frame,
+                                        const CanardMicrosecond     timestamp_usec)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL) && (frame != NULL));
+    CANARD_ASSERT(frame->start_of_transfer && frame->end_of_transfer && (subscription->stream_handler != NULL));
+    CanardRxChunk chunk = {
+        .timestamp_usec  = timestamp_usec,
+        .offset          = 0U,
+        .size            = (subscription->extent < frame->payload_size) ? subscription->extent : frame->payload_size,
+        .data            = frame->payload,
+        .crc             = CRC_INITIAL,  // Single-frame transfers have no CRC.
+        .end_of_transfer = true,
+        .valid           = true,
+    };
+    rxInitTransferMetadataFromFrame(frame, &chunk.metadata);
+    subscription->stream_handler(ins, subscription, &chunk);
+    rxRecordAccepted(ins, subscription, true);
+    if (frame->payload_size > subscription->extent)
+    {
+        rxRecordEvent(ins, subscription, CanardTraceEventRxTruncation, frame);
+    }
+}
+
+CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
+                                           CanardInternalRxSession* const rxs,
+                                           const RxFrameModel* const      frame,
+                                           const size_t                   extent,
+                                           CanardRxTransfer* const        out_transfer)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->payload != NULL);
+    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
+    CANARD_ASSERT(out_transfer != NULL);
+
+    if (frame->start_of_transfer)  // The transfer timestamp is the timestamp of its first frame.
+    {
+        rxs->transfer_timestamp_usec = frame->timestamp_usec;
+    }
+
+    const bool single_frame = frame->start_of_transfer && frame->end_of_transfer;
+    if (!single_frame)
+    {
+        // Update the CRC. Observe that the implicit truncation rule may apply here: the payload may be
+        // truncated, but its CRC is validated always anyway.
+        rxs->calculated_crc = crcAdd(rxs->calculated_crc, frame->payload_size, frame->payload);
+    }
+
+    const bool streaming = (rxs->subscription != NULL) && (rxs->subscription->stream_handler != NULL);
+    int8_t     out       = streaming ? 0 : rxSessionWritePayload(ins, rxs, extent, frame->payload_size, frame->payload);
+    if (streaming)
+    {
+        if (single_frame)
+        {
+            rxStreamSingleFrame(ins, rxs->subscription, frame, rxs->transfer_timestamp_usec);
+        }
+        else
+        {
+            rxSessionStreamFrame(ins, rxs, frame, extent);
+        }
+        if (frame->end_of_transfer)
+        {
+            rxSessionRestart(ins, rxs);
+        }
+        else
+        {
+            rxs->toggle = !rxs->toggle;
+        }
+    }
+    else if (out < 0)
+    {
+        CANARD_ASSERT(-CANARD_ERROR_OUT_OF_MEMORY == out);
+        rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxOutOfMemory, frame);
+        rxSessionRestart(ins, rxs);  // Out-of-memory.
+    }
+    else if (frame->end_of_transfer)
+    {
+        CANARD_ASSERT(0 == out);
+        if (single_frame || (CRC_RESIDUE == rxs->calculated_crc))
+        {
+            out = 1;  // One transfer received, notify the application.
+            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
+            out_transfer->timestamp_usec   = rxs->transfer_timestamp_usec;
+            out_transfer->payload_size     = rxs->payload_size;
+            out_transfer->payload          = rxs->payload;
+            out_transfer->payload_borrowed = false;
+
+            // Cut off the CRC from the payload if it's there -- we don't want to expose it to the user.
+            CANARD_ASSERT(rxs->total_payload_size >= rxs->payload_size);
+            const size_t truncated_amount = rxs->total_payload_size - rxs->payload_size;
+            if ((!single_frame) && (CRC_SIZE_BYTES > truncated_amount))  // Single-frame transfers don't have CRC.
+            {
+                CANARD_ASSERT(out_transfer->payload_size >= (CRC_SIZE_BYTES - truncated_amount));
+                out_transfer->payload_size -= CRC_SIZE_BYTES - truncated_amount;
+            }
+
+            rxs->payload = NULL;  // Ownership passed over to the application, nullify to prevent freeing.
+            rxRecordAccepted(ins, rxs->subscription, true);
+            // Borrowed single-frame transfers are reassembled with zero extent; see rxBorrowFramePayload().
+            const bool borrowed = single_frame && (rxs->subscription != NULL) && rxs->subscription->borrow_single_frame;
+            if ((!borrowed) && (truncated_amount > (single_frame ? 0U : CRC_SIZE_BYTES)))
+            {
+                rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxTruncation, frame);
+            }
+        }
+        else
+        {
+            rxRecordAccepted(ins, rxs->subscription, false);
+            rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxCRCError, frame);
+        }
+        rxSessionRestart(ins, rxs);  // Successful completion.
+    }
+    else
+    {
+        rxRecordAccepted(ins, rxs->subscription, false);
+        rxs->toggle = !rxs->toggle;
+    }
+    return out;
+}
+
+/// True if the transfer-ID timeout of the session has expired by the specified time.
+CANARD_PRIVATE bool rxSessionTimedOut(const CanardInternalRxSession* const rxs,
+                                      const CanardMicrosecond              now_usec,
+                                      const CanardMicrosecond              transfer_id_timeout_usec)
+{
+    return (now_usec > rxs->transfer_timestamp_usec) &&
+           ((now_usec - rxs->transfer_timestamp_usec) > transfer_id_timeout_usec);
+}
+
+/// Prepares the session for the reception of a new transfer starting with the specified frame on the specified
+/// redundant transport. The payload buffer, if any, is retained for reuse.
+CANARD_PRIVATE void rxSessionReset(CanardInternalRxSession* const rxs,
+                                   const RxFrameModel* const      frame,
+                                   const uint8_t                  redundant_transport_index)
+{
+    CANARD_ASSERT((rxs != NULL) && (frame != NULL));
+    rxs->total_payload_size        = 0U;
+    rxs->payload_size              = 0U;
+    rxs->calculated_crc            = CRC_INITIAL;
+    rxs->transfer_id               = frame->transfer_id;
+    rxs->toggle                    = INITIAL_TOGGLE_STATE;
+    rxs->redundant_transport_index = redundant_transport_index;
+}
+
+/// RX session state machine update is the most intricate part of any UAVCAN transport implementation.
+/// The state model used here is derived from the reference pseudocode given in the original UAVCAN v0 specification.
+/// The UAVCAN/CAN v1 specification, which this library is an implementation of, does not provide any reference
+/// pseudocode. Instead, it takes a higher-level, more abstract approach, where only the high-level requirements
+/// are given and the particular algorithms are left to be implementation-defined. Such abstract approach is much
+/// advantageous because it allows implementers to choose whatever solution works best for the specific application at
+/// hand, while the wire compatibility is still guaranteed by the high-level requirements given in the specification.
+CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
+                                      CanardInternalRxSession* const rxs,
+                                      const RxFrameModel* const      frame,
+                                      const uint8_t                  redundant_transport_index,
+                                      const CanardMicrosecond        transfer_id_timeout_usec,
+                                      const size_t                   extent,
+                                      CanardRxTransfer* const        out_transfer)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(rxs != NULL);
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(out_transfer != NULL);
+    CANARD_ASSERT(rxs->transfer_id <= CANARD_TRANSFER_ID_MAX);
+    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
+
+    const bool tid_timed_out = rxSessionTimedOut(rxs, frame->timestamp_usec, transfer_id_timeout_usec);
+
+    const bool not_previous_tid = rxComputeTransferIDDifference(rxs->transfer_id, frame->transfer_id) > 1;
+
+    const bool need_restart = tid_timed_out || ((rxs->redundant_transport_index == redundant_transport_index) &&
+                                                frame->start_of_transfer && not_previous_tid);
+
+    if (need_restart)
+    {
+        rxSessionReset(rxs, frame, redundant_transport_index);
+    }
+
+    int8_t out = 0;
+    if (need_restart && (!frame->start_of_transfer))
+    {
+        rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxSOTMiss, frame);
+        rxSessionRestart(ins, rxs);  // SOT-miss, no point going further.
+    }
+    else
+    {
+        const bool correct_transport = (rxs->redundant_transport_index == redundant_transport_index);
+        const bool correct_toggle    = (frame->toggle == rxs->toggle);
+        const bool correct_tid       = (frame->transfer_id == rxs->transfer_id);
+        if (correct_transport && correct_toggle && correct_tid)
+        {
+            out = rxSessionAcceptFrame(ins, rxs, frame, extent, out_transfer);
+        }
+        else if (correct_transport && correct_tid)
+        {
+            rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxToggleError, frame);
+        }
+        else if (correct_transport && not_previous_tid)  // Not a frame of the current or the previous transfer.
+        {
+            rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxSOTMiss, frame);
+        }
+        else
+        {
+            rxRecordEvent(ins, rxs->subscription, CanardTraceEventRxDuplicate, frame);
+        }
+    }
+    return out;
+}
+
+/// Adds the session to the list of sessions of the instance as the one with the newest transfer timestamp.
+CANARD_PRIVATE void rxSessionLink(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+{
+    rxs->older = ins->rx_sessions_newest;
+    rxs->newer = NULL;
+    if (ins->rx_sessions_newest != NULL)
+    {
+        ins->rx_sessions_newest->newer = rxs;
+    }
+    else
+    {
+        ins->rx_sessions_oldest = rxs;
+    }
+    ins->rx_sessions_newest = rxs;
+}
+
+CANARD_PRIVATE void rxSessionUnlink(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+{
+    if (rxs->older != NULL)
+    {
+        rxs->older->newer = rxs->newer;
+    }
+    else
+    {
+        ins->rx_sessions_oldest = rxs->newer;
+    }
+    if (rxs->newer != NULL)
+    {
+        rxs->newer->older = rxs->older;
+    }
+    else
+    {
+        ins->rx_sessions_newest = rxs->older;
+    }
+    rxs->older = NULL;
+    rxs->newer = NULL;
+}
+
+/// The key uniquely identifies the session by the transfer kind, the port-ID, and the source node-ID.
+CANARD_PRIVATE uint32_t rxPoolMakeKey(const CanardTransferKind transfer_kind,
+                                      const CanardPortID       port_id,
+                                      const CanardNodeID       source_node_id)
+{
+    CANARD_ASSERT(source_node_id <= CANARD_NODE_ID_MAX);
+    return (((((uint32_t) transfer_kind) << 16U) | port_id) << 7U) | source_node_id;
+}
+
+CANARD_PRIVATE size_t rxPoolHash(const CanardRxSessionPool* const pool, const uint32_t key)
+{
+    // Fibonacci hashing; the high half of the product is folded into the low bits that are used for indexing.
+    const uint32_t h = (uint32_t) (key * UINT32_C(2654435761));
+    return ((size_t) (h ^ (h >> 16U))) & (pool->index_size - 1U);
+}
+
+/// Returns the index slot that contains the session with the specified key, or the empty slot where it would be
+/// inserted. Terminates because the load factor of the index is always less than one.
+CANARD_PRIVATE size_t rxPoolProbe(const CanardRxSessionPool* const pool, const uint32_t key)
+{
+    size_t slot = rxPoolHash(pool, key);
+    while ((pool->index[slot] != NULL) && (pool->index[slot]->key != key))
+    {
+        slot = (slot + 1U) & (pool->index_size - 1U);
+    }
+    return slot;
+}
+
+CANARD_PRIVATE void rxPoolUnlink(CanardRxSessionPool* const pool, RxPoolSession* const rps)
+{
+    if (rps->lru_prev != NULL)
+    {
+        rps->lru_prev->lru_next = rps->lru_next;
+    }
+    else
+    {
+        pool->lru_head = rps->lru_next;
+    }
+    if (rps->lru_next != NULL)
+    {
+        rps->lru_next->lru_prev = rps->lru_prev;
+    }
+    else
+    {
+        pool->lru_tail = rps->lru_prev;
+    }
+    rps->lru_prev = NULL;
+    rps->lru_next = NULL;
+}
+
+CANARD_PRIVATE void rxPoolLinkFront(CanardRxSessionPool* const pool, RxPoolSession* const rps)
+{
+    rps->lru_prev = NULL;
+    rps->lru_next = pool->lru_head;
+    if (pool->lru_head != NULL)
+    {
+        pool->lru_head->lru_prev = rps;
+    }
+    else
+    {
+        pool->lru_tail = rps;
+    }
+    pool->lru_head = rps;
+}
+
+/// Deallocates the session located at the specified slot of the index together with its payload buffer.
+CANARD_PRIVATE void rxPoolDestroy(CanardInstance* const ins, CanardRxSessionPool* const pool, const size_t slot)
+{
+    RxPoolSession* const rps = pool->index[slot];
+    CANARD_ASSERT(rps != NULL);
+    rxPayloadFree(ins, rps->base.subscription, rps->base.payload);
+    rxSessionUnlink(ins, &rps->base);
+    rxPoolUnlink(pool, rps);
+    // Backward-shift deletion keeps the probe sequences intact without tombstones: the subsequent entries of the
+    // cluster are moved into the hole unless their home slot is located cyclically between the hole and the entry.
+    const size_t mask = pool->index_size - 1U;
+    size_t       hole = slot;
+    size_t       next = (slot + 1U) & mask;
+    while (pool->index[next] != NULL)
+    {
+        const size_t home = rxPoolHash(pool, pool->index[next]->key);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            pool->index[hole] = pool->index[next];
+            hole              = next;
+        }
+        next = (next + 1U) & mask;
+    }
+    pool->index[hole] = NULL;
+    poolFree(&pool->blocks, rps);
+}
+
+/// Returns the session of the subscription for the specified source node, or NULL if there is none.
+/// Pooled sessions are marked as the most recently used.
+CANARD_PRIVATE CanardInternalRxSession* rxSessionFind(CanardInstance* const       ins,
+                                                      CanardRxSubscription* const subscription,
+                                                      const CanardTransferKind    transfer_kind,
+                                                      const CanardNodeID          source_node_id)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL) && (source_node_id <= CANARD_NODE_ID_MAX));
+    CanardInternalRxSession*   out  = NULL;
+    CanardRxSessionPool* const pool = ins->rx_session_pool;
+    if (pool != NULL)
+    {
+        RxPoolSession* const rps =
+            pool->index[rxPoolProbe(pool, rxPoolMakeKey(transfer_kind, subscription->port_id, source_node_id))];
+        if (rps != NULL)
+        {
+            rxPoolUnlink(pool, rps);
+            rxPoolLinkFront(pool, rps);
+            out = &rps->base;
+        }
+    }
+    else
+    {
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
+        out = subscription->sessions[source_node_id];
+#endif
+    }
+    return out;
+}
+
+/// Allocates a new uninitialized session for the specified source node; the session shall not exist yet.
+/// If the session pool is exhausted, the least recently used session is evicted. Returns NULL if OOM.
+CANARD_PRIVATE CanardInternalRxSession* rxSessionCreate(CanardInstance* const       ins,
+                                                        CanardRxSubscription* const subscription,
+                                                        const CanardTransferKind    transfer_kind,
+                                                        const CanardNodeID          source_node_id)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL) && (source_node_id <= CANARD_NODE_ID_MAX));
+    CanardInternalRxSession*   out  = NULL;
+    CanardRxSessionPool* const pool = ins->rx_session_pool;
+    if (pool != NULL)
+    {
+        RxPoolSession* rps = (RxPoolSession*) poolAllocate(&pool->blocks);
+        if ((NULL == rps) && (pool->lru_tail != NULL))
+        {
+            rxPoolDestroy(ins, pool, rxPoolProbe(pool, pool->lru_tail->key));
+            pool->evictions++;
+            rps = (RxPoolSession*) poolAllocate(&pool->blocks);
+        }
+        if (rps != NULL)
+        {
+            rps->key          = rxPoolMakeKey(transfer_kind, subscription->port_id, source_node_id);
+            const size_t slot = rxPoolProbe(pool, rps->key);
+            CANARD_ASSERT(NULL == pool->index[slot]);
+            pool->index[slot] = rps;
+            rxPoolLinkFront(pool, rps);
+            out = &rps->base;
+        }
+    }
+    else
+    {
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
+        out = (CanardInternalRxSession*) insAllocate(ins, sizeof(CanardInternalRxSession));
+        subscription->sessions[source_node_id] = out;
+#endif
+    }
+    if (out != NULL)
+    {
+        out->source_node_id = source_node_id;
+        out->subscription   = subscription;
+        rxSessionLink(ins, out);
+    }
+    return out;
+}
+
+/// Deallocates the specified session together with its payload buffer.
+CANARD_PRIVATE void rxSessionReclaim(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+{
+    CANARD_ASSERT((ins != NULL) && (rxs != NULL) && (rxs->subscription != NULL));
+    CanardRxSessionPool* const pool = ins->rx_session_pool;
+    if (pool != NULL)
+    {
+        // The base session is the first member of the pooled session.
+        rxPoolDestroy(ins, pool, rxPoolProbe(pool, ((RxPoolSession*) rxs)->key));
+    }
+    else
+    {
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
+        CANARD_ASSERT(rxs->subscription->sessions[rxs->source_node_id] == rxs);
+        rxs->subscription->sessions[rxs->source_node_id] = NULL;
+        rxSessionUnlink(ins, rxs);
+        rxPayloadFree(ins, rxs->subscription, rxs->payload);
+        ins->memory_free(ins, rxs);
+#endif
+    }
+}
+
+/// Deallocates the session for the specified source node together with its payload buffer, if the session exists.
+CANARD_PRIVATE void rxSessionDestroy(CanardInstance* const       ins,
+                                     CanardRxSubscription* const subscription,
+                                     const CanardTransferKind    transfer_kind,
+                                     const CanardNodeID          source_node_id)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL) && (source_node_id <= CANARD_NODE_ID_MAX));
+    CanardRxSessionPool* const pool = ins->rx_session_pool;
+    if (pool != NULL)
+    {
+        const size_t slot = rxPoolProbe(pool, rxPoolMakeKey(transfer_kind, subscription->port_id, source_node_id));
+        if (pool->index[slot] != NULL)
+        {
+            rxPoolDestroy(ins, pool, slot);
+        }
+    }
+    else
+    {
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
+        if (subscription->sessions[source_node_id] != NULL)
+        {
+            rxSessionReclaim(ins, subscription->sessions[source_node_id]);
+        }
+#endif
+    }
+}
+
+/// True if no frames have been received from the specified redundant transport for longer than the failover timeout.
+CANARD_PRIVATE bool rxTransportIsQuiet(const CanardInstance* const ins,
+                                       const uint8_t               redundant_transport_index,
+                                       const CanardMicrosecond     now_usec)
+{
+    bool out = false;
+    if ((ins->rx_failover_timeout_usec > 0U) && (redundant_transport_index < CANARD_RX_REDUNDANT_TRANSPORTS_MAX))
+    {
+        const CanardMicrosecond last_usec = ins->rx_last_frame_usec[redundant_transport_index];
+        out = (now_usec > last_usec) && ((now_usec - last_usec) > ins->rx_failover_timeout_usec);
+    }
+    return out;
+}
+
+/// Makes the received single-frame transfer reference the payload of its frame instead of an allocated buffer.
+/// The payload buffer, if any, is freed; it may be left over from an incomplete transfer superseded by this one.
+CANARD_PRIVATE void rxBorrowFramePayload(CanardInstance* const       ins,
+                                         CanardRxSubscription* const subscription,
+                                         const RxFrameModel* const   frame,
+                                         CanardRxTransfer* const     out_transfer)
+{
+    CANARD_ASSERT(frame->start_of_transfer && frame->end_of_transfer);
+    rxPayloadFree(ins, subscription, out_transfer->payload);
+    out_transfer->payload_size =
+        (subscription->extent < frame->payload_size) ? subscription->extent : frame->payload_size;
+    out_transfer->payload          = (void*) frame->payload;  // NOSONAR casting away const qualifier.
+    out_transfer->payload_borrowed = true;
+    if (frame->payload_size > subscription->extent)
+    {
+        rxRecordEvent(ins, subscription, CanardTraceEventRxTruncation, frame);
+    }
+}
+
+CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
+                                    CanardRxSubscription* const subscription,
+                                    const RxFrameModel* const   frame,
+                                    const uint8_t               redundant_transport_index,
+                                    CanardRxTransfer* const     out_transfer)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT(subscription != NULL);
+    CANARD_ASSERT(subscription->port_id == frame->port_id);
+    CANARD_ASSERT(frame != NULL);
+    CANARD_ASSERT(frame->payload != NULL);
+    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
+    CANARD_ASSERT((CANARD_NODE_ID_UNSET == frame->destination_node_id) || (ins->node_id == frame->destination_node_id));
+    CANARD_ASSERT(out_transfer != NULL);
+
+    // Borrowed single-frame transfers are reassembled with zero extent so that no payload buffer is allocated.
+    const bool borrow = subscription->borrow_single_frame && frame->start_of_transfer && frame->end_of_transfer;
+    int8_t     out    = 0;
+    if (frame->source_node_id <= CANARD_NODE_ID_MAX)
+    {
+        // If such session does not exist, create it. This only makes sense if this is the first frame of a
+        // transfer, otherwise, we won't be able to receive the transfer anyway so we don't bother.
+        CanardInternalRxSession* rxs = rxSessionFind(ins, subscription, frame->transfer_kind, frame->source_node_id);
+        if ((NULL == rxs) && frame->start_of_transfer)
+        {
+            rxs = rxSessionCreate(ins, subscription, frame->transfer_kind, frame->source_node_id);
+            if (rxs != NULL)
+            {
+                rxs->transfer_timestamp_usec   = frame->timestamp_usec;
+                rxs->total_payload_size        = 0U;
+                rxs->payload_size              = 0U;
+                rxs->payload                   = NULL;
+                rxs->calculated_crc            = CRC_INITIAL;
+                rxs->transfer_id               = frame->transfer_id;
+                rxs->redundant_transport_index = redundant_transport_index;
+                rxs->toggle                    = INITIAL_TOGGLE_STATE;
+            }
+            else
+            {
+                rxRecordEvent(ins, subscription, CanardTraceEventRxOutOfMemory, frame);
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        else if (NULL == rxs)
+        {
+            rxRecordEvent(ins, subscription, CanardTraceEventRxSOTMiss, frame);
+        }
+        else
+        {
+            (void) 0;  // The session exists already.
+        }
+        // The frames from the redundant transports other than the one the session is locked on are rejected here,
+        // before any further processing, unless the transfer-ID timeout has expired or the active transport has gone
+        // quiet, in which case the session switches over to the transport of this frame.
+        if ((rxs != NULL) && (rxs->redundant_transport_index != redundant_transport_index))
+        {
+            if (frame->start_of_transfer &&
+                rxTransportIsQuiet(ins, rxs->redundant_transport_index, frame->timestamp_usec))
+            {
+                rxPayloadFree(ins, subscription, rxs->payload);
+                rxs->payload = NULL;
+                rxSessionReset(rxs, frame, redundant_transport_index);
+            }
+            else if (!rxSessionTimedOut(rxs, frame->timestamp_usec, subscription->transfer_id_timeout_usec))
+            {
+                if (redundant_transport_index < CANARD_RX_REDUNDANT_TRANSPORTS_MAX)
+                {
+                    ins->rx_redundant_frames_dropped[redundant_transport_index]++;
+                }
+                rxRecordEvent(ins, subscription, CanardTraceEventRxDuplicate, frame);
+                rxs = NULL;  // This frame would have been rejected by rxSessionUpdate() anyway.
+            }
+            else
+            {
+                (void) 0;  // The session will be restarted on the new transport by rxSessionUpdate().
+            }
+        }
+        // The session may not exist because of: 1. OOM; 2. SOT-miss; 3. an inactive redundant transport.
+        if (rxs != NULL)
+        {
+            const CanardMicrosecond started_at_usec = rxs->transfer_timestamp_usec;
+            CANARD_ASSERT(out == 0);
+            out = rxSessionUpdate(ins,
+                                  rxs,
+                                  frame,
+                                  redundant_transport_index,
+                                  subscription->transfer_id_timeout_usec,
+                                  borrow ? 0U : subscription->extent,
+                                  out_transfer);
+            if (borrow && (out > 0))
+            {
+                rxBorrowFramePayload(ins, subscription, frame, out_transfer);
+            }
+            if (rxs->transfer_timestamp_usec != started_at_usec)  // A new transfer has begun.
+            {
+                rxSessionUnlink(ins, rxs);
+                rxSessionLink(ins, rxs);
+            }
+        }
+    }
+    else
+    {
+        CANARD_ASSERT(frame->source_node_id == CANARD_NODE_ID_UNSET);
+        // Anonymous transfers are stateless. No need to update the state machine, just blindly accept it.
+        // We have to copy the data into an allocated storage because the API expects it: the lifetime shall be
+        // independent of the input data and the memory shall be free-able. The streaming mode needs no copy.
+        const size_t payload_size =
+            (subscription->extent < frame->payload_size) ? subscription->extent : frame->payload_size;
+        const bool  stream  = subscription->stream_handler != NULL;
+        void* const payload = (borrow || stream) ? NULL : rxPayloadAllocate(ins, subscription, payload_size);
+        if (stream)
+        {
+            rxStreamSingleFrame(ins, subscription, frame, frame->timestamp_usec);
+        }
+        else if (borrow)
+        {
+            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
+            out_transfer->timestamp_usec = frame->timestamp_usec;
+            out_transfer->payload        = NULL;
+            rxRecordAccepted(ins, subscription, true);
+            rxBorrowFramePayload(ins, subscription, frame, out_transfer);
+            out = 1;
+        }
+        else if (payload != NULL)
+        {
+            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
+            out_transfer->timestamp_usec   = frame->timestamp_usec;
+            out_transfer->payload_size     = payload_size;
+            out_transfer->payload          = payload;
+            out_transfer->payload_borrowed = false;
+            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
+            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
+            (void) memcpy(payload, frame->payload, payload_size);  // NOLINT
+            out = 1;
+            rxRecordAccepted(ins, subscription, true);
+            if (frame->payload_size > payload_size)
+            {
+                rxRecordEvent(ins, subscription, CanardTraceEventRxTruncation, frame);
+            }
+        }
+        else
+        {
+            rxRecordEvent(ins, subscription, CanardTraceEventRxOutOfMemory, frame);
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    return out;
 }
 
-CANARD_PRIVATE void rxInitTransferMetadataFromFrame(const RxFrameModel* const     frame,
-                                                    CanardTransferMetadata* const out_transfer)
+CANARD_PRIVATE int8_t
+rxSubscriptionPredicateOnPortID(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
+                                const CanardTreeNode* const node)
 {
-    CANARD_ASSERT(frame != NULL);
-    CANARD_ASSERT(frame->payload != NULL);
-    CANARD_ASSERT(out_transfer != NULL);
-    out_transfer->priority       = frame->priority;
-    out_transfer->transfer_kind  = frame->transfer_kind;
-    out_transfer->port_id        = frame->port_id;
-    out_transfer->remote_node_id = frame->source_node_id;
-    out_transfer->transfer_id    = frame->transfer_id;
+    const CanardPortID  sought    = *((const CanardPortID*) user_reference);
+    const CanardPortID  other     = ((const CanardRxSubscription*) node)->port_id;
+    static const int8_t NegPos[2] = {-1, +1};
+    // Clang-Tidy mistakenly identifies a narrowing cast to int8_t here, which is incorrect.
+    return (sought == other) ? 0 : NegPos[sought > other];  // NOLINT no narrowing conversion is taking place here
 }
 
-/// The implementation is borrowed from the Specification.
-CANARD_PRIVATE uint8_t rxComputeTransferIDDifference(const uint8_t a, const uint8_t b)
+CANARD_PRIVATE int8_t
+rxSubscriptionPredicateOnStruct(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
+                                const CanardTreeNode* const node)
 {
-    CANARD_ASSERT(a <= CANARD_TRANSFER_ID_MAX);
-    CANARD_ASSERT(b <= CANARD_TRANSFER_ID_MAX);
-    int16_t diff = (int16_t) (((int16_t) a) - ((int16_t) b));
-    if (diff < 0)
-    {
-        const uint8_t modulo = 1U << CANARD_TRANSFER_ID_BIT_LENGTH;
-        diff                 = (int16_t) (diff + (int16_t) modulo);
-    }
-    return (uint8_t) diff;
+    return rxSubscriptionPredicateOnPortID(&((CanardRxSubscription*) user_reference)->port_id, node);
 }
 
-CANARD_PRIVATE int8_t rxSessionWritePayload(CanardInstance* const          ins,
-                                            CanardInternalRxSession* const rxs,
-                                            const size_t                   extent,
-                                            const size_t                   payload_size,
-                                            const void* const              payload)
+/// A page of the subject lookup table; see CanardRxLookup.
+typedef struct CanardInternalRxLookupPage
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(rxs != NULL);
-    CANARD_ASSERT((payload != NULL) || (payload_size == 0U));
-    CANARD_ASSERT(rxs->payload_size <= extent);  // This invariant is enforced by the subscription logic.
-    CANARD_ASSERT(rxs->payload_size <= rxs->total_payload_size);
-
-    rxs->total_payload_size += payload_size;
-
-    // Allocate the payload lazily, as late as possible.
-    if ((NULL == rxs->payload) && (extent > 0U))
-    {
-        CANARD_ASSERT(rxs->payload_size == 0);
-        rxs->payload = ins->memory_allocate(ins, extent);
-    }
+    size_t                count;  ///< The number of non-NULL entries; the page is deallocated when this reaches zero.
+    CanardRxSubscription* subscriptions[CANARD_RX_LOOKUP_PAGE_SIZE];
+} RxLookupPage;
 
-    int8_t out = 0;
-    if (rxs->payload != NULL)
+/// Returns the lookup table entry for the specified port, or NULL if the port-ID is not valid for the transfer kind.
+/// If the port is a subject whose page is not allocated, the out_page is set to NULL and the result is also NULL.
+CANARD_PRIVATE CanardRxSubscription** rxLookupLocate(CanardRxLookup* const    lookup,
+                                                     const CanardTransferKind transfer_kind,
+                                                     const CanardPortID       port_id,
+                                                     RxLookupPage** const     out_page)
+{
+    CANARD_ASSERT((lookup != NULL) && (out_page != NULL));
+    CanardRxSubscription** out = NULL;
+    *out_page                  = NULL;
+    if (CanardTransferKindMessage == transfer_kind)
     {
-        // Copy the payload into the contiguous buffer. Apply the implicit truncation rule if necessary.
-        size_t bytes_to_copy = payload_size;
-        if ((rxs->payload_size + bytes_to_copy) > extent)
+        if (port_id <= CANARD_SUBJECT_ID_MAX)
         {
-            CANARD_ASSERT(rxs->payload_size <= extent);
-            bytes_to_copy = extent - rxs->payload_size;
-            CANARD_ASSERT((rxs->payload_size + bytes_to_copy) == extent);
-            CANARD_ASSERT(bytes_to_copy < payload_size);
+            *out_page = lookup->subject_pages[port_id / CANARD_RX_LOOKUP_PAGE_SIZE];
+            out       = (*out_page != NULL) ? &(*out_page)->subscriptions[port_id % CANARD_RX_LOOKUP_PAGE_SIZE] : NULL;
         }
-        // This memcpy() call here is one of the two variable-complexity operations in the RX pipeline;
-        // the other one is the search of the matching subscription state.
-        // Excepting these two cases, the entire RX pipeline contains neither loops nor recursion.
-        // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
-        // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-        // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-        (void) memcpy(&rxs->payload[rxs->payload_size], payload, bytes_to_copy);  // NOLINT NOSONAR
-        rxs->payload_size += bytes_to_copy;
-        CANARD_ASSERT(rxs->payload_size <= extent);
     }
     else
     {
-        CANARD_ASSERT(rxs->payload_size == 0);
-        out = (extent > 0U) ? -CANARD_ERROR_OUT_OF_MEMORY : 0;
+        CANARD_ASSERT((size_t) transfer_kind < CANARD_NUM_TRANSFER_KINDS);
+        if (port_id <= CANARD_SERVICE_ID_MAX)
+        {
+            out = &lookup->services[((size_t) transfer_kind) - 1U][port_id];
+        }
     }
-    CANARD_ASSERT(out <= 0);
     return out;
 }
 
-CANARD_PRIVATE void rxSessionRestart(CanardInstance* const ins, CanardInternalRxSession* const rxs)
+/// Constant-time replacement for the subscription tree search.
+CANARD_PRIVATE CanardRxSubscription* rxLookupFind(CanardRxLookup* const    lookup,
+                                                  const CanardTransferKind transfer_kind,
+                                                  const CanardPortID       port_id)
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(rxs != NULL);
-    ins->memory_free(ins, rxs->payload);  // May be NULL, which is OK.
-    rxs->total_payload_size = 0U;
-    rxs->payload_size       = 0U;
-    rxs->payload            = NULL;
-    rxs->calculated_crc     = CRC_INITIAL;
-    rxs->transfer_id        = (CanardTransferID) ((rxs->transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
-    // The transport index is retained.
-    rxs->toggle = INITIAL_TOGGLE_STATE;
+    RxLookupPage*                page  = NULL;
+    CanardRxSubscription** const entry = rxLookupLocate(lookup, transfer_kind, port_id, &page);
+    return (entry != NULL) ? *entry : NULL;
 }
 
-CANARD_PRIVATE int8_t rxSessionAcceptFrame(CanardInstance* const          ins,
-                                           CanardInternalRxSession* const rxs,
-                                           const RxFrameModel* const      frame,
-                                           const size_t                   extent,
-                                           CanardRxTransfer* const        out_transfer)
+/// Adds the subscription into the lookup table, allocating the page if necessary. Subscriptions whose port-ID is
+/// invalid cannot match any frame so they are not indexed. Returns false if the page could not be allocated.
+CANARD_PRIVATE bool rxLookupInsert(CanardInstance* const       ins,
+                                   const CanardTransferKind    transfer_kind,
+                                   CanardRxSubscription* const sub)
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(rxs != NULL);
-    CANARD_ASSERT(frame != NULL);
-    CANARD_ASSERT(frame->payload != NULL);
-    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
-    CANARD_ASSERT(out_transfer != NULL);
-
-    if (frame->start_of_transfer)  // The transfer timestamp is the timestamp of its first frame.
+    CANARD_ASSERT((ins != NULL) && (ins->rx_lookup != NULL) && (sub != NULL));
+    bool                   out   = true;
+    RxLookupPage*          page  = NULL;
+    CanardRxSubscription** entry = rxLookupLocate(ins->rx_lookup, transfer_kind, sub->port_id, &page);
+    if ((NULL == entry) && (CanardTransferKindMessage == transfer_kind) && (sub->port_id <= CANARD_SUBJECT_ID_MAX))
     {
-        rxs->transfer_timestamp_usec = frame->timestamp_usec;
+        page = (RxLookupPage*) insAllocate(ins, sizeof(RxLookupPage));
+        out  = (page != NULL);
+        if (out)
+        {
+            page->count = 0U;
+            for (size_t i = 0U; i < CANARD_RX_LOOKUP_PAGE_SIZE; i++)
+            {
+                page->subscriptions[i] = NULL;
+            }
+            ins->rx_lookup->subject_pages[sub->port_id / CANARD_RX_LOOKUP_PAGE_SIZE] = page;
+            entry = &page->subscriptions[sub->port_id % CANARD_RX_LOOKUP_PAGE_SIZE];
+        }
     }
-
-    const bool single_frame = frame->start_of_transfer && frame->end_of_transfer;
-    if (!single_frame)
+    if (entry != NULL)
     {
-        // Update the CRC. Observe that the implicit truncation rule may apply here: the payload may be
-        // truncated, but its CRC is validated always anyway.
-        rxs->calculated_crc = crcAdd(rxs->calculated_crc, frame->payload_size, frame->payload);
+        CANARD_ASSERT(NULL == *entry);  // The old subscription shall have been removed.
+        *entry = sub;
+        if (page != NULL)
+        {
+            page->count++;
+        }
     }
+    return out;
+}
 
-    int8_t out = rxSessionWritePayload(ins, rxs, extent, frame->payload_size, frame->payload);
-    if (out < 0)
-    {
-        CANARD_ASSERT(-CANARD_ERROR_OUT_OF_MEMORY == out);
-        rxSessionRestart(ins, rxs);  // Out-of-memory.
-    }
-    else if (frame->end_of_transfer)
+/// Removes the subscription from the lookup table; the page is deallocated if it becomes empty.
+CANARD_PRIVATE void rxLookupRemove(CanardInstance* const    ins,
+                                   const CanardTransferKind transfer_kind,
+                                   const CanardPortID       port_id)
+{
+    CANARD_ASSERT((ins != NULL) && (ins->rx_lookup != NULL));
+    RxLookupPage*                page  = NULL;
+    CanardRxSubscription** const entry = rxLookupLocate(ins->rx_lookup, transfer_kind, port_id, &page);
+    if ((entry != NULL) && (*entry != NULL))
     {
-        CANARD_ASSERT(0 == out);
-        if (single_frame || (CRC_RESIDUE == rxs->calculated_crc))
+        *entry = NULL;
+        if (page != NULL)
         {
-            out = 1;  // One transfer received, notify the application.
-            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
-            out_transfer->timestamp_usec = rxs->transfer_timestamp_usec;
-            out_transfer->payload_size   = rxs->payload_size;
-            out_transfer->payload        = rxs->payload;
-
-            // Cut off the CRC from the payload if it's there -- we don't want to expose it to the user.
-            CANARD_ASSERT(rxs->total_payload_size >= rxs->payload_size);
-            const size_t truncated_amount = rxs->total_payload_size - rxs->payload_size;
-            if ((!single_frame) && (CRC_SIZE_BYTES > truncated_amount))  // Single-frame transfers don't have CRC.
+            CANARD_ASSERT(page->count > 0U);
+            page->count--;
+            if (0U == page->count)
             {
-                CANARD_ASSERT(out_transfer->payload_size >= (CRC_SIZE_BYTES - truncated_amount));
-                out_transfer->payload_size -= CRC_SIZE_BYTES - truncated_amount;
+                ins->rx_lookup->subject_pages[port_id / CANARD_RX_LOOKUP_PAGE_SIZE] = NULL;
+                ins->memory_free(ins, page);
             }
-
-            rxs->payload = NULL;  // Ownership passed over to the application, nullify to prevent freeing.
         }
-        rxSessionRestart(ins, rxs);  // Successful completion.
-    }
-    else
-    {
-        rxs->toggle = !rxs->toggle;
     }
-    return out;
 }
 
-/// RX session state machine update is the most intricate part of any UAVCAN transport implementation.
-/// The state model used here is derived from the reference pseudocode given in the original UAVCAN v0 specification.
-/// The UAVCAN/CAN v1 specification, which this library is an implementation of, does not provide any reference
-/// pseudocode. Instead, it takes a higher-level, more abstract approach, where only the high-level requirements
-/// are given and the particular algorithms are left to be implementation-defined. Such abstract approach is much
-/// advantageous because it allows implementers to choose whatever solution works best for the specific application at
-/// hand, while the wire compatibility is still guaranteed by the high-level requirements given in the specification.
-CANARD_PRIVATE int8_t rxSessionUpdate(CanardInstance* const          ins,
-                                      CanardInternalRxSession* const rxs,
-                                      const RxFrameModel* const      frame,
-                                      const uint8_t                  redundant_transport_index,
-                                      const CanardMicrosecond        transfer_id_timeout_usec,
-                                      const size_t                   extent,
-                                      CanardRxTransfer* const        out_transfer)
+/// The key of the sorted subscription index; see CanardRxIndex.
+CANARD_PRIVATE uint32_t rxIndexMakeKey(const CanardTransferKind transfer_kind, const CanardPortID port_id)
 {
-    CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(rxs != NULL);
-    CANARD_ASSERT(frame != NULL);
-    CANARD_ASSERT(out_transfer != NULL);
-    CANARD_ASSERT(rxs->transfer_id <= CANARD_TRANSFER_ID_MAX);
-    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
+    return (((uint32_t) transfer_kind) << 16U) | (uint32_t) port_id;
+}
 
-    const bool tid_timed_out = (frame->timestamp_usec > rxs->transfer_timestamp_usec) &&
-                               ((frame->timestamp_usec - rxs->transfer_timestamp_usec) > transfer_id_timeout_usec);
+/// Returns the number of keys in the index that are less than the specified one. The loop has a fixed number of
+/// iterations for a given index size and no data-dependent branches, so the compiler can use conditional moves.
+CANARD_PRIVATE size_t rxIndexLowerBound(const CanardRxIndex* const index, const uint32_t key)
+{
+    CANARD_ASSERT(index != NULL);
+    size_t base = 0U;
+    size_t n    = index->size;
+    while (n > 1U)
+    {
+        const size_t half = n / 2U;
+        base              = (index->keys[base + half - 1U] < key) ? (base + half) : base;
+        n -= half;
+    }
+    return ((n > 0U) && (index->keys[base] < key)) ? (base + 1U) : base;
+}
 
-    const bool not_previous_tid = rxComputeTransferIDDifference(rxs->transfer_id, frame->transfer_id) > 1;
+/// Logarithmic replacement for the subscription tree search.
+CANARD_PRIVATE CanardRxSubscription* rxIndexFind(const CanardRxIndex* const index,
+                                                 const CanardTransferKind   transfer_kind,
+                                                 const CanardPortID         port_id)
+{
+    const uint32_t key = rxIndexMakeKey(transfer_kind, port_id);
+    const size_t   pos = rxIndexLowerBound(index, key);
+    return ((pos < index->size) && (index->keys[pos] == key)) ? index->subscriptions[pos] : NULL;
+}
 
-    const bool need_restart = tid_timed_out || ((rxs->redundant_transport_index == redundant_transport_index) &&
-                                                frame->start_of_transfer && not_previous_tid);
+/// Adds the subscription into the index shifting the greater keys up. Returns false if the index is full.
+CANARD_PRIVATE bool rxIndexInsert(CanardRxIndex* const        index,
+                                  const CanardTransferKind    transfer_kind,
+                                  CanardRxSubscription* const sub)
+{
+    CANARD_ASSERT((index != NULL) && (sub != NULL));
+    const bool out = index->size < index->capacity;
+    if (out)
+    {
+        const uint32_t key = rxIndexMakeKey(transfer_kind, sub->port_id);
+        const size_t   pos = rxIndexLowerBound(index, key);
+        CANARD_ASSERT((pos == index->size) || (index->keys[pos] != key));  // The old one shall have been removed.
+        for (size_t i = index->size; i > pos; i--)
+        {
+            index->keys[i]          = index->keys[i - 1U];
+            index->subscriptions[i] = index->subscriptions[i - 1U];
+        }
+        index->keys[pos]          = key;
+        index->subscriptions[pos] = sub;
+        index->size++;
+    }
+    return out;
+}
 
-    if (need_restart)
+/// Removes the subscription from the index shifting the greater keys down, if it is indexed.
+CANARD_PRIVATE void rxIndexRemove(CanardRxIndex* const     index,
+                                  const CanardTransferKind transfer_kind,
+                                  const CanardPortID       port_id)
+{
+    CANARD_ASSERT(index != NULL);
+    const uint32_t key = rxIndexMakeKey(transfer_kind, port_id);
+    const size_t   pos = rxIndexLowerBound(index, key);
+    if ((pos < index->size) && (index->keys[pos] == key))
     {
-        rxs->total_payload_size        = 0U;
-        rxs->payload_size              = 0U;
-        rxs->calculated_crc            = CRC_INITIAL;
-        rxs->transfer_id               = frame->transfer_id;
-        rxs->toggle                    = INITIAL_TOGGLE_STATE;
-        rxs->redundant_transport_index = redundant_transport_index;
+        index->size--;
+        for (size_t i = pos; i < index->size; i++)
+        {
+            index->keys[i]          = index->keys[i + 1U];
+            index->subscriptions[i] = index->subscriptions[i + 1U];
+        }
     }
+}
 
-    int8_t out = 0;
-    if (need_restart && (!frame->start_of_transfer))
+/// Returns the subscription matching the parsed frame, or NULL if there is none.
+CANARD_PRIVATE CanardRxSubscription* rxFindSubscription(CanardInstance* const    ins,
+                                                        const CanardTransferKind transfer_kind,
+                                                        const CanardPortID       port_id)
+{
+    CANARD_ASSERT(ins != NULL);
+    CANARD_ASSERT((size_t) transfer_kind < CANARD_NUM_TRANSFER_KINDS);
+    CanardRxSubscription* out = NULL;
+    if (ins->rx_lookup != NULL)
     {
-        rxSessionRestart(ins, rxs);  // SOT-miss, no point going further.
+        out = rxLookupFind(ins->rx_lookup, transfer_kind, port_id);
+    }
+    else if (ins->rx_index != NULL)
+    {
+        out = rxIndexFind(ins->rx_index, transfer_kind, port_id);
     }
     else
     {
-        const bool correct_transport = (rxs->redundant_transport_index == redundant_transport_index);
-        const bool correct_toggle    = (frame->toggle == rxs->toggle);
-        const bool correct_tid       = (frame->transfer_id == rxs->transfer_id);
-        if (correct_transport && correct_toggle && correct_tid)
-        {
-            out = rxSessionAcceptFrame(ins, rxs, frame, extent, out_transfer);
-        }
+        // This is the reason the RX pipeline has a logarithmic time complexity of the number of subscriptions unless
+        // the lookup table is enabled. Note also that this one of the two variable-complexity operations in the RX
+        // pipeline; the other one is memcpy(). Excepting these two cases, the RX pipeline contains no loops.
+        const size_t tk              = (size_t) transfer_kind;
+        CanardPortID port_id_mutable = port_id;
+        out                          = (CanardRxSubscription*)
+            cavlSearch(&ins->rx_subscriptions[tk], &port_id_mutable, &rxSubscriptionPredicateOnPortID, NULL);
     }
     return out;
 }
 
-CANARD_PRIVATE int8_t rxAcceptFrame(CanardInstance* const       ins,
-                                    CanardRxSubscription* const subscription,
-                                    const RxFrameModel* const   frame,
-                                    const uint8_t               redundant_transport_index,
-                                    CanardRxTransfer* const     out_transfer)
+/// The result of the last subscription search, reused if the next frame belongs to the same port.
+/// The initial transfer kind shall be CANARD_NUM_TRANSFER_KINDS (invalid) to force the first search.
+typedef struct
+{
+    CanardTransferKind    transfer_kind;
+    CanardPortID          port_id;
+    CanardRxSubscription* subscription;
+} RxSubscriptionCache;
+
+/// Invokes the listeners of the subscription in the order of registration until one of them retains the payload.
+/// If none of them do, the payload is released.
+CANARD_PRIVATE void rxDispatch(CanardInstance* const       ins,
+                               CanardRxSubscription* const subscription,
+                               CanardRxTransfer* const     transfer)
+{
+    CANARD_ASSERT((ins != NULL) && (subscription != NULL) && (transfer != NULL));
+    bool              retained = false;
+    CanardRxListener* listener = subscription->listeners;
+    while ((!retained) && (listener != NULL))
+    {
+        CANARD_ASSERT(listener->handler != NULL);
+        CanardRxListener* const next = listener->next;
+        retained                     = listener->handler(ins, listener, subscription, transfer);
+        listener                     = next;
+    }
+    if ((!retained) && (!transfer->payload_borrowed))
+    {
+        rxPayloadFree(ins, subscription, transfer->payload);
+    }
+}
+
+/// Counts the valid frames that are not of interest to this node. No effect if CANARD_STATS is off.
+CANARD_PRIVATE void rxRecordIgnored(CanardInstance* const ins)
 {
     CANARD_ASSERT(ins != NULL);
-    CANARD_ASSERT(subscription != NULL);
-    CANARD_ASSERT(subscription->port_id == frame->port_id);
-    CANARD_ASSERT(frame != NULL);
-    CANARD_ASSERT(frame->payload != NULL);
-    CANARD_ASSERT(frame->transfer_id <= CANARD_TRANSFER_ID_MAX);
-    CANARD_ASSERT((CANARD_NODE_ID_UNSET == frame->destination_node_id) || (ins->node_id == frame->destination_node_id));
-    CANARD_ASSERT(out_transfer != NULL);
+#if CANARD_STATS
+    ins->rx_frames_ignored++;
+#else
+    (void) ins;
+#endif
+}
+
+/// Counts the frames that are not valid UAVCAN/CAN frames. No effect if CANARD_STATS is off.
+CANARD_PRIVATE void rxRecordMalformed(CanardInstance* const ins)
+{
+    CANARD_ASSERT(ins != NULL);
+#if CANARD_STATS
+    ins->rx_frames_malformed++;
+#endif
+    insTrace(ins, CanardTraceEventRxMalformed, NULL);
+}
 
+/// Processes a parsed frame: checks the destination, finds the subscription (unless cached), and updates the session.
+/// Returns the same values as canardRxAccept().
+CANARD_PRIVATE int8_t rxAcceptParsedFrame(CanardInstance* const        ins,
+                                          RxSubscriptionCache* const   cache,
+                                          const RxFrameModel* const    model,
+                                          const uint8_t                redundant_transport_index,
+                                          CanardRxTransfer* const      out_transfer,
+                                          CanardRxSubscription** const out_subscription)
+{
+    CANARD_ASSERT((ins != NULL) && (cache != NULL) && (model != NULL) && (out_transfer != NULL));
+    if (redundant_transport_index < CANARD_RX_REDUNDANT_TRANSPORTS_MAX)
+    {
+        ins->rx_last_frame_usec[redundant_transport_index] = model->timestamp_usec;
+    }
     int8_t out = 0;
-    if (frame->source_node_id <= CANARD_NODE_ID_MAX)
+    if ((CANARD_NODE_ID_UNSET == model->destination_node_id) || (ins->node_id == model->destination_node_id))
     {
-        // If such session does not exist, create it. This only makes sense if this is the first frame of a
-        // transfer, otherwise, we won't be able to receive the transfer anyway so we don't bother.
-        if ((NULL == subscription->sessions[frame->source_node_id]) && frame->start_of_transfer)
+        if ((cache->transfer_kind != model->transfer_kind) || (cache->port_id != model->port_id))
         {
-            CanardInternalRxSession* const rxs =
-                (CanardInternalRxSession*) ins->memory_allocate(ins, sizeof(CanardInternalRxSession));
-            subscription->sessions[frame->source_node_id] = rxs;
-            if (rxs != NULL)
-            {
-                rxs->transfer_timestamp_usec   = frame->timestamp_usec;
-                rxs->total_payload_size        = 0U;
-                rxs->payload_size              = 0U;
-                rxs->payload                   = NULL;
-                rxs->calculated_crc            = CRC_INITIAL;
-                rxs->transfer_id               = frame->transfer_id;
-                rxs->redundant_transport_index = redundant_transport_index;
-                rxs->toggle                    = INITIAL_TOGGLE_STATE;
-            }
-            else
+            cache->transfer_kind = model->transfer_kind;
+            cache->port_id       = model->port_id;
+            cache->subscription  = rxFindSubscription(ins, model->transfer_kind, model->port_id);
+        }
+        CanardRxSubscription* const sub = cache->subscription;
+        if (out_subscription != NULL)
+        {
+            *out_subscription = sub;  // Expose selected instance to the caller.
+        }
+        if (sub != NULL)
+        {
+            CANARD_ASSERT(sub->port_id == model->port_id);
+            out = rxAcceptFrame(ins, sub, model, redundant_transport_index, out_transfer);
+            if ((out > 0) && (sub->listeners != NULL))
             {
-                out = -CANARD_ERROR_OUT_OF_MEMORY;
+                rxDispatch(ins, sub, out_transfer);
+                out = 0;  // The transfer is consumed by the listeners.
             }
         }
-        // There are two possible reasons why the session may not exist: 1. OOM; 2. SOT-miss.
-        if (subscription->sessions[frame->source_node_id] != NULL)
+        else
         {
-            CANARD_ASSERT(out == 0);
-            out = rxSessionUpdate(ins,
-                                  subscription->sessions[frame->source_node_id],
-                                  frame,
-                                  redundant_transport_index,
-                                  subscription->transfer_id_timeout_usec,
-                                  subscription->extent,
-                                  out_transfer);
+            rxRecordIgnored(ins);
+            out = 0;  // No matching subscription.
         }
     }
     else
     {
-        CANARD_ASSERT(frame->source_node_id == CANARD_NODE_ID_UNSET);
-        // Anonymous transfers are stateless. No need to update the state machine, just blindly accept it.
-        // We have to copy the data into an allocated storage because the API expects it: the lifetime shall be
-        // independent of the input data and the memory shall be free-able.
-        const size_t payload_size =
-            (subscription->extent < frame->payload_size) ? subscription->extent : frame->payload_size;
-        void* const payload = ins->memory_allocate(ins, payload_size);
-        if (payload != NULL)
-        {
-            rxInitTransferMetadataFromFrame(frame, &out_transfer->metadata);
-            out_transfer->timestamp_usec = frame->timestamp_usec;
-            out_transfer->payload_size   = payload_size;
-            out_transfer->payload        = payload;
-            // Clang-Tidy raises an error recommending the use of memcpy_s() instead.
-            // We ignore it because the safe functions are poorly supported; reliance on them may limit the portability.
-            (void) memcpy(payload, frame->payload, payload_size);  // NOLINT
-            out = 1;
-        }
-        else
-        {
-            out = -CANARD_ERROR_OUT_OF_MEMORY;
-        }
+        rxRecordIgnored(ins);
+        out = 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
     }
     return out;
 }
 
-CANARD_PRIVATE int8_t
-rxSubscriptionPredicateOnPortID(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
-                                const CanardTreeNode* const node)
+#if ATOMIC_FENCES_C11
+/// The default implementations of CANARD_ATOMIC_LOAD_ACQUIRE() and CANARD_ATOMIC_STORE_RELEASE() for the C11
+/// compilers that do not provide the GCC atomic builtins. The indexes of the RX ring are not _Atomic objects,
+/// hence the fences; the size_t accesses are assumed to be indivisible.
+CANARD_PRIVATE size_t atomicLoadAcquire(const size_t* const ptr)
 {
-    const CanardPortID  sought    = *((const CanardPortID*) user_reference);
-    const CanardPortID  other     = ((const CanardRxSubscription*) node)->port_id;
-    static const int8_t NegPos[2] = {-1, +1};
-    // Clang-Tidy mistakenly identifies a narrowing cast to int8_t here, which is incorrect.
-    return (sought == other) ? 0 : NegPos[sought > other];  // NOLINT no narrowing conversion is taking place here
+    const size_t out = *(const volatile size_t*) ptr;
+    atomic_thread_fence(memory_order_acquire);
+    return out;
 }
 
-CANARD_PRIVATE int8_t
-rxSubscriptionPredicateOnStruct(void* const user_reference,  // NOSONAR Cavl API requires pointer to non-const.
-                                const CanardTreeNode* const node)
+CANARD_PRIVATE void atomicStoreRelease(size_t* const ptr, const size_t value)
 {
-    return rxSubscriptionPredicateOnPortID(&((CanardRxSubscription*) user_reference)->port_id, node);
+    atomic_thread_fence(memory_order_release);
+    *(volatile size_t*) ptr = value;
 }
+#endif
 
 // --------------------------------------------- PUBLIC API ---------------------------------------------
 
@@ -982,11 +3647,27 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
     CANARD_ASSERT(memory_allocate != NULL);
     CANARD_ASSERT(memory_free != NULL);
     const CanardInstance out = {
-        .user_reference   = NULL,
-        .node_id          = CANARD_NODE_ID_UNSET,
-        .memory_allocate  = memory_allocate,
-        .memory_free      = memory_free,
-        .rx_subscriptions = {NULL, NULL, NULL},
+        .user_reference              = NULL,
+        .node_id                     = CANARD_NODE_ID_UNSET,
+        .memory_allocate             = memory_allocate,
+        .memory_free                 = memory_free,
+        .rx_subscriptions            = {NULL, NULL, NULL},
+        .rx_lookup                   = NULL,
+        .rx_index                    = NULL,
+        .rx_session_pool             = NULL,
+        .rx_sessions_oldest          = NULL,
+        .rx_sessions_newest          = NULL,
+        .rx_failover_timeout_usec    = 0U,
+        .rx_last_frame_usec          = {0U},
+        .rx_redundant_frames_dropped = {0U},
+#if CANARD_STATS
+        .rx_stats                    = {0U},
+        .rx_frames_malformed         = 0U,
+        .rx_frames_ignored           = 0U,
+        .memory_allocations          = 0U,
+        .memory_allocated_bytes      = 0U,
+        .trace_hook                  = NULL,
+#endif
     };
     return out;
 }
@@ -994,59 +3675,287 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes)
 {
     CanardTxQueue out = {
-        .capacity       = capacity,
-        .mtu_bytes      = mtu_bytes,
-        .size           = 0,
-        .root           = NULL,
+        .capacity         = capacity,
+        .reserved         = {0U},
+        .size_by_priority = {0U},
+        .mtu_bytes        = mtu_bytes,
+        .size             = 0,
+        .root             = NULL,
+#if CANARD_TX_DEADLINE_INDEX
+        .deadline_root    = NULL,
+#endif
+        .engine           = CanardTxQueueEngineTree,
+        .bucket_head      = {NULL},
+        .bucket_tail      = {NULL},
+        .bucket_mask      = 0U,
+        .tree_top         = NULL,
+        .pool             = {.free_list = NULL, .block_size = 0U, .capacity = 0U, .used = 0U},
+        .shapers          = NULL,
+#if CANARD_STATS
+        .stats = {0U},
+#endif
         .user_reference = NULL,
     };
     return out;
 }
 
+CanardTxQueue canardTxInitWithPool(const size_t capacity,
+                                   const size_t mtu_bytes,
+                                   void* const  pool_memory,
+                                   const size_t pool_memory_size)
+{
+    CanardTxQueue out = canardTxInit(capacity, mtu_bytes);
+    if (pool_memory != NULL)
+    {
+        poolInit(&out.pool, pool_memory, pool_memory_size, txGetItemSize(adjustPresentationLayerMTU(mtu_bytes) + 1U));
+    }
+    return out;
+}
+
 int32_t canardTxPush(CanardTxQueue* const                que,
                      CanardInstance* const               ins,
                      const CanardMicrosecond             tx_deadline_usec,
                      const CanardTransferMetadata* const metadata,
                      const size_t                        payload_size,
                      const void* const                   payload)
+{
+    const CanardPayloadFragment frag = {.size = payload_size, .data = payload};
+    return canardTxPushV(que, ins, tx_deadline_usec, metadata, 1U, &frag);
+}
+
+int32_t canardTxPushV(CanardTxQueue* const                que,
+                      CanardInstance* const               ins,
+                      const CanardMicrosecond             tx_deadline_usec,
+                      const CanardTransferMetadata* const metadata,
+                      const size_t                        fragment_count,
+                      const CanardPayloadFragment* const  fragments)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (que != NULL) && (metadata != NULL) && ((fragments != NULL) || (0U == fragment_count)))
+    {
+        size_t payload_size = 0U;
+        bool   valid        = true;
+        for (size_t i = 0U; i < fragment_count; i++)
+        {
+            valid = valid && ((fragments[i].data != NULL) || (0U == fragments[i].size));
+            payload_size += fragments[i].size;
+        }
+        if (valid)
+        {
+            TxPayloadReader reader = txPayloadReaderInit(fragment_count, fragments);
+            out                    = txPush(que, ins, tx_deadline_usec, metadata, payload_size, &reader);
+            txRecordPush(que, ins, 1U, out, metadata);
+        }
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+void* canardTxAllocatePayload(CanardInstance* const ins, const size_t size)
+{
+    void* out = NULL;
+    if ((ins != NULL) && (size > 0U))
+    {
+        TxSharedPayload* const shared = (TxSharedPayload*) insAllocate(ins, sizeof(TxSharedPayload) + size);
+        if (shared != NULL)
+        {
+            shared->ref_count = 1U;  // Owned by the application.
+            out               = &shared->data[0];
+        }
+    }
+    return out;
+}
+
+void canardTxReleasePayload(CanardInstance* const ins, void* const payload)
+{
+    if ((ins != NULL) && (payload != NULL))
+    {
+        txSharedPayloadRelease(ins, txSharedPayloadFromData(payload));
+    }
+}
+
+int32_t canardTxPushShared(CanardTxQueue* const                que,
+                           CanardInstance* const               ins,
+                           const CanardMicrosecond             tx_deadline_usec,
+                           const CanardTransferMetadata* const metadata,
+                           const size_t                        payload_size,
+                           void* const                         payload)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (que != NULL) && (metadata != NULL) && ((payload != NULL) || (0U == payload_size)))
+    {
+        const CanardPayloadFragment frag   = {.size = payload_size, .data = payload};
+        TxPayloadReader             reader = txPayloadReaderInit(1U, &frag);
+        reader.shared                      = (payload != NULL) ? txSharedPayloadFromData(payload) : NULL;
+        out                                = txPush(que, ins, tx_deadline_usec, metadata, payload_size, &reader);
+        txRecordPush(que, ins, 1U, out, metadata);
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+int32_t canardTxPushRedundant(CanardTxQueue* const* const         ques,
+                              const size_t                        que_count,
+                              CanardInstance* const               ins,
+                              const CanardMicrosecond             tx_deadline_usec,
+                              const CanardTransferMetadata* const metadata,
+                              const size_t                        payload_size,
+                              const void* const                   payload,
+                              int32_t* const                      out_results)
+{
+    return txPushRedundant(ques, que_count, ins, tx_deadline_usec, metadata, payload_size, payload, false, out_results);
+}
+
+int32_t canardTxPushRedundantShared(CanardTxQueue* const* const         ques,
+                                    const size_t                        que_count,
+                                    CanardInstance* const               ins,
+                                    const CanardMicrosecond             tx_deadline_usec,
+                                    const CanardTransferMetadata* const metadata,
+                                    const size_t                        payload_size,
+                                    const void* const                   payload,
+                                    int32_t* const                      out_results)
+{
+    return txPushRedundant(ques, que_count, ins, tx_deadline_usec, metadata, payload_size, payload, true, out_results);
+}
+
+int32_t canardTxPushDirect(CanardTxQueue* const                que,
+                           CanardInstance* const               ins,
+                           CanardTxFrameSink* const            sink,
+                           const CanardMicrosecond             tx_deadline_usec,
+                           const CanardTransferMetadata* const metadata,
+                           const size_t                        payload_size,
+                           const void* const                   payload)
 {
     int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
     if ((ins != NULL) && (que != NULL) && (metadata != NULL) && ((payload != NULL) || (0U == payload_size)))
     {
-        const size_t  pl_mtu       = adjustPresentationLayerMTU(que->mtu_bytes);
-        const int32_t maybe_can_id = txMakeCANID(metadata, payload_size, payload, ins->node_id, pl_mtu);
-        if (maybe_can_id >= 0)
+        const CanardPayloadFragment frag   = {.size = payload_size, .data = payload};
+        TxPayloadReader             reader = txPayloadReaderInit(1U, &frag);
+        out = ((sink != NULL) && (0U == que->size))
+                  ? txPushDirect(que, ins, sink, tx_deadline_usec, metadata, payload_size, &reader)
+                  : txPush(que, ins, tx_deadline_usec, metadata, payload_size, &reader);
+        txRecordPush(que, ins, 1U, out, metadata);
+    }
+    CANARD_ASSERT(out != 0);
+    return out;
+}
+
+int8_t canardTxStreamInit(CanardTxStream* const               stream,
+                          const CanardTxQueue* const          que,
+                          const CanardInstance* const         ins,
+                          const CanardMicrosecond             tx_deadline_usec,
+                          const CanardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const CanardTxStreamRead            read)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((stream != NULL) && (que != NULL) && (ins != NULL) && (metadata != NULL) && (read != NULL) &&
+        (ins->node_id <= CANARD_NODE_ID_MAX))
+    {
+        const size_t  pl_mtu = txGetPresentationLayerMTU(que);
+        const int32_t can_id = txMakeCANIDV(metadata, payload_size, 0U, NULL, ins->node_id, pl_mtu);
+        if (can_id >= 0)
+        {
+            stream->read                 = read;
+            stream->metadata             = *metadata;
+            stream->metadata.transfer_id = (CanardTransferID) (metadata->transfer_id & CANARD_TRANSFER_ID_MAX);
+            stream->tx_deadline_usec     = tx_deadline_usec;
+            stream->payload_size         = payload_size;
+            stream->mtu_bytes            = pl_mtu;
+            stream->can_id               = (uint32_t) can_id;
+            stream->offset               = 0U;
+            stream->frame_count          = 0U;
+            stream->remaining_frames     = txCountFrames(pl_mtu, payload_size);
+            stream->crc                  = CRC_INITIAL;
+            stream->toggle               = INITIAL_TOGGLE_STATE;
+            out                          = 0;
+        }
+    }
+    return out;
+}
+
+int32_t canardTxStreamPump(CanardTxQueue* const  que,
+                           CanardInstance* const ins,
+                           CanardTxStream* const stream,
+                           const size_t          max_frames)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (ins != NULL) && (stream != NULL) && (stream->read != NULL))
+    {
+        out = txStreamPump(que, ins, stream, max_frames);
+        txRecordPush(que, ins, ((out > 0) && (0U == stream->remaining_frames)) ? 1U : 0U, out, &stream->metadata);
+    }
+    return out;
+}
+
+int32_t canardTxPushMany(CanardTxQueue* const           que,
+                         CanardInstance* const          ins,
+                         const size_t                   count,
+                         const CanardTxBatchItem* const items)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (que != NULL) && ((items != NULL) || (0U == count)))
+    {
+        const size_t pl_mtu                           = txGetPresentationLayerMTU(que);
+        size_t       num_frames                       = 0U;
+        size_t       demand[CANARD_PRIORITY_MAX + 1U] = {0U};
+        out                                           = 0;
+        // Bail early if we can see that we won't fit anyway: the number of frames depends only on the payload size.
+        for (size_t i = 0U; (i < count) && (out == 0); i++)
         {
-            if (payload_size <= pl_mtu)
+            if ((items[i].payload != NULL) || (0U == items[i].payload_size))
             {
-                out = txPushSingleFrame(que,
-                                        ins,
-                                        tx_deadline_usec,
-                                        (uint32_t) maybe_can_id,
-                                        metadata->transfer_id,
-                                        payload_size,
-                                        payload);
-                CANARD_ASSERT((out < 0) || (out == 1));
+                const size_t n = txCountFrames(pl_mtu, items[i].payload_size);
+                num_frames += n;
+                demand[((size_t) items[i].metadata.priority) & CANARD_PRIORITY_MAX] += n;
             }
             else
             {
-                out = txPushMultiFrame(que,
-                                       ins,
-                                       pl_mtu,
-                                       tx_deadline_usec,
-                                       (uint32_t) maybe_can_id,
-                                       metadata->transfer_id,
-                                       payload_size,
-                                       payload);
-                CANARD_ASSERT((out < 0) || (out >= 2));
+                out = -CANARD_ERROR_INVALID_ARGUMENT;
+            }
+        }
+        if ((0 == out) && !txHasRoom(que, demand))
+        {
+            out = -CANARD_ERROR_OUT_OF_MEMORY;
+        }
+        // Serialize all transfers before touching the queue to ensure that either all of them are enqueued or none.
+        TxChain batch = {NULL, NULL, 0};
+        for (size_t i = 0U; (i < count) && (out >= 0); i++)
+        {
+            const int32_t res = txGenerateBatchItem(que, ins, pl_mtu, &items[i], &batch);
+            out               = (res < 0) ? res : 0;
+        }
+        if (out >= 0)
+        {
+            CANARD_ASSERT(batch.size == num_frames);
+            // Split the batch into transfers and enqueue each one as a chain, so that only its first frame is searched.
+            TxChain            transfer = {NULL, NULL, 0};
+            CanardTxQueueItem* next     = (batch.head != NULL) ? &batch.head->base : NULL;
+            while (next != NULL)
+            {
+                CanardTxQueueItem* const item = next;
+                next                          = item->next_in_transfer;
+                transfer.head                 = (transfer.head == NULL) ? (TxItem*) item : transfer.head;
+                transfer.tail                 = (TxItem*) item;
+                transfer.size++;
+                // The last frame of a transfer has the end-of-transfer flag; the links between transfers are broken.
+                if ((txGetTailByte(item) & TAIL_END_OF_TRANSFER) != 0U)
+                {
+                    item->next_in_transfer = NULL;
+                    out += txEnqueueChain(que, &transfer);
+                    transfer.head = NULL;
+                    transfer.tail = NULL;
+                    transfer.size = 0U;
+                }
             }
+            CANARD_ASSERT((transfer.head == NULL) && (out == (int32_t) batch.size));
         }
         else
         {
-            out = maybe_can_id;
+            txFreeChain(que, ins, (batch.head != NULL) ? &batch.head->base : NULL);
         }
+        txRecordPush(que, ins, count, out, NULL);
     }
-    CANARD_ASSERT(out != 0);
     return out;
 }
 
@@ -1055,9 +3964,7 @@ const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que)
     const CanardTxQueueItem* out = NULL;
     if (que != NULL)
     {
-        // Paragraph 6.7.2.1.15 of the C standard says:
-        //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
-        out = (const CanardTxQueueItem*) cavlFindExtremum(que->root, false);
+        out = txQueueFindTop(que);
     }
     return out;
 }
@@ -1071,12 +3978,234 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
         // contract dictates that the pointer shall point to a mutable entity in RAM previously allocated by the
         // memory manager. It is difficult to avoid this cast in this context.
         out = (CanardTxQueueItem*) item;  // NOSONAR casting away const qualifier.
-        // Paragraph 6.7.2.1.15 of the C standard says:
-        //     A pointer to a structure object, suitably converted, points to its initial member, and vice versa.
         // Note that the highest-priority frame is always a leaf node in the AVL tree, which means that it is very
         // cheap to remove.
-        cavlRemove(&que->root, &item->base);
+        txQueueRemove(que, out);
         que->size--;
+        CanardTxShaper* const shaper = (que->shapers != NULL) ? txShaperFind(que, out->frame.extended_can_id) : NULL;
+        if (shaper != NULL)
+        {
+            shaper->credit -= ((int64_t) out->frame.payload_size) * MICROSECONDS_PER_SECOND;
+        }
+    }
+    return out;
+}
+
+const CanardTxQueueItem* canardTxPeekShaped(CanardTxQueue* const     que,
+                                            const CanardMicrosecond  now_usec,
+                                            CanardMicrosecond* const out_eligible_usec)
+{
+    const CanardTxQueueItem* out      = NULL;
+    CanardMicrosecond        eligible = UINT64_MAX;
+    if (que != NULL)
+    {
+        for (CanardTxShaper* shaper = que->shapers; shaper != NULL; shaper = shaper->next)
+        {
+            txShaperRefill(shaper, now_usec);
+            shaper->blocked = false;
+        }
+        // Once a frame of a shaped port is held back, so are all subsequent frames of that port, even if their cost
+        // is covered, because the frames of the same port shall not be reordered.
+        const CanardTxQueueItem* item = txQueueFindTop(que);
+        while ((NULL == out) && (item != NULL))
+        {
+            CanardTxShaper* const shaper = txShaperFind(que, item->frame.extended_can_id);
+            if (NULL == shaper)
+            {
+                out = item;
+            }
+            else if (!shaper->blocked)
+            {
+                const int64_t cost = txShaperGetCost(shaper, item);
+                if (shaper->credit >= cost)
+                {
+                    out = item;
+                }
+                else
+                {
+                    shaper->blocked = true;
+                    if (shaper->rate_bytes_per_second > 0U)
+                    {
+                        const uint64_t rate = shaper->rate_bytes_per_second;
+                        const uint64_t wait = (((uint64_t) (cost - shaper->credit)) + rate - 1U) / rate;
+                        eligible            = ((now_usec + wait) < eligible) ? (now_usec + wait) : eligible;
+                    }
+                }
+            }
+            else
+            {
+                (void) 0;  // The port is already held back.
+            }
+            item = (NULL == out) ? txQueueFindNext(que, item) : item;
+        }
+        eligible = (out != NULL) ? now_usec : eligible;
+    }
+    if (out_eligible_usec != NULL)
+    {
+        *out_eligible_usec = eligible;
+    }
+    return out;
+}
+
+int8_t canardTxShape(CanardTxQueue* const     que,
+                     const CanardTransferKind transfer_kind,
+                     const CanardPortID       port_id,
+                     const uint32_t           rate_bytes_per_second,
+                     const uint32_t           burst_bytes,
+                     CanardTxShaper* const    out_shaper)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (out_shaper != NULL) && (((size_t) transfer_kind) < CANARD_NUM_TRANSFER_KINDS))
+    {
+        out                               = (canardTxUnshape(que, transfer_kind, port_id) > 0) ? 0 : 1;
+        out_shaper->transfer_kind         = transfer_kind;
+        out_shaper->port_id               = port_id;
+        out_shaper->rate_bytes_per_second = rate_bytes_per_second;
+        out_shaper->burst_bytes           = burst_bytes;
+        out_shaper->credit                = txShaperGetCreditMax(out_shaper);
+        out_shaper->credit_timestamp_usec = 0U;
+        out_shaper->blocked               = false;
+        out_shaper->next                  = que->shapers;
+        que->shapers                      = out_shaper;
+    }
+    return out;
+}
+
+int8_t canardTxUnshape(CanardTxQueue* const que, const CanardTransferKind transfer_kind, const CanardPortID port_id)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((que != NULL) && (((size_t) transfer_kind) < CANARD_NUM_TRANSFER_KINDS))
+    {
+        out                   = 0;
+        CanardTxShaper** link = &que->shapers;
+        while ((0 == out) && (*link != NULL))
+        {
+            if (((*link)->transfer_kind == transfer_kind) && ((*link)->port_id == port_id))
+            {
+                *link = (*link)->next;
+                out   = 1;
+            }
+            else
+            {
+                link = &(*link)->next;
+            }
+        }
+    }
+    return out;
+}
+
+size_t canardTxPurgeExpired(CanardTxQueue* const que, CanardInstance* const ins, const CanardMicrosecond now_usec)
+{
+    size_t out = 0U;
+    if ((que != NULL) && (ins != NULL))
+    {
+#if CANARD_TX_DEADLINE_INDEX
+        const CanardTreeNode* node = cavlFindExtremum(que->deadline_root, false);
+        while ((node != NULL) && (((const CanardTxDeadlineNode*) node)->owner->tx_deadline_usec <= now_usec))
+        {
+            CanardTxQueueItem* const item = ((const CanardTxDeadlineNode*) node)->owner;
+            CANARD_ASSERT(item->tx_deadline_usec > 0U);
+            txPurgeItem(que, ins, item);
+            out++;
+            node = cavlFindExtremum(que->deadline_root, false);
+        }
+#else
+        CanardTxQueueItem* item = txQueueFindTop(que);
+        while (item != NULL)
+        {
+            CanardTxQueueItem* const next = txQueueFindNext(que, item);
+            if ((item->tx_deadline_usec > 0U) && (item->tx_deadline_usec <= now_usec))
+            {
+                txPurgeItem(que, ins, item);
+                out++;
+            }
+            item = next;
+        }
+#endif
+    }
+    return out;
+}
+
+size_t canardTxDropTransfer(CanardTxQueue* const           que,
+                            CanardInstance* const          ins,
+                            const CanardTxQueueItem* const item)
+{
+    size_t out = 0U;
+    if ((que != NULL) && (ins != NULL) && (item != NULL))
+    {
+        // Intentional violation of MISRA: casting away const qualifier. This is considered safe because the API
+        // contract dictates that the pointer shall point to a mutable entity in RAM previously allocated by the
+        // memory manager. It is difficult to avoid this cast in this context.
+        CanardTxQueueItem* next = (CanardTxQueueItem*) item;  // NOSONAR casting away const qualifier.
+        while (next != NULL)
+        {
+            CanardTxQueueItem* const current = next;
+            next                             = current->next_in_transfer;
+            if (txQueueContains(que, current))
+            {
+                txQueueRemove(que, current);
+                CANARD_ASSERT(que->size > 0U);
+                que->size--;
+                txFreeQueueItem(que, ins, current);
+                out++;
+            }
+        }
+    }
+    return out;
+}
+
+void canardTxFree(CanardTxQueue* const que, CanardInstance* const ins, CanardTxQueueItem* const item)
+{
+    if ((que != NULL) && (ins != NULL) && (item != NULL))
+    {
+        txFreeQueueItem(que, ins, item);
+    }
+}
+
+size_t canardTxGetFrameSegments(const CanardTxQueueItem* const item, CanardPayloadFragment* const out_segments)
+{
+    size_t out = 0U;
+    if ((item != NULL) && (out_segments != NULL))
+    {
+#if !CANARD_FIXED_MTU
+        TxSharedPayloadRef ref = {NULL, 0U, 0U};
+        if (txGetSharedPayloadRef(item, &ref))
+        {
+            CANARD_ASSERT((ref.shared != NULL) && (ref.size > 0U) && (ref.size < item->frame.payload_size));
+            out_segments[0].size = ref.size;
+            out_segments[0].data = &ref.shared->data[ref.offset];
+            out_segments[1].size = item->frame.payload_size - ref.size;
+            out_segments[1].data = &((const TxItem*) (const void*) item)->payload_buffer[sizeof(TxSharedPayloadRef)];
+            out                  = 2U;
+        }
+        else
+#endif
+        {
+            out_segments[0].size = item->frame.payload_size;
+            out_segments[0].data = item->frame.payload;
+            out                  = 1U;
+        }
+    }
+    CANARD_ASSERT(out <= CANARD_TX_FRAME_SEGMENTS_MAX);
+    return out;
+}
+
+size_t canardTxMaterializeFrame(const CanardTxQueueItem* const item, void* const destination)
+{
+    size_t out = 0U;
+    if ((item != NULL) && (destination != NULL))
+    {
+#if CANARD_FIXED_MTU
+        // The fixed-size frames are always materialized eagerly, so there is only one segment.
+        CANARD_ASSERT(item->frame.payload != NULL);
+        out = item->frame.payload_size;
+        (void) memcpy(destination, item->frame.payload, out);  // NOLINT
+#else
+        CanardPayloadFragment segments[CANARD_TX_FRAME_SEGMENTS_MAX];
+        TxPayloadReader       reader = txPayloadReaderInit(canardTxGetFrameSegments(item, &segments[0]), &segments[0]);
+        out                          = txPayloadRead(&reader, item->frame.payload_size, (uint8_t*) destination);
+        CANARD_ASSERT(out == item->frame.payload_size);
+#endif
     }
     return out;
 }
@@ -1095,41 +4224,67 @@ int8_t canardRxAccept(CanardInstance* const        ins,
         RxFrameModel model = {0};
         if (rxTryParseFrame(timestamp_usec, frame, &model))
         {
-            if ((CANARD_NODE_ID_UNSET == model.destination_node_id) || (ins->node_id == model.destination_node_id))
-            {
-                // This is the reason the function has a logarithmic time complexity of the number of subscriptions.
-                // Note also that this one of the two variable-complexity operations in the RX pipeline; the other one
-                // is memcpy(). Excepting these two cases, the entire RX pipeline contains neither loops nor recursion.
-                CanardRxSubscription* const sub =
-                    (CanardRxSubscription*) cavlSearch(&ins->rx_subscriptions[(size_t) model.transfer_kind],
-                                                       &model.port_id,
-                                                       &rxSubscriptionPredicateOnPortID,
-                                                       NULL);
-                if (out_subscription != NULL)
-                {
-                    *out_subscription = sub;  // Expose selected instance to the caller.
-                }
-                if (sub != NULL)
-                {
-                    CANARD_ASSERT(sub->port_id == model.port_id);
-                    out = rxAcceptFrame(ins, sub, &model, redundant_transport_index, out_transfer);
-                }
-                else
-                {
-                    out = 0;  // No matching subscription.
-                }
+            RxSubscriptionCache cache = {(CanardTransferKind) CANARD_NUM_TRANSFER_KINDS, 0U, NULL};
+            out = rxAcceptParsedFrame(ins, &cache, &model, redundant_transport_index, out_transfer, out_subscription);
+        }
+        else
+        {
+            rxRecordMalformed(ins);
+            out = 0;  // A non-UAVCAN/CAN input frame.
+        }
+    }
+    CANARD_ASSERT(out <= 1);
+    return out;
+}
+
+int32_t canardRxAcceptMany(CanardInstance* const          ins,
+                           const uint8_t                  redundant_transport_index,
+                           const size_t                   frame_count,
+                           const CanardRxBatchItem* const frames,
+                           const size_t                   transfer_capacity,
+                           CanardRxTransfer* const        out_transfers,
+                           CanardRxSubscription** const   out_subscriptions,
+                           size_t* const                  out_consumed)
+{
+    int32_t out      = -CANARD_ERROR_INVALID_ARGUMENT;
+    size_t  consumed = 0U;
+    if ((ins != NULL) && ((frames != NULL) || (0U == frame_count)) &&
+        ((out_transfers != NULL) || (0U == transfer_capacity)))
+    {
+        RxSubscriptionCache cache = {(CanardTransferKind) CANARD_NUM_TRANSFER_KINDS, 0U, NULL};
+        size_t              count = 0U;
+        bool                oom   = false;
+        while ((consumed < frame_count) && (count < transfer_capacity) && (!oom))
+        {
+            const CanardRxBatchItem* const item  = &frames[consumed];
+            RxFrameModel                   model = {0};
+            if ((item->frame.extended_can_id <= CAN_EXT_ID_MASK) &&
+                ((item->frame.payload != NULL) || (0U == item->frame.payload_size)) &&
+                rxTryParseFrame(item->timestamp_usec, &item->frame, &model))
+            {
+                const int8_t res = rxAcceptParsedFrame(ins,
+                                                       &cache,
+                                                       &model,
+                                                       redundant_transport_index,
+                                                       &out_transfers[count],
+                                                       (out_subscriptions != NULL) ? &out_subscriptions[count] : NULL);
+                CANARD_ASSERT(res <= 1);
+                oom = (res < 0);
+                count += (res > 0) ? 1U : 0U;
             }
             else
             {
-                out = 0;  // Mis-addressed frame (normally it should be filtered out by the hardware).
+                rxRecordMalformed(ins);
             }
+            consumed += oom ? 0U : 1U;
         }
-        else
-        {
-            out = 0;  // A non-UAVCAN/CAN input frame.
-        }
+        CANARD_ASSERT((count + 0ULL) <= INT32_MAX);  // +0 is to suppress warning.
+        out = (int32_t) count;
+    }
+    if (out_consumed != NULL)
+    {
+        *out_consumed = consumed;
     }
-    CANARD_ASSERT(out <= 1);
     return out;
 }
 
@@ -1153,6 +4308,18 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
             out_subscription->transfer_id_timeout_usec = transfer_id_timeout_usec;
             out_subscription->extent                   = extent;
             out_subscription->port_id                  = port_id;
+            out_subscription->borrow_single_frame      = false;
+            out_subscription->listeners                = NULL;
+            out_subscription->stream_handler           = NULL;
+            out_subscription->payload_pool.free_list   = NULL;
+            out_subscription->payload_pool.block_size  = 0U;  // The heap is used by default.
+            out_subscription->payload_pool.capacity    = 0U;
+            out_subscription->payload_pool.used        = 0U;
+#if CANARD_STATS
+            const CanardRxStats zero_stats = {0U};
+            out_subscription->stats        = zero_stats;
+#endif
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
             for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
             {
                 // The sessions will be created ad-hoc. Normally, for a low-jitter deterministic system,
@@ -1160,13 +4327,30 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
                 // We could accept an extra argument that would instruct us to pre-allocate sessions here?
                 out_subscription->sessions[i] = NULL;
             }
-            const CanardTreeNode* const res = cavlSearch(&ins->rx_subscriptions[tk],
-                                                         out_subscription,
-                                                         &rxSubscriptionPredicateOnStruct,
-                                                         &avlTrivialFactory);
-            (void) res;
-            CANARD_ASSERT(res == &out_subscription->base);
-            out = (out > 0) ? 0 : 1;
+#endif
+            bool indexed = (NULL == ins->rx_index) || rxIndexInsert(ins->rx_index, transfer_kind, out_subscription);
+            if (indexed && (ins->rx_lookup != NULL) && !rxLookupInsert(ins, transfer_kind, out_subscription))
+            {
+                if (ins->rx_index != NULL)
+                {
+                    rxIndexRemove(ins->rx_index, transfer_kind, port_id);
+                }
+                indexed = false;
+            }
+            if (indexed)
+            {
+                const CanardTreeNode* const res = cavlSearch(&ins->rx_subscriptions[tk],
+                                                             out_subscription,
+                                                             &rxSubscriptionPredicateOnStruct,
+                                                             &avlTrivialFactory);
+                (void) res;
+                CANARD_ASSERT(res == &out_subscription->base);
+                out = (out > 0) ? 0 : 1;
+            }
+            else
+            {
+                out = -CANARD_ERROR_OUT_OF_MEMORY;
+            }
         }
     }
     return out;
@@ -1187,18 +4371,342 @@ int8_t canardRxUnsubscribe(CanardInstance* const    ins,
         {
             cavlRemove(&ins->rx_subscriptions[tk], &sub->base);
             CANARD_ASSERT(sub->port_id == port_id);
+            if (ins->rx_lookup != NULL)
+            {
+                rxLookupRemove(ins, transfer_kind, port_id);
+            }
+            if (ins->rx_index != NULL)
+            {
+                rxIndexRemove(ins->rx_index, transfer_kind, port_id);
+            }
             out = 1;
             for (size_t i = 0; i < RX_SESSIONS_PER_SUBSCRIPTION; i++)
             {
-                ins->memory_free(ins, (sub->sessions[i] != NULL) ? sub->sessions[i]->payload : NULL);
-                ins->memory_free(ins, sub->sessions[i]);
-                sub->sessions[i] = NULL;
+                rxSessionDestroy(ins, sub, transfer_kind, (CanardNodeID) i);
+            }
+        }
+        else
+        {
+            out = 0;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxSetLookup(CanardInstance* const ins, CanardRxLookup* const lookup)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (NULL == ins->rx_subscriptions[CanardTransferKindMessage]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindResponse]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindRequest]))
+    {
+        if (lookup != NULL)
+        {
+            for (size_t i = 0U; i < (CANARD_SERVICE_ID_MAX + 1U); i++)
+            {
+                lookup->services[0][i] = NULL;
+                lookup->services[1][i] = NULL;
+            }
+            for (size_t i = 0U; i < ((CANARD_SUBJECT_ID_MAX + 1U) / CANARD_RX_LOOKUP_PAGE_SIZE); i++)
+            {
+                lookup->subject_pages[i] = NULL;
+            }
+        }
+        ins->rx_lookup = lookup;
+        out            = 0;
+    }
+    return out;
+}
+
+int8_t canardRxSetIndex(CanardInstance* const ins,
+                        CanardRxIndex* const  index,
+                        void* const           memory,
+                        const size_t          memory_size)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (NULL == ins->rx_subscriptions[CanardTransferKindMessage]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindResponse]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindRequest]))
+    {
+        const size_t capacity = memory_size / (sizeof(CanardRxSubscription*) + sizeof(uint32_t));
+        if (NULL == index)
+        {
+            ins->rx_index = NULL;
+            out           = 0;
+        }
+        else if ((memory != NULL) && (capacity > 0U))
+        {
+            // The pointers are placed first because their alignment requirement is not lower than that of the keys.
+            index->subscriptions = (CanardRxSubscription**) memory;
+            // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+            index->keys     = (uint32_t*) (void*) &((uint8_t*) memory)[capacity * sizeof(CanardRxSubscription*)];
+            index->capacity = capacity;
+            index->size     = 0U;
+            ins->rx_index   = index;
+            out             = 0;
+        }
+        else
+        {
+            (void) 0;  // The memory cannot accommodate a single subscription.
+        }
+    }
+    return out;
+}
+
+int8_t canardRxSetSessionPool(CanardInstance* const      ins,
+                              CanardRxSessionPool* const pool,
+                              void* const                memory,
+                              const size_t               memory_size)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (NULL == ins->rx_subscriptions[CanardTransferKindMessage]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindResponse]) &&
+        (NULL == ins->rx_subscriptions[CanardTransferKindRequest]))
+    {
+        // The index size is a power of two in (n, 2n], where n is the number of sessions that would fit if the index
+        // had exactly two slots per session; the capacity is limited such that the load factor does not exceed 3/4.
+        const size_t block_size = poolRoundBlockSize(sizeof(RxPoolSession));
+        const size_t ideal      = memory_size / (block_size + (2U * sizeof(RxPoolSession*)));
+        if (NULL == pool)
+        {
+            ins->rx_session_pool = NULL;
+            out                  = 0;
+        }
+        else if ((memory != NULL) && (ideal > 0U))
+        {
+            size_t index_size = 1U;
+            while (index_size <= ideal)
+            {
+                index_size *= 2U;
+            }
+            const size_t index_bytes = index_size * sizeof(RxPoolSession*);
+            const size_t max_load    = (index_size * 3U) / 4U;
+            size_t       capacity    = (memory_size - index_bytes) / block_size;
+            capacity                 = (capacity > max_load) ? max_load : capacity;
+            CANARD_ASSERT(capacity > 0U);
+            pool->index = (RxPoolSession**) memory;
+            for (size_t i = 0U; i < index_size; i++)
+            {
+                pool->index[i] = NULL;
             }
+            // Intentional violation of MISRA: indexing on a pointer. This is done to avoid pointer arithmetics.
+            poolInit(&pool->blocks, &((uint8_t*) memory)[index_bytes], capacity * block_size, sizeof(RxPoolSession));
+            CANARD_ASSERT(pool->blocks.capacity == capacity);
+            pool->index_size     = index_size;
+            pool->lru_head       = NULL;
+            pool->lru_tail       = NULL;
+            pool->evictions      = 0U;
+            ins->rx_session_pool = pool;
+            out                  = 0;
         }
         else
         {
+            (void) 0;  // The memory cannot accommodate a single session.
+        }
+    }
+    return out;
+}
+
+int32_t canardRxCleanup(CanardInstance* const ins, const CanardMicrosecond now_usec)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if (ins != NULL)
+    {
+        out        = 0;
+        bool again = true;
+        while (again && (ins->rx_sessions_oldest != NULL))
+        {
+            // The staleness condition is identical to the transfer-ID timeout check in rxSessionUpdate(), so that
+            // removing a stale session does not alter the outcome of the reception of the next frame.
+            CanardInternalRxSession* const rxs = ins->rx_sessions_oldest;
+            again = rxSessionTimedOut(rxs, now_usec, rxs->subscription->transfer_id_timeout_usec);
+            if (again)
+            {
+                rxSessionReclaim(ins, rxs);
+                out++;
+            }
+        }
+    }
+    return out;
+}
+
+int8_t canardRxSetPayloadPool(CanardInstance* const       ins,
+                              CanardRxSubscription* const subscription,
+                              void* const                 memory,
+                              const size_t                memory_size)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    // The buffers held by the sessions have to be returned to the storage they were taken from, so the storage
+    // cannot be changed while there are any, even if none of them are taken from the current pool.
+    bool held = false;
+    if (ins != NULL)
+    {
+        for (const CanardInternalRxSession* rxs = ins->rx_sessions_newest; (rxs != NULL) && (!held); rxs = rxs->older)
+        {
+            held = (rxs->subscription == subscription) && (rxs->payload != NULL);
+        }
+    }
+    if ((ins != NULL) && (subscription != NULL) && (0U == subscription->payload_pool.used) && (!held))
+    {
+        if (NULL == memory)
+        {
+            subscription->payload_pool.block_size = 0U;  // Revert to the heap.
+            subscription->payload_pool.capacity   = 0U;
+            subscription->payload_pool.free_list  = NULL;
+            out                                   = 0;
+        }
+        else if ((subscription->extent > 0U) && (memory_size >= poolRoundBlockSize(subscription->extent)))
+        {
+            poolInit(&subscription->payload_pool, memory, memory_size, subscription->extent);
+            CANARD_ASSERT(subscription->payload_pool.capacity > 0U);
             out = 0;
         }
+        else
+        {
+            (void) 0;  // The memory cannot accommodate a single buffer.
+        }
+    }
+    return out;
+}
+
+void canardRxReleasePayload(CanardInstance* const ins, CanardRxSubscription* const subscription, void* const payload)
+{
+    if ((ins != NULL) && (subscription != NULL))
+    {
+        rxPayloadFree(ins, subscription, payload);
+    }
+}
+
+int8_t canardRxAddListener(CanardRxSubscription* const subscription, CanardRxListener* const listener)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((subscription != NULL) && (listener != NULL) && (listener->handler != NULL))
+    {
+        CanardRxListener** link = &subscription->listeners;
+        while ((*link != NULL) && (*link != listener))
+        {
+            link = &(*link)->next;
+        }
+        out = 0;  // Already registered.
+        if (NULL == *link)
+        {
+            listener->next = NULL;
+            *link          = listener;
+            out            = 1;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxRemoveListener(CanardRxSubscription* const subscription, CanardRxListener* const listener)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((subscription != NULL) && (listener != NULL))
+    {
+        CanardRxListener** link = &subscription->listeners;
+        while ((*link != NULL) && (*link != listener))
+        {
+            link = &(*link)->next;
+        }
+        out = 0;  // Not registered.
+        if (*link != NULL)
+        {
+            *link          = listener->next;
+            listener->next = NULL;
+            out            = 1;
+        }
+    }
+    return out;
+}
+
+uint8_t canardRxGetShardForPort(const CanardTransferKind transfer_kind,
+                                const CanardPortID       port_id,
+                                const uint8_t            shard_count)
+{
+    uint8_t out = 0U;
+    if (shard_count > 0U)
+    {
+        // The subject-IDs and the service-IDs are mapped onto one contiguous range such that the ports are
+        // distributed evenly; the requests and the responses of a service are kept together in the same shard.
+        const uint32_t key = (CanardTransferKindMessage == transfer_kind)
+                                 ? (uint32_t) port_id
+                                 : ((uint32_t) port_id + (uint32_t) CANARD_SUBJECT_ID_MAX + 1U);
+        out                = (uint8_t) (key % shard_count);
+    }
+    return out;
+}
+
+uint8_t canardRxGetShardForFrame(const uint32_t extended_can_id, const uint8_t shard_count)
+{
+    // Requests and responses are mapped identically so the exact service transfer kind does not matter here.
+    CanardTransferKind kind    = CanardTransferKindMessage;
+    CanardPortID       port_id = (CanardPortID) ((extended_can_id >> OFFSET_SUBJECT_ID) & CANARD_SUBJECT_ID_MAX);
+    if ((extended_can_id & FLAG_SERVICE_NOT_MESSAGE) != 0U)
+    {
+        kind    = CanardTransferKindRequest;
+        port_id = (CanardPortID) ((extended_can_id >> OFFSET_SERVICE_ID) & CANARD_SERVICE_ID_MAX);
+    }
+    return canardRxGetShardForPort(kind, port_id, shard_count);
+}
+
+int8_t canardRxRingInit(CanardRxRing* const ring, CanardRxRingItem* const storage, const size_t capacity)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    // The capacity shall be a power of two so that the indexes can wrap around freely.
+    if ((ring != NULL) && (storage != NULL) && (capacity > 0U) && (0U == (capacity & (capacity - 1U))))
+    {
+        ring->storage  = storage;
+        ring->capacity = capacity;
+        ring->head     = 0U;
+        ring->tail     = 0U;
+        out            = 0;
+    }
+    return out;
+}
+
+int8_t canardRxRingPush(CanardRxRing* const           ring,
+                        const CanardRxTransfer* const transfer,
+                        CanardRxSubscription* const   subscription)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ring != NULL) && (transfer != NULL) && (ring->storage != NULL))
+    {
+        const size_t tail = ring->tail;  // Only the producer modifies the tail.
+        const size_t head = CANARD_ATOMIC_LOAD_ACQUIRE(&ring->head);
+        out               = 0;  // The ring is full.
+        if ((tail - head) < ring->capacity)
+        {
+            CanardRxRingItem* const item = &ring->storage[tail & (ring->capacity - 1U)];
+            item->transfer               = *transfer;
+            item->subscription           = subscription;
+            CANARD_ATOMIC_STORE_RELEASE(&ring->tail, tail + 1U);
+            out = 1;
+        }
+    }
+    return out;
+}
+
+int8_t canardRxRingPop(CanardRxRing* const          ring,
+                       CanardRxTransfer* const      out_transfer,
+                       CanardRxSubscription** const out_subscription)
+{
+    int8_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ring != NULL) && (out_transfer != NULL) && (ring->storage != NULL))
+    {
+        const size_t head = ring->head;  // Only the consumer modifies the head.
+        const size_t tail = CANARD_ATOMIC_LOAD_ACQUIRE(&ring->tail);
+        out               = 0;  // The ring is empty.
+        if (head != tail)
+        {
+            const CanardRxRingItem* const item = &ring->storage[head & (ring->capacity - 1U)];
+            *out_transfer                      = item->transfer;
+            if (out_subscription != NULL)
+            {
+                *out_subscription = item->subscription;
+            }
+            CANARD_ATOMIC_STORE_RELEASE(&ring->head, head + 1U);
+            out = 1;
+        }
     }
     return out;
 }
@@ -1244,3 +4752,210 @@ CanardFilter canardConsolidateFilters(const CanardFilter* a, const CanardFilter*
 
     return out;
 }
+
+/// Generates one filter per subscription into the buffer unless it is NULL. Returns the number of filters.
+/// Services are omitted if the local node is anonymous because it cannot receive them anyway.
+CANARD_PRIVATE size_t filterCollect(const CanardInstance* const ins, CanardFilter* const out_filters)
+{
+    CANARD_ASSERT(ins != NULL);
+    size_t out = 0U;
+    for (size_t tk = 0U; tk < CANARD_NUM_TRANSFER_KINDS; tk++)
+    {
+        const bool is_message = ((CanardTransferKind) tk) == CanardTransferKindMessage;
+        if (is_message || (ins->node_id <= CANARD_NODE_ID_MAX))
+        {
+            const CanardTreeNode* node = cavlFindExtremum(ins->rx_subscriptions[tk], false);
+            while (node != NULL)
+            {
+                if (out_filters != NULL)
+                {
+                    const CanardPortID port_id = ((const CanardRxSubscription*) node)->port_id;
+                    out_filters[out] = is_message ? canardMakeFilterForSubject(port_id)
+                                                  : canardMakeFilterForService(port_id, ins->node_id);
+                }
+                out++;
+                node = cavlNext(node);
+            }
+        }
+    }
+    return out;
+}
+
+/// The number of distinct extended CAN IDs admitted by a filter with the specified mask.
+CANARD_PRIVATE uint64_t filterAdmittedSpace(const uint32_t extended_mask)
+{
+    uint32_t x = extended_mask & CAN_EXT_ID_MASK;
+    x          = x - ((x >> 1U) & UINT32_C(0x55555555));
+    x          = (x & UINT32_C(0x33333333)) + ((x >> 2U) & UINT32_C(0x33333333));
+    x          = (x + (x >> 4U)) & UINT32_C(0x0F0F0F0F);
+    x          = (x * UINT32_C(0x01010101)) >> 24U;
+    return UINT64_C(1) << (29U - x);
+}
+
+/// The number of CAN IDs admitted by the consolidation of the two filters but by neither of them.
+CANARD_PRIVATE uint64_t filterConsolidationCost(const CanardFilter* const a, const CanardFilter* const b)
+{
+    CANARD_ASSERT((a != NULL) && (b != NULL));
+    const CanardFilter merged = canardConsolidateFilters(a, b);
+    const uint32_t     diff   = (a->extended_can_id ^ b->extended_can_id) & a->extended_mask & b->extended_mask;
+    const uint64_t     common = (0U == diff) ? filterAdmittedSpace(a->extended_mask | b->extended_mask) : 0U;
+    const uint64_t     sum    = filterAdmittedSpace(a->extended_mask) + filterAdmittedSpace(b->extended_mask);
+    const uint64_t     united = sum - common;
+    const uint64_t     total  = filterAdmittedSpace(merged.extended_mask);
+    CANARD_ASSERT(total >= united);
+    return total - united;
+}
+
+/// Agglomerative clustering: while there are more filters than allowed, replace the pair whose consolidation
+/// admits the fewest extra CAN IDs with their consolidation. Pairs whose consolidation admits nothing extra
+/// (duplicates, subsets, and complementary halves) are merged regardless of the limit.
+/// Returns the new number of filters.
+CANARD_PRIVATE size_t filterReduce(CanardFilter* const filters, const size_t count, const size_t max_filters)
+{
+    CANARD_ASSERT((filters != NULL) && (max_filters > 0U));
+    size_t out  = count;
+    bool   done = false;
+    while ((!done) && (out > 1U))
+    {
+        size_t   best_a    = 0U;
+        size_t   best_b    = 0U;
+        uint64_t best_cost = UINT64_MAX;
+        for (size_t a = 0U; a < out; a++)
+        {
+            for (size_t b = a + 1U; b < out; b++)
+            {
+                const uint64_t cost = filterConsolidationCost(&filters[a], &filters[b]);
+                if (cost < best_cost)
+                {
+                    best_a    = a;
+                    best_b    = b;
+                    best_cost = cost;
+                }
+            }
+        }
+        if ((out > max_filters) || (0U == best_cost))
+        {
+            filters[best_a] = canardConsolidateFilters(&filters[best_a], &filters[best_b]);
+            filters[best_b] = filters[out - 1U];
+            out--;
+        }
+        else
+        {
+            done = true;
+        }
+    }
+    return out;
+}
+
+int32_t canardComputeFilters(CanardInstance* const ins, CanardFilter* const out_filters, const size_t max_filters)
+{
+    int32_t out = -CANARD_ERROR_INVALID_ARGUMENT;
+    if ((ins != NULL) && (out_filters != NULL) && (max_filters > 0U))
+    {
+        const size_t count = filterCollect(ins, NULL);
+        if (count <= max_filters)
+        {
+            (void) filterCollect(ins, out_filters);
+            out = (int32_t) filterReduce(out_filters, count, max_filters);
+        }
+        else
+        {
+            CanardFilter* const scratch = (CanardFilter*) insAllocate(ins, count * sizeof(CanardFilter));
+            out                         = -CANARD_ERROR_OUT_OF_MEMORY;
+            if (scratch != NULL)
+            {
+                (void) filterCollect(ins, scratch);
+                const size_t reduced = filterReduce(scratch, count, max_filters);
+                CANARD_ASSERT(reduced <= max_filters);
+                // NOLINTNEXTLINE the safe functions like memcpy_s() are poorly supported; see txPayloadRead().
+                (void) memcpy(out_filters, scratch, reduced * sizeof(CanardFilter));
+                ins->memory_free(ins, scratch);
+                out = (int32_t) reduced;
+            }
+        }
+    }
+    return out;
+}
+
+// --------------------------------------------- MEMORY PLANNING ---------------------------------------------
+
+size_t canardTxQueueWorstCaseBytes(const size_t capacity, const size_t mtu_bytes)
+{
+    return capacity * txGetItemSize(adjustPresentationLayerMTU(mtu_bytes) + 1U);
+}
+
+size_t canardRxSubscriptionWorstCaseBytes(const size_t extent, const size_t max_sessions)
+{
+    return max_sessions * (sizeof(CanardInternalRxSession) + extent);
+}
+
+/// Adds the heap-allocated frames of the queue to the usage report. Pool-backed queues do not use the heap.
+CANARD_PRIVATE void txQueueMemoryUsage(const CanardTxQueue* const que, CanardMemoryUsage* const out)
+{
+    CANARD_ASSERT((que != NULL) && (out != NULL));
+    if (0U == que->pool.block_size)
+    {
+        // The bucket engine keeps the frames in per-priority lists linked via lr[1]; see txBucketInsert().
+        const bool   buckets      = (CanardTxQueueEngineBuckets == que->engine);
+        const size_t bucket_count = buckets ? (CANARD_PRIORITY_MAX + 1U) : 1U;
+        for (size_t i = 0U; i < bucket_count; i++)
+        {
+            const CanardTreeNode* node = buckets ? que->bucket_head[i] : cavlFindExtremum(que->root, false);
+            while (node != NULL)
+            {
+                out->tx_frames++;
+                out->total_bytes += txGetItemSize(txGetItemBufferSize((const CanardTxQueueItem*) node));
+                node = buckets ? node->lr[1] : cavlNext(node);
+            }
+        }
+    }
+}
+
+CanardMemoryUsage canardInstanceMemoryUsage(const CanardInstance* const       ins,
+                                            const CanardTxQueue* const* const ques,
+                                            const size_t                      que_count)
+{
+    CanardMemoryUsage out = {0U, 0U, 0U, 0U, 0U};
+    bool              valid = (ins != NULL) && ((ques != NULL) || (0U == que_count));
+    for (size_t i = 0U; valid && (i < que_count); i++)
+    {
+        valid = (ques[i] != NULL);
+    }
+    if (valid)
+    {
+        // The pooled sessions are linked into the same list as the heap-allocated ones.
+        const bool                     heap_sessions = (NULL == ins->rx_session_pool);
+        const CanardInternalRxSession* rxs           = ins->rx_sessions_oldest;
+        while (rxs != NULL)
+        {
+            if (heap_sessions)
+            {
+                out.rx_sessions++;
+                out.total_bytes += sizeof(CanardInternalRxSession);
+            }
+            if ((rxs->payload != NULL) && (0U == rxs->subscription->payload_pool.block_size))
+            {
+                out.rx_payload_buffers++;
+                out.total_bytes += rxs->subscription->extent;
+            }
+            rxs = rxs->newer;
+        }
+        if (ins->rx_lookup != NULL)
+        {
+            const size_t page_count = sizeof(ins->rx_lookup->subject_pages) / sizeof(ins->rx_lookup->subject_pages[0]);
+            for (size_t i = 0U; i < page_count; i++)
+            {
+                if (ins->rx_lookup->subject_pages[i] != NULL)
+                {
+                    out.rx_lookup_pages++;
+                    out.total_bytes += sizeof(RxLookupPage);
+                }
+            }
+        }
+        for (size_t i = 0U; i < que_count; i++)
+        {
+            txQueueMemoryUsage(ques[i], &out);
+        }
+    }
+    return out;
+}
@@ -51,10 +51,13 @@
 /// constructing a new TX queue, of which there should be as many as there are redundant CAN interfaces;
 /// each queue is managed independently. When the application needs to emit a transfer, it invokes canardTxPush()
 /// on each queue separately. The function splits the transfer into CAN frames and stores them into the queue.
+/// Alternatively, canardTxPushRedundant() can be used to serialize the transfer once for all redundant queues.
 /// The application then picks the produced CAN frames from the queue one-by-one by calling canardTxPeek() followed
 /// by canardTxPop() -- the former allows the application to look at the next frame scheduled for transmission,
 /// and the latter tells the library that the frame shall be removed from the queue.
 /// Popped frames need to be manually deallocated by the application upon transmission.
+/// Media drivers that can accept frames into their own buffers may use canardTxPushDirect() instead, which bypasses
+/// the queue for as long as the hardware has room for more frames.
 ///
 /// The RX pipeline is managed with the help of three API functions; unlike the TX pipeline, there is one shared
 /// state for all redundant interfaces that manages deduplication transparently. The main function canardRxAccept()
@@ -95,7 +98,7 @@ extern "C" {
 /// Semantic version of this library (not the UAVCAN specification).
 /// API will be backward compatible within the same major version.
 #define CANARD_VERSION_MAJOR 2
-#define CANARD_VERSION_MINOR 0
+#define CANARD_VERSION_MINOR 1
 
 /// The version number of the UAVCAN specification implemented by this library.
 #define CANARD_UAVCAN_SPECIFICATION_VERSION_MAJOR 1
@@ -115,6 +118,10 @@ extern "C" {
 #define CANARD_MTU_CAN_CLASSIC 8U
 #define CANARD_MTU_CAN_FD 64U
 
+/// The maximum number of non-adjacent memory segments a TX frame payload may consist of.
+/// See canardTxGetFrameSegments().
+#define CANARD_TX_FRAME_SEGMENTS_MAX 2U
+
 /// Parameter ranges are inclusive; the lower bound is zero for all. See UAVCAN/CAN Specification for background.
 #define CANARD_SUBJECT_ID_MAX 8191U
 #define CANARD_SERVICE_ID_MAX 511U
@@ -127,6 +134,59 @@ extern "C" {
 /// Library functions treat all values above CANARD_NODE_ID_MAX as anonymous.
 #define CANARD_NODE_ID_UNSET 255U
 
+/// If nonzero, the per-node session table is omitted from CanardRxSubscription, which reduces its size from
+/// (CANARD_NODE_ID_MAX + 1) pointers plus a few fields to just a few fields; the RX sessions are then kept exclusively
+/// in the session pool, which becomes mandatory for reception (see canardRxSetSessionPool()).
+/// This option affects the layout of public types, so it shall be defined identically for the library and for all
+/// translation units that include this header, e.g., via the compiler command line.
+#ifndef CANARD_RX_COMPACT_SUBSCRIPTIONS
+#    define CANARD_RX_COMPACT_SUBSCRIPTIONS 0
+#endif
+
+/// The number of redundant transports, counting from index zero, for which the library instance keeps the liveness
+/// information and the statistics; see CanardInstance.rx_failover_timeout_usec. Frames from the transports with
+/// greater indexes are processed normally but they are not tracked.
+#ifndef CANARD_RX_REDUNDANT_TRANSPORTS_MAX
+#    define CANARD_RX_REDUNDANT_TRANSPORTS_MAX 3U
+#endif
+
+/// If nonzero, the library maintains the statistics counters in CanardInstance, CanardRxSubscription, and
+/// CanardTxQueue, and reports the events that explain lost transfers via the optional trace hook of the instance
+/// (see CanardTraceHook). If zero (this is the default), the counters and the hook are omitted from the public types
+/// entirely, so there is no overhead whatsoever. The counters are updated in constant time.
+/// This option affects the layout of public types, so it shall be defined identically for the library and for all
+/// translation units that include this header, e.g., via the compiler command line.
+#ifndef CANARD_STATS
+#    define CANARD_STATS 0
+#endif
+
+/// If nonzero, the library is specialized at compile time for a single transport MTU, which shall be either
+/// CANARD_MTU_CAN_CLASSIC or CANARD_MTU_CAN_FD. The frame size arithmetic is then folded by the compiler,
+/// the TX queue items have fixed-size payload storage, and CanardTxQueue.mtu_bytes is ignored. In the Classic CAN
+/// specialization, the DLC rounding and padding code paths are eliminated entirely. Received frames longer than the
+/// fixed MTU are treated as malformed. The TX frames do not reference shared payloads (see canardTxPushShared()),
+/// they are always materialized eagerly. If zero (this is the default), any MTU is supported at run time.
+/// This option changes the sizes of the TX memory allocations, so it shall be defined identically for the library and
+/// for all translation units that include this header, e.g., via the compiler command line.
+#ifndef CANARD_FIXED_MTU
+#    define CANARD_FIXED_MTU 0U
+#endif
+#if (CANARD_FIXED_MTU != 0) && (CANARD_FIXED_MTU != CANARD_MTU_CAN_CLASSIC) && (CANARD_FIXED_MTU != CANARD_MTU_CAN_FD)
+#    error "Invalid CANARD_FIXED_MTU: the valid values are 0, CANARD_MTU_CAN_CLASSIC, and CANARD_MTU_CAN_FD."
+#endif
+
+/// If nonzero (this is the default), the TX queues maintain a secondary index of the enqueued frames ordered by their
+/// transmission deadline, so that canardTxPurgeExpired() visits only the expired frames. The index costs one tree node
+/// and an owner pointer in every CanardTxQueueItem (see CanardTxDeadlineNode), that is, typically 20 bytes per frame
+/// on a 32-bit platform and 40 bytes on a 64-bit platform, plus the insertion into the index on every push of a frame
+/// whose deadline is nonzero.
+/// If zero, the index is omitted and canardTxPurgeExpired() scans the entire queue instead.
+/// This option affects the layout of public types, so it shall be defined identically for the library and for all
+/// translation units that include this header, e.g., via the compiler command line.
+#ifndef CANARD_TX_DEADLINE_INDEX
+#    define CANARD_TX_DEADLINE_INDEX 1
+#endif
+
 /// This is the recommended transfer-ID timeout value given in the UAVCAN Specification. The application may choose
 /// different values per subscription (i.e., per data specifier) depending on its timing requirements.
 #define CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC 2000000UL
@@ -234,10 +294,96 @@ typedef struct
     CanardTransferID transfer_id;
 } CanardTransferMetadata;
 
+/// The events reported via CanardTraceHook. Each RX event also increments the counter of the same name in
+/// CanardRxStats of the instance and of the affected subscription.
+typedef enum
+{
+    /// A frame was dropped because its transfer has already been received (e.g., via another redundant transport)
+    /// or because its session is locked on another redundant transport.
+    CanardTraceEventRxDuplicate = 0,
+    /// A frame was dropped because its toggle bit is wrong: a frame of the transfer has been lost or duplicated.
+    CanardTraceEventRxToggleError = 1,
+    /// A frame was dropped because the first frame of its transfer has not been received.
+    CanardTraceEventRxSOTMiss = 2,
+    /// A multi-frame transfer was dropped because its CRC is wrong.
+    CanardTraceEventRxCRCError = 3,
+    /// A transfer was accepted but its payload was truncated to the extent of the subscription.
+    CanardTraceEventRxTruncation = 4,
+    /// A transfer was dropped because a session or a payload buffer could not be allocated.
+    CanardTraceEventRxOutOfMemory = 5,
+    /// A frame was dropped because it is not a valid UAVCAN/CAN frame. The metadata is not reported.
+    CanardTraceEventRxMalformed = 6,
+    /// A transfer could not be enqueued because the queue is full or the memory is exhausted.
+    /// The metadata is not reported if the transfer was pushed using canardTxPushMany().
+    CanardTraceEventTxOutOfMemory = 7,
+    /// A frame was removed by canardTxPurgeExpired(). The metadata is not reported.
+    CanardTraceEventTxExpired = 8,
+} CanardTraceEvent;
+
+/// The optional trace hook is invoked synchronously from the API function that encountered the event.
+/// The metadata of the affected transfer is provided where available, otherwise it is NULL; the pointer is only valid
+/// until the hook returns. The hook shall not invoke the library API.
+typedef void (*CanardTraceHook)(CanardInstance* ins, CanardTraceEvent event, const CanardTransferMetadata* metadata);
+
+/// The RX statistics counters; see CANARD_STATS. The counters wrap around on overflow and may be reset by the user.
+typedef struct CanardRxStats
+{
+    uint32_t frames_accepted;  ///< Frames that have been used for transfer reassembly.
+    uint32_t transfers;        ///< Transfers delivered to the application, including the truncated ones.
+    uint32_t duplicates;       ///< See CanardTraceEventRxDuplicate.
+    uint32_t toggle_errors;    ///< See CanardTraceEventRxToggleError.
+    uint32_t sot_misses;       ///< See CanardTraceEventRxSOTMiss.
+    uint32_t crc_errors;       ///< See CanardTraceEventRxCRCError.
+    uint32_t truncations;      ///< See CanardTraceEventRxTruncation.
+    uint32_t oom_errors;       ///< See CanardTraceEventRxOutOfMemory.
+} CanardRxStats;
+
+/// The TX statistics counters; see CANARD_STATS. The counters wrap around on overflow and may be reset by the user.
+typedef struct CanardTxStats
+{
+    uint32_t transfers;       ///< Transfers enqueued.
+    uint32_t frames;          ///< Frames enqueued.
+    uint32_t oom_errors;      ///< See CanardTraceEventTxOutOfMemory.
+    uint32_t frames_expired;  ///< See CanardTraceEventTxExpired.
+    size_t   peak_size;       ///< The maximum number of frames that have been in the queue at once.
+} CanardTxStats;
+
+/// A contiguous piece of a transfer payload that is scattered across several non-adjacent memory regions.
+/// See canardTxPushV(). The data pointer may be NULL only if the size is zero.
+typedef struct CanardPayloadFragment
+{
+    size_t      size;
+    const void* data;
+} CanardPayloadFragment;
+
+/// A fixed-size block storage carved out of a memory region supplied by the application.
+/// Blocks are taken from and returned to an intrusive free list in constant time without involving the memory
+/// manager of the library instance. The application is not expected to access the fields directly.
+typedef struct CanardPool
+{
+    struct CanardInternalPoolBlock* free_list;   ///< Read-only DO NOT MODIFY THIS
+    size_t                          block_size;  ///< Zero if the pool is not used. Read-only DO NOT MODIFY THIS
+    size_t                          capacity;    ///< The total number of blocks. Read-only DO NOT MODIFY THIS
+    size_t                          used;        ///< The number of blocks in use. Read-only DO NOT MODIFY THIS
+} CanardPool;
+
+/// The data structure that keeps the frames of a transmission queue ordered; see CanardTxQueue.
+typedef enum
+{
+    /// AVL tree ordered by CAN ID. All operations are O(log n). This is the default.
+    CanardTxQueueEngineTree = 0,
+    /// One FIFO list per priority level plus a bitmap of non-empty levels. Peek and pop are O(1); push is O(1) as long
+    /// as the frames within the same priority level are pushed in the order of non-decreasing CAN ID (which is the
+    /// case for most applications), otherwise it degrades to O(n) of the number of frames at that priority level.
+    CanardTxQueueEngineBuckets = 1,
+} CanardTxQueueEngine;
+
 /// Prioritized transmission queue that keeps CAN frames destined for transmission via one CAN interface.
 /// Applications with redundant interfaces are expected to have one instance of this type per interface.
 /// Applications that are not interested in transmission may have zero queues.
-/// All operations (push, peek, pop) are O(log n); there is exactly one heap allocation per element.
+/// All operations (push, peek, pop) are O(log n), or O(1) if the bucket engine is selected (see CanardTxQueueEngine);
+/// there is exactly one heap allocation per element unless the queue is backed by a fixed-size frame pool
+/// (see canardTxInitWithPool()), in which case the heap is not used at all.
 /// API functions that work with this type are named "canardTx*()", find them below.
 typedef struct CanardTxQueue
 {
@@ -246,6 +392,18 @@ typedef struct CanardTxQueue
     /// The purpose of this limitation is to ensure that a blocked queue does not exhaust the heap memory.
     size_t capacity;
 
+    /// The number of frames out of the capacity that are reserved for each priority level (indexed by CanardPriority);
+    /// all zero by default. A push at priority P succeeds only if the frames exceeding the reservations of their
+    /// levels, including the new ones, fit into the unreserved part of the capacity. Thus, a low-priority bulk
+    /// transfer cannot consume the capacity reserved for the control loops. If the sum of the reservations exceeds the
+    /// capacity, there is no shared part: only the frames that fit into the reservations of their levels are accepted,
+    /// and the total capacity limit still applies.
+    /// This value can be changed by the user at any moment; the change affects only subsequent pushes.
+    size_t reserved[CANARD_PRIORITY_MAX + 1U];
+
+    /// The number of frames that are currently contained in the queue per priority level. Read-only DO NOT MODIFY THIS
+    size_t size_by_priority[CANARD_PRIORITY_MAX + 1U];
+
     /// The transport-layer maximum transmission unit (MTU). The value can be changed arbitrarily at any time between
     /// pushes. It defines the maximum number of data bytes per CAN data frame in outgoing transfers via this queue.
     ///
@@ -254,6 +412,7 @@ typedef struct CanardTxQueue
     ///
     /// Valid values are any valid CAN frame data length value not smaller than 8.
     /// Invalid values are treated as the nearest valid value. The default is the maximum valid value.
+    /// This field is ignored if the library is built with a nonzero CANARD_FIXED_MTU.
     size_t mtu_bytes;
 
     /// The number of frames that are currently contained in the queue, initially zero.
@@ -261,34 +420,144 @@ typedef struct CanardTxQueue
     size_t size;
 
     /// The root of the priority queue is NULL if the queue is empty. Do not modify this field!
+    /// If the bucket engine is used, this is the top element of the queue (the next frame to transmit) instead.
     CanardTreeNode* root;
 
+#if CANARD_TX_DEADLINE_INDEX
+    /// The root of the secondary index that orders the enqueued frames by their transmission deadline.
+    /// Frames whose deadline is zero are not indexed. Do not modify this field! See CANARD_TX_DEADLINE_INDEX.
+    CanardTreeNode* deadline_root;
+#endif
+
+    /// The data structure used to order the queued frames; the default is CanardTxQueueEngineTree.
+    /// The value can be changed by the user only while the queue is empty.
+    CanardTxQueueEngine engine;
+
+    /// The state of the bucket engine; unused by the tree engine. Read-only DO NOT MODIFY THIS
+    CanardTreeNode* bucket_head[CANARD_PRIORITY_MAX + 1U];
+    CanardTreeNode* bucket_tail[CANARD_PRIORITY_MAX + 1U];
+    uint8_t         bucket_mask;  ///< Bit N is set if bucket N is non-empty.
+
+    /// The state of the tree engine; unused by the bucket engine. Read-only DO NOT MODIFY THIS
+    /// This is the leftmost node of the tree (the next frame to transmit) cached to make peeking O(1).
+    CanardTreeNode* tree_top;
+
+    /// If the queue was constructed using canardTxInitWithPool(), its frames are stored in this pool instead of the
+    /// dynamic memory of the library instance. Otherwise, the pool is unused (its block size is zero).
+    /// Read-only DO NOT MODIFY THIS
+    CanardPool pool;
+
+    /// The traffic shapers of this queue; see canardTxShape(). Read-only DO NOT MODIFY THIS
+    struct CanardTxShaper* shapers;
+
+#if CANARD_STATS
+    /// The statistics of this queue; see CANARD_STATS.
+    CanardTxStats stats;
+#endif
+
     /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
     /// Its purpose is to simplify integration with OOP interfaces.
     void* user_reference;
 } CanardTxQueue;
 
+/// A token bucket that limits the transmission rate of one port of a transmission queue; see canardTxShape().
+/// The bucket holds up to burst_bytes of credit and is refilled continuously at rate_bytes_per_second; a frame can
+/// be transmitted when the credit covers its data length (the payload_size of the CAN frame, including the tail byte
+/// and padding), or when the bucket is full, so that a frame larger than the burst can pass. Popping a frame
+/// deducts its length from the credit, which may become negative if the frame was not obtained via
+/// canardTxPeekShaped(). The application is expected to allocate shapers statically.
+/// SHAPER INSTANCES SHALL NOT BE MOVED WHILE IN USE.
+typedef struct CanardTxShaper
+{
+    CanardTransferKind transfer_kind;  ///< Read-only DO NOT MODIFY THIS
+    CanardPortID       port_id;        ///< Read-only DO NOT MODIFY THIS
+
+    /// The long-term rate limit and the maximum burst. The user can change these at any moment.
+    uint32_t rate_bytes_per_second;
+    uint32_t burst_bytes;
+
+    /// The credit is measured in millionths of a byte to avoid rounding; it is brought up to date at the timestamp
+    /// by canardTxPeekShaped(). Read-only DO NOT MODIFY THIS
+    int64_t           credit;
+    CanardMicrosecond credit_timestamp_usec;
+    bool              blocked;  ///< Used by canardTxPeekShaped() only. Read-only DO NOT MODIFY THIS
+
+    /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
+    void* user_reference;
+
+    struct CanardTxShaper* next;  ///< Read-only DO NOT MODIFY THIS
+} CanardTxShaper;
+
+/// The node of the deadline index of the transmission queue; see canardTxPurgeExpired().
+/// The user code is not expected to interact with this type.
+typedef struct CanardTxDeadlineNode
+{
+    CanardTreeNode     base;
+    CanardTxQueueItem* owner;
+} CanardTxDeadlineNode;
+
 /// One frame stored in the transmission queue along with its metadata.
 struct CanardTxQueueItem
 {
     /// Internal use only; do not access this field.
     CanardTreeNode base;
 
+#if CANARD_TX_DEADLINE_INDEX
+    /// Internal use only; do not access this field. See CANARD_TX_DEADLINE_INDEX.
+    CanardTxDeadlineNode deadline;
+#endif
+
     /// Points to the next frame in this transfer or NULL. This field is mostly intended for own needs of the library.
     /// Normally, the application would not use it because transfer frame ordering is orthogonal to global TX ordering.
     /// It can be useful though for pulling pending frames from the TX queue if at least one frame of their transfer
     /// failed to transmit; the idea is that if at least one frame is missing, the transfer will not be received by
-    /// remote nodes anyway, so all its remaining frames can be dropped from the queue at once using canardTxPop().
+    /// remote nodes anyway, so all its remaining frames can be dropped from the queue at once using
+    /// canardTxDropTransfer().
     CanardTxQueueItem* next_in_transfer;
 
     /// This is the same value that is passed to canardTxPush().
-    /// Frames whose transmission deadline is in the past shall be dropped.
+    /// Frames whose transmission deadline is in the past shall be dropped; see also canardTxPurgeExpired().
+    /// The value shall not be modified while the frame is enqueued.
     CanardMicrosecond tx_deadline_usec;
 
-    /// The actual CAN frame data.
+    /// The actual CAN frame data. The payload pointer is NULL for lazily materialized frames.
     CanardFrame frame;
 };
 
+/// A piece of a transfer delivered to the stream handler of a subscription; see CanardRxStreamHandler.
+typedef struct CanardRxChunk
+{
+    /// The metadata of the transfer the chunk belongs to; it is the same for all chunks of the transfer.
+    CanardTransferMetadata metadata;
+
+    /// The timestamp of the first received CAN frame of this transfer.
+    CanardMicrosecond timestamp_usec;
+
+    /// The position of the chunk in the transfer payload and the payload data. The chunks of a transfer are delivered
+    /// in order without gaps, so the offset of the next chunk is offset+size. A chunk at offset zero begins a new
+    /// transfer: the previous transfer from the same remote node, if it is not concluded, has been abandoned.
+    /// The data is valid only until the handler returns; the size may be zero.
+    size_t      offset;
+    size_t      size;
+    const void* data;
+
+    /// The transfer CRC computed over all frames of the transfer received so far, including the trailing bytes that
+    /// are held back because they may be the CRC; the application can use it to check the integrity of its storage.
+    uint16_t crc;
+
+    /// True if this is the last chunk of the transfer. If so, the valid flag indicates whether the transfer CRC
+    /// is correct; if it is not, the application shall discard all chunks of the transfer.
+    bool end_of_transfer;
+    bool valid;
+} CanardRxChunk;
+
+typedef struct CanardRxSubscription CanardRxSubscription;
+
+/// The handler of the transfer chunks received on a subscription in the streaming mode; see CanardRxSubscription.
+typedef void (*CanardRxStreamHandler)(CanardInstance* const       ins,
+                                      CanardRxSubscription* const subscription,
+                                      const CanardRxChunk* const  chunk);
+
 /// Transfer subscription state. The application can register its interest in a particular kind of data exchanged
 /// over the bus by creating such subscription objects. Frames that carry data for which there is no active
 /// subscription will be silently dropped by the library. The entire RX pipeline is invariant to the number of
@@ -298,7 +567,7 @@ struct CanardTxQueueItem
 ///
 /// The memory footprint of a subscription is large. On a 32-bit platform it slightly exceeds half a KiB.
 /// This is an intentional time-memory trade-off: use a large look-up table to ensure predictable temporal properties.
-typedef struct CanardRxSubscription
+struct CanardRxSubscription
 {
     CanardTreeNode base;  ///< Read-only DO NOT MODIFY THIS
 
@@ -306,6 +575,36 @@ typedef struct CanardRxSubscription
     size_t            extent;   ///< Read-only DO NOT MODIFY THIS
     CanardPortID      port_id;  ///< Read-only DO NOT MODIFY THIS
 
+    /// If true, the single-frame transfers received on this subscription are delivered without allocating memory
+    /// and without copying the payload: the payload of the transfer references the payload of the accepted frame
+    /// (see CanardRxTransfer.payload_borrowed). Multi-frame transfers are not affected.
+    /// This field is false by default; the user can change it at any time.
+    bool borrow_single_frame;
+
+    /// The optional storage of the payload buffers of this subscription; see canardRxSetPayloadPool().
+    /// Read-only DO NOT MODIFY THIS
+    CanardPool payload_pool;
+
+    /// The handlers invoked on transfer completion; see canardRxAddListener(). Read-only DO NOT MODIFY THIS
+    struct CanardRxListener* listeners;
+
+    /// If not NULL, the subscription operates in the streaming mode: the payload of each accepted frame is delivered
+    /// to this handler as soon as it arrives (see CanardRxChunk), and no payload buffers are allocated, so the extent
+    /// only limits the amount of data delivered per transfer and can be arbitrarily large at no memory cost.
+    /// The transfers are then never returned by canardRxAccept() and the listeners are not invoked; the last chunk
+    /// reports whether the transfer CRC is valid. Since the CRC is verified only at the end, the application shall
+    /// not commit the data irreversibly until the last chunk is validated (e.g., write a firmware image into
+    /// a staging area of the flash memory, then activate it). This allows receiving very large transfers, such as
+    /// file reads, from many nodes concurrently without buffering them.
+    /// This field is NULL by default; the user can change it after canardRxSubscribe() while no transfers are being
+    /// received on the subscription.
+    CanardRxStreamHandler stream_handler;
+
+#if CANARD_STATS
+    /// The statistics of this subscription; see CANARD_STATS. Reset by canardRxSubscribe().
+    CanardRxStats stats;
+#endif
+
     /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
     /// Its purpose is to simplify integration with OOP interfaces.
     void* user_reference;
@@ -320,8 +619,81 @@ typedef struct CanardRxSubscription
     /// just pointers, but it would push the size of this instance from about 0.5 KiB to ~3 KiB for a typical 32-bit
     /// system. Since this is a general-purpose library, we have to pick a middle ground so we use the more complex
     /// but more memory-efficient approach.
+    ///
+    /// If the session pool is used (see canardRxSetSessionPool()), this table is not used and remains NULL-filled;
+    /// it is omitted entirely if CANARD_RX_COMPACT_SUBSCRIPTIONS is nonzero.
+#if !CANARD_RX_COMPACT_SUBSCRIPTIONS
     struct CanardInternalRxSession* sessions[CANARD_NODE_ID_MAX + 1U];  ///< Read-only DO NOT MODIFY THIS
-} CanardRxSubscription;
+#endif
+};
+
+/// A per-instance pool of RX sessions for applications that subscribe to many ports, each of which is published by
+/// few nodes. The sessions are stored in fixed-size blocks carved from the memory supplied by the application,
+/// and they are indexed by an open-addressed hash table keyed by the transfer kind, the port-ID, and the source
+/// node-ID, so the memory consumption scales with the number of active sessions rather than with the number of
+/// subscriptions, and there is no per-session heap allocation. The payload buffers are still allocated from the heap.
+///
+/// When a new session is needed while the pool is exhausted, the least recently used session is evicted, which
+/// aborts its transfer in progress, if any, and deallocates its payload buffer. The time complexity of all pool
+/// operations is constant (on average for the hash index, whose load factor does not exceed 3/4).
+/// The user code is not expected to interact with the fields except for reading the statistics.
+typedef struct CanardRxSessionPool
+{
+    CanardPool                           blocks;      ///< The session storage. Read-only DO NOT MODIFY THIS
+    struct CanardInternalRxPoolSession** index;       ///< Read-only DO NOT MODIFY THIS
+    size_t                               index_size;  ///< A power of two. Read-only DO NOT MODIFY THIS
+    struct CanardInternalRxPoolSession*  lru_head;    ///< The most recently used session. Read-only
+    struct CanardInternalRxPoolSession*  lru_tail;    ///< The least recently used session. Read-only
+
+    /// The number of sessions evicted to make room for new ones. This field may be reset by the user.
+    size_t evictions;
+} CanardRxSessionPool;
+
+/// The number of subject-IDs per page of the subject lookup table; see CanardRxLookup.
+#define CANARD_RX_LOOKUP_PAGE_SIZE 32U
+
+/// An optional index of the RX subscriptions that makes the subscription search in canardRxAccept() constant-time
+/// instead of logarithmic; see canardRxSetLookup(). The subscriptions remain in the trees of the library instance
+/// as well, the index is maintained alongside.
+///
+/// Services are indexed by a directly addressed table. Subjects are indexed by a two-level radix table whose pages of
+/// CANARD_RX_LOOKUP_PAGE_SIZE entries are allocated from the memory manager of the library instance on demand, when
+/// the first subscription to a subject belonging to the page is created, and deallocated when the last one is removed.
+/// The size of this object is about (1024 + 256) pointers; each page takes (CANARD_RX_LOOKUP_PAGE_SIZE + 1) pointers.
+/// The application is expected to allocate this object statically; the reference shall remain valid while in use.
+typedef struct CanardRxLookup
+{
+    /// Indexed by service-ID; the first row is for responses, the second one is for requests.
+    CanardRxSubscription* services[CANARD_NUM_TRANSFER_KINDS - 1U][CANARD_SERVICE_ID_MAX + 1U];  ///< Read-only
+
+    /// Indexed by subject-ID divided by the page size; a page is NULL if there are no subscriptions in its range.
+    struct CanardInternalRxLookupPage*
+        subject_pages[(CANARD_SUBJECT_ID_MAX + 1U) / CANARD_RX_LOOKUP_PAGE_SIZE];  ///< Read-only
+} CanardRxLookup;
+
+/// An optional compact index of the RX subscriptions for hosts and gateways with many subscriptions where the
+/// memory of CanardRxLookup is not justified; see canardRxSetIndex(). The subscriptions remain in the trees of the
+/// library instance as well, the index is maintained alongside. If both the index and the lookup table are enabled,
+/// the lookup table is used for the search.
+///
+/// The search keys (the transfer kind and the port-ID) of all subscriptions are stored in one contiguous array sorted
+/// in the ascending order, separately from the subscription references, so the binary search in canardRxAccept()
+/// touches only a few cache lines of keys (16 keys per 64-byte line) and dereferences only the matching subscription,
+/// whereas the tree search visits a subscription object at each level. The order of the entries is stable: it depends
+/// only on the set of subscriptions, not on the order of subscription. The search is logarithmic, the insertion and
+/// removal are linear of the number of subscriptions.
+///
+/// For the most cache-friendly RX dispatch, combine the index with CANARD_RX_COMPACT_SUBSCRIPTIONS and the session
+/// pool (see canardRxSetSessionPool()): the subscription objects then hold only the hot fields, and the sessions are
+/// stored separately and only for the remote nodes that actually publish.
+/// The user code is not expected to interact with the fields except for reading the size.
+typedef struct CanardRxIndex
+{
+    uint32_t*              keys;           ///< Ascending. Read-only DO NOT MODIFY THIS
+    CanardRxSubscription** subscriptions;  ///< Parallel to the keys. Read-only DO NOT MODIFY THIS
+    size_t                 capacity;       ///< The maximum number of subscriptions. Read-only DO NOT MODIFY THIS
+    size_t                 size;           ///< The number of subscriptions. Read-only DO NOT MODIFY THIS
+} CanardRxIndex;
 
 /// Reassembled incoming transfer returned by canardRxAccept().
 typedef struct CanardRxTransfer
@@ -333,11 +705,66 @@ typedef struct CanardRxTransfer
     CanardMicrosecond timestamp_usec;
 
     /// If the payload is empty (payload_size = 0), the payload pointer may be NULL.
-    /// The application is required to deallocate the payload buffer after the transfer is processed.
+    /// The application is required to deallocate the payload buffer after the transfer is processed,
+    /// unless the payload is borrowed (see below). If the subscription has a payload pool, the buffer shall be
+    /// returned to it using canardRxReleasePayload() instead; this function can also be used in the other cases.
     size_t payload_size;
     void*  payload;
+
+    /// If true, the payload is not a dynamically allocated buffer but a view into the payload of the CAN frame that
+    /// was passed to canardRxAccept(); this is only possible for single-frame transfers on subscriptions where
+    /// borrow_single_frame is set. A borrowed payload shall neither be deallocated nor modified by the application,
+    /// and it remains valid only as long as the frame payload buffer supplied by the application remains valid;
+    /// typically, the application should process the transfer before reading the next frame from the CAN driver.
+    bool payload_borrowed;
 } CanardRxTransfer;
 
+typedef struct CanardRxListener CanardRxListener;
+
+/// The handler is invoked by the library when a transfer is received on the subscription the listener is attached to;
+/// see canardRxAddListener(). The transfer object and its payload are valid until the handler returns.
+/// If the handler returns true, it retains the payload: the ownership of the buffer is passed to the application,
+/// which shall release it afterwards as described in CanardRxTransfer, and the remaining listeners are not invoked.
+/// If the handler returns false, the next listener is invoked with the same transfer, and if there are none left,
+/// the library releases the payload. A handler shall not deallocate or modify the payload unless it retains it.
+typedef bool (*CanardRxHandler)(CanardInstance* const       ins,
+                                CanardRxListener* const     listener,
+                                CanardRxSubscription* const subscription,
+                                CanardRxTransfer* const     transfer);
+
+/// A receiver of the transfers of a subscription. The application is expected to allocate listeners statically;
+/// a listener can be attached to at most one subscription at a time.
+/// LISTENER INSTANCES SHALL NOT BE MOVED WHILE IN USE.
+struct CanardRxListener
+{
+    CanardRxHandler handler;
+
+    /// This field can be arbitrarily mutated by the user. It is never accessed by the library.
+    void* user_reference;
+
+    struct CanardRxListener* next;  ///< Read-only DO NOT MODIFY THIS
+};
+
+/// An entry of CanardRxRing.
+typedef struct CanardRxRingItem
+{
+    CanardRxTransfer      transfer;
+    CanardRxSubscription* subscription;
+} CanardRxRingItem;
+
+/// A bounded single-producer single-consumer lock-free ring of received transfers that hands them off from the thread
+/// that drives a library instance to the thread that consumes them; see canardRxRingPush() and canardRxRingPop().
+/// The storage of the entries is supplied by the application; its size shall be a power of two.
+/// The indexes are accessed using CANARD_ATOMIC_LOAD_ACQUIRE() and CANARD_ATOMIC_STORE_RELEASE() (see canard.c).
+/// The user code is not expected to interact with the fields directly.
+typedef struct CanardRxRing
+{
+    CanardRxRingItem* storage;   ///< Read-only DO NOT MODIFY THIS
+    size_t            capacity;  ///< A power of two. Read-only DO NOT MODIFY THIS
+    size_t            head;      ///< Modified by the consumer only. Read-only DO NOT MODIFY THIS
+    size_t            tail;      ///< Modified by the producer only. Read-only DO NOT MODIFY THIS
+} CanardRxRing;
+
 /// A pointer to the memory allocation function. The semantics are similar to malloc():
 ///     - The returned pointer shall point to an uninitialized block of memory that is at least "amount" bytes large.
 ///     - If there is not enough memory, the returned pointer shall be NULL.
@@ -373,14 +800,65 @@ struct CanardInstance
     /// The time complexity models given in the API documentation are made on the assumption that the memory management
     /// functions have constant complexity O(1).
     ///
-    /// The following API functions may allocate memory:   canardRxAccept(), canardTxPush().
-    /// The following API functions may deallocate memory: canardRxAccept(), canardRxSubscribe(), canardRxUnsubscribe().
+    /// The following API functions may allocate memory:   canardRxAccept(), canardRxAcceptMany(), canardRxSubscribe(),
+    /// canardTxPush(), canardTxPushV(), canardTxPushMany(), canardTxPushShared(), canardTxPushRedundant(),
+    /// canardTxPushRedundantShared(), canardTxPushDirect(), canardTxAllocatePayload(), canardComputeFilters().
+    /// The following API functions may deallocate memory: canardRxAccept(), canardRxAcceptMany(), canardRxSubscribe(),
+    /// canardRxUnsubscribe(), canardRxCleanup(), canardRxReleasePayload(), canardTxPushMany(), canardTxPushRedundant(),
+    /// canardTxPushRedundantShared(), canardTxPurgeExpired(), canardTxDropTransfer(), canardTxFree(),
+    /// canardTxReleasePayload(), canardComputeFilters().
     /// The exact memory requirement and usage model is specified for each function in its documentation.
     CanardMemoryAllocate memory_allocate;
     CanardMemoryFree     memory_free;
 
     /// Read-only DO NOT MODIFY THIS
     CanardTreeNode* rx_subscriptions[CANARD_NUM_TRANSFER_KINDS];
+
+    /// The optional constant-time subscription index; NULL unless set via canardRxSetLookup().
+    /// Read-only DO NOT MODIFY THIS
+    CanardRxLookup* rx_lookup;
+
+    /// The optional sorted subscription index; NULL unless set via canardRxSetIndex(). Read-only DO NOT MODIFY THIS
+    CanardRxIndex* rx_index;
+
+    /// The optional RX session pool; NULL unless set via canardRxSetSessionPool(). Read-only DO NOT MODIFY THIS
+    CanardRxSessionPool* rx_session_pool;
+
+    /// All RX sessions of this instance linked in the order of their last start-of-transfer; see canardRxCleanup().
+    /// Read-only DO NOT MODIFY THIS
+    struct CanardInternalRxSession* rx_sessions_oldest;
+    struct CanardInternalRxSession* rx_sessions_newest;
+
+    /// An RX session is locked on the redundant transport that delivered the first frame of its transfer, and the
+    /// frames from the other transports are dropped cheaply before any payload processing. By default, the session
+    /// switches over to another transport only after the transfer-ID timeout. If this value is nonzero, the switchover
+    /// also occurs when a start-of-transfer frame arrives from another transport while no frames have been received
+    /// from the active one (on any port) for longer than this timeout, which speeds up the recovery after an interface
+    /// failure. The timeout should exceed the maximum expected inter-frame interval on a healthy bus, otherwise a
+    /// transfer that is delivered with a large latency difference between the transports may be accepted twice.
+    /// This field is zero (disabled) by default; the user can change it at any time.
+    CanardMicrosecond rx_failover_timeout_usec;
+
+    /// The timestamp of the last frame received from each redundant transport. Read-only DO NOT MODIFY THIS
+    CanardMicrosecond rx_last_frame_usec[CANARD_RX_REDUNDANT_TRANSPORTS_MAX];
+
+    /// The number of frames dropped per redundant transport because their session is locked on another transport;
+    /// normally, these are the duplicates delivered by the redundant interfaces. This field may be reset by the user.
+    size_t rx_redundant_frames_dropped[CANARD_RX_REDUNDANT_TRANSPORTS_MAX];
+
+#if CANARD_STATS
+    /// The RX statistics of all subscriptions combined; see CANARD_STATS. These fields may be reset by the user.
+    CanardRxStats rx_stats;
+    uint32_t      rx_frames_malformed;  ///< Not valid UAVCAN/CAN frames; see CanardTraceEventRxMalformed.
+    uint32_t      rx_frames_ignored;    ///< Frames without a matching subscription or addressed to another node.
+
+    /// The number of calls to memory_allocate and the total number of bytes requested. These fields may be reset.
+    uint32_t memory_allocations;
+    uint64_t memory_allocated_bytes;
+
+    /// The optional trace hook; NULL by default. The user can change it at any time.
+    CanardTraceHook trace_hook;
+#endif
 };
 
 /// CAN acceptance filter configuration with an extended 29-bit ID utilizing an ID + mask filter scheme.
@@ -417,6 +895,28 @@ CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const Cana
 /// The time complexity is constant. This function does not invoke the dynamic memory manager.
 CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes);
 
+/// Construct a new transmission queue instance whose frames are stored in a fixed-size frame pool carved out of the
+/// memory region supplied by the application instead of the dynamic memory of the library instance.
+/// Operations on such a queue never invoke the dynamic memory manager: each frame takes one block from the pool,
+/// and canardTxFree() returns it back; both operations are O(1).
+///
+/// The pool memory region shall be aligned at least at max_align_t and it shall outlive the queue.
+/// It is partitioned into blocks that are large enough to hold one frame of the specified MTU together with its
+/// metadata. The number of blocks can be estimated as pool_memory_size / (sizeof(CanardTxQueueItem) + mtu_bytes);
+/// the exact value is stored in the pool capacity field after construction. If the pool is exhausted, canardTxPush()
+/// fails with an out-of-memory error exactly as if the memory manager of the library instance was exhausted.
+///
+/// The MTU setting of the queue can still be changed between pushes, but the frames it generates will never exceed
+/// the MTU that was specified here because the blocks cannot accommodate larger frames.
+///
+/// If pool_memory is NULL, the behavior is identical to canardTxInit().
+///
+/// The time complexity is linear of the number of blocks. This function does not invoke the dynamic memory manager.
+CanardTxQueue canardTxInitWithPool(const size_t capacity,
+                                   const size_t mtu_bytes,
+                                   void* const  pool_memory,
+                                   const size_t pool_memory_size);
+
 /// This function serializes a transfer into a sequence of transport frames and inserts them into the prioritized
 /// transmission queue at the appropriate position. Afterwards, the application is supposed to take the enqueued frames
 /// from the transmission queue using the function canardTxPeek() and transmit them. Each transmitted (or otherwise
@@ -457,11 +957,14 @@ CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes);
 /// enqueued successfully, or none are.
 ///
 /// The time complexity is O(p + log e), where p is the amount of payload in the transfer, and e is the number of
-/// frames already enqueued in the transmission queue.
+/// frames already enqueued in the transmission queue. See CanardTxQueueEngine for the bucket engine.
 ///
 /// The memory allocation requirement is one allocation per transport frame. A single-frame transfer takes one
 /// allocation; a multi-frame transfer of N frames takes N allocations. The size of each allocation is
-/// (sizeof(CanardTxQueueItem) + MTU).
+/// (sizeof(CanardTxQueueItem) + MTU); see CANARD_TX_ITEM_SIZE() and canardTxQueueWorstCaseBytes().
+/// The item size includes the node of the deadline index unless it is disabled; see CANARD_TX_DEADLINE_INDEX.
+/// If the queue is backed by a frame pool (see canardTxInitWithPool()), the frames are taken from the pool instead
+/// and the dynamic memory manager is not invoked.
 int32_t canardTxPush(CanardTxQueue* const                que,
                      CanardInstance* const               ins,
                      const CanardMicrosecond             tx_deadline_usec,
@@ -469,6 +972,57 @@ int32_t canardTxPush(CanardTxQueue* const                que,
                      const size_t                        payload_size,
                      const void* const                   payload);
 
+/// This is a scatter-gather version of canardTxPush(). The payload is defined as the concatenation of the
+/// fragments in the order of their appearance in the array; the fragments need not be adjacent in memory.
+/// This is useful when the payload is composed of several parts (e.g., a header and a body) that would otherwise
+/// have to be copied into a contiguous temporary buffer before the transfer could be enqueued.
+///
+/// The transfer CRC is computed incrementally as the fragments are copied into the frames; the frame boundaries
+/// do not need to be aligned with the fragment boundaries. Empty fragments are allowed and ignored.
+/// The fragments pointer may be NULL only if the fragment count is zero, which denotes an empty payload.
+///
+/// The result is exactly the same as that of canardTxPush() invoked with the concatenated payload, including the
+/// error handling, except that the invalid argument error is also returned if any of the fragments has a NULL data
+/// pointer and a nonzero size. The time complexity is O(p + f + log e), where f is the number of fragments.
+int32_t canardTxPushV(CanardTxQueue* const                que,
+                      CanardInstance* const               ins,
+                      const CanardMicrosecond             tx_deadline_usec,
+                      const CanardTransferMetadata* const metadata,
+                      const size_t                        fragment_count,
+                      const CanardPayloadFragment* const  fragments);
+
+/// One transfer submitted for transmission via canardTxPushMany(). The fields have the same meaning as the
+/// arguments of canardTxPush().
+typedef struct CanardTxBatchItem
+{
+    CanardMicrosecond      tx_deadline_usec;
+    CanardTransferMetadata metadata;
+    size_t                 payload_size;
+    const void*            payload;
+} CanardTxBatchItem;
+
+/// This is a batch version of canardTxPush() that enqueues several transfers at once. It is intended for applications
+/// that publish many transfers per cycle: the capacity of the queue is checked once for the whole batch and the MTU
+/// is computed once, which reduces the per-transfer overhead.
+///
+/// The semantics are as if canardTxPush() was invoked for each item in the order of their appearance in the array,
+/// except that the operation is atomic: either all frames of all transfers are enqueued successfully, or none are.
+/// In case of failure, all frames that were allocated for the batch are deallocated automatically and the queue
+/// is left unmodified.
+///
+/// The function returns the total number of frames enqueued (zero if the batch is empty) in case of success.
+/// In case of failure, it returns a negated error code: invalid argument if the queue or the instance is NULL,
+/// if the items pointer is NULL while the count is nonzero, or if any of the items is invalid (see canardTxPush());
+/// out-of-memory if the memory or the capacity of the queue would be exhausted by the batch.
+///
+/// The time complexity is O(p + f log e), where p is the total amount of payload in the batch, f is the total number
+/// of frames in the batch, and e is the number of frames in the queue. The memory allocation requirement is the
+/// same as that of canardTxPush() invoked for each item.
+int32_t canardTxPushMany(CanardTxQueue* const           que,
+                         CanardInstance* const          ins,
+                         const size_t                   count,
+                         const CanardTxBatchItem* const items);
+
 /// This function accesses the top element of the prioritized transmission queue. The queue itself is not modified
 /// (i.e., the accessed element is not removed). The application should invoke this function to collect the transport
 /// frames of serialized transfers pushed into the prioritized transmission queue by canardTxPush().
@@ -482,17 +1036,39 @@ int32_t canardTxPush(CanardTxQueue* const                que,
 ///
 /// If the queue is non-empty, the returned value is a pointer to its top element (i.e., the next frame to transmit).
 /// The returned pointer points to an object allocated in the dynamic storage; it should be eventually freed by the
-/// application by calling CanardInstance::memory_free(). The memory shall not be freed before the entry is removed
-/// from the queue by calling canardTxPop(); this is because until canardTxPop() is executed, the library retains
-/// ownership of the object. The pointer retains validity until explicitly freed by the application; in other words,
-/// calling canardTxPop() does not invalidate the object.
+/// application by calling canardTxFree() (or CanardInstance::memory_free() if the queue is not backed by a frame pool,
+/// which is equivalent unless the frame is lazily materialized). The memory shall not be freed before the entry is
+/// removed from the queue by calling canardTxPop(); this is because until canardTxPop() is executed, the library
+/// retains ownership of the object. The pointer retains validity until explicitly freed by the application; in other
+/// words, calling canardTxPop() does not invalidate the object.
 ///
 /// The payload buffer is located shortly after the object itself, in the same memory fragment. The application shall
-/// not attempt to free it.
+/// not attempt to free it. Lazily materialized frames have no contiguous payload buffer (the payload pointer is NULL);
+/// see canardTxPushShared().
 ///
-/// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
+/// The time complexity is logarithmic of the queue size, or constant if the bucket engine is used.
+/// This function does not invoke the dynamic memory manager.
 const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que);
 
+/// This function is like canardTxPeek() except that it honors the traffic shapers of the queue (see canardTxShape()):
+/// the returned frame is the first one in the transmission order whose port is not shaped or whose shaper has enough
+/// credit at the specified time. The frames of a port whose shaper is short of credit are held back, while the frames
+/// of the other ports, including those of lower priority, are not; the order of the frames of the same port is never
+/// changed. Without shapers, the result is the same as that of canardTxPeek().
+///
+/// If out_eligible_usec is not NULL, it receives the earliest time when this function may return a frame assuming
+/// that the queue is not modified in the meantime: now_usec if a frame is returned, a future time if all frames are
+/// held back, or UINT64_MAX if the queue is empty or if the frames cannot become eligible (zero rate). The application
+/// can use this value to schedule the next attempt instead of polling.
+///
+/// If the queue is NULL, the function returns NULL and has no other effect.
+///
+/// The time complexity is O(s + h (s + log n)), where s is the number of shapers, h is the number of frames held back
+/// in front of the returned one, and n is the size of the queue. This function does not invoke the memory manager.
+const CanardTxQueueItem* canardTxPeekShaped(CanardTxQueue* const    que,
+                                            const CanardMicrosecond now_usec,
+                                            CanardMicrosecond* const out_eligible_usec);
+
 /// This function transfers the ownership of the specified element of the prioritized transmission queue from the queue
 /// to the application. The element does not necessarily need to be the top one -- it is safe to dequeue any element.
 /// The element is dequeued but not invalidated; it is the responsibility of the application to deallocate the
@@ -501,9 +1077,328 @@ const CanardTxQueueItem* canardTxPeek(const CanardTxQueue* const que);
 ///
 /// If any of the arguments are NULL, the function has no effect and returns NULL.
 ///
-/// The time complexity is logarithmic of the queue size. This function does not invoke the dynamic memory manager.
+/// If the port of the frame is shaped, the length of the frame is deducted from the credit of its shaper.
+///
+/// The time complexity is logarithmic of the queue size, or constant if the bucket engine is used, plus linear of the
+/// number of shapers. This function does not invoke the dynamic memory manager.
 CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem* const item);
 
+/// This function attaches a traffic shaper to the specified port of the queue, so that canardTxPeekShaped() meters
+/// the transmission of its frames; see CanardTxShaper. The shaper is initialized with a full bucket. If the port is
+/// already shaped, its previous shaper is detached and replaced. Frames that are already enqueued are affected.
+/// The shapers do not affect canardTxPeek() and the push functions.
+///
+/// The return value is 1 if a new shaper has been attached, 0 if an existing one has been replaced, or a negated
+/// invalid argument error if any of the pointers are NULL or the transfer kind is invalid.
+/// The time complexity is linear of the number of shapers of the queue. No memory is allocated.
+int8_t canardTxShape(CanardTxQueue* const     que,
+                     const CanardTransferKind transfer_kind,
+                     const CanardPortID       port_id,
+                     const uint32_t           rate_bytes_per_second,
+                     const uint32_t           burst_bytes,
+                     CanardTxShaper* const    out_shaper);
+
+/// This function reverses the effect of canardTxShape(). The return value is 1 if the shaper has been detached,
+/// 0 if the port was not shaped, or a negated invalid argument error if the queue is NULL or the transfer kind is
+/// invalid. The time complexity is linear of the number of shapers of the queue.
+int8_t canardTxUnshape(CanardTxQueue* const que, const CanardTransferKind transfer_kind, const CanardPortID port_id);
+
+/// This function removes and deallocates all frames whose transmission deadline is not in the future, that is,
+/// tx_deadline_usec <= now_usec. Frames whose deadline is zero never expire because zero means that the deadline
+/// is not used. This is intended to quickly get rid of stale frames accumulated while the bus was unavailable,
+/// which would otherwise delay the transmission of fresh frames until they are peeked and dropped one by one.
+///
+/// The frames are located using a secondary index ordered by the deadline, so the frames that are not expired
+/// are not visited. If the index is disabled (see CANARD_TX_DEADLINE_INDEX), the entire queue is scanned instead.
+/// The frames are deallocated as if canardTxFree() was invoked on each of them.
+///
+/// The return value is the number of frames removed. If any of the arguments are NULL, the function has no effect
+/// and returns zero.
+///
+/// The time complexity is O(k log n), where k is the number of expired frames and n is the size of the queue;
+/// it is O(n + k log n) if the deadline index is disabled.
+size_t canardTxPurgeExpired(CanardTxQueue* const que, CanardInstance* const ins, const CanardMicrosecond now_usec);
+
+/// This function removes the specified frame and all frames that follow it in the same transfer from the queue
+/// and deallocates them. The intended use case is to stop wasting the bus on a transfer that will not be received
+/// anyway because one of its frames could not be transmitted (e.g., due to a timeout or an error).
+///
+/// The specified item may be either still enqueued (e.g., obtained using canardTxPeek()) or already removed from
+/// the queue using canardTxPop(). In the former case, the item is removed and deallocated along with the rest of
+/// the transfer. In the latter case, the item is left intact and the application retains its ownership; only the
+/// frames that follow it are affected. The frames that follow the item that are no longer enqueued are skipped.
+/// The frames that follow the specified item shall not have been deallocated; this is always the case if the
+/// application pops the frames in the order of their transmission and does not free them before the transfer is
+/// dropped (frames of the same transfer share the same CAN ID, so they are always transmitted in order).
+///
+/// The return value is the number of frames removed from the queue. If any of the arguments are NULL, the function
+/// has no effect and returns zero.
+///
+/// The time complexity is O(k log n), where k is the number of frames in the transfer and n is the size of the queue,
+/// or O(k) if the bucket engine is used.
+size_t canardTxDropTransfer(CanardTxQueue* const           que,
+                            CanardInstance* const          ins,
+                            const CanardTxQueueItem* const item);
+
+/// This function deallocates an item that was previously removed from the queue using canardTxPop().
+/// If the queue is backed by a frame pool, the memory is returned to the pool; otherwise, it is returned to the
+/// memory manager of the library instance. The queue and the instance shall be the same that were used to push
+/// the item. Freeing an item that is still enqueued is undefined behavior.
+///
+/// If any of the arguments are NULL, the function has no effect.
+///
+/// The time complexity is constant.
+void canardTxFree(CanardTxQueue* const que, CanardInstance* const ins, CanardTxQueueItem* const item);
+
+/// This function allocates a reference-counted payload buffer from the memory manager of the library instance.
+/// The application should serialize the transfer payload directly into the returned buffer and then enqueue it using
+/// canardTxPushShared() into one or several queues without copying it; the application owns one reference to the buffer
+/// that shall be released using canardTxReleasePayload() afterwards. The buffer is deallocated when the last
+/// reference to it is dropped.
+///
+/// Returns NULL if the size is zero, if the instance is NULL, or if the memory is exhausted. The memory footprint
+/// of the buffer is (size + sizeof(size_t)) bytes. The time complexity is constant.
+void* canardTxAllocatePayload(CanardInstance* const ins, const size_t size);
+
+/// This function drops the reference owned by the application to a buffer obtained from canardTxAllocatePayload().
+/// The buffer shall not be accessed by the application afterwards. If any of the arguments are NULL, the function has
+/// no effect. The time complexity is constant.
+void canardTxReleasePayload(CanardInstance* const ins, void* const payload);
+
+/// This is a zero-copy version of canardTxPush() where the payload buffer is shared with the queue instead of being
+/// copied into the frames. The payload pointer shall be obtained from canardTxAllocatePayload() (or be NULL if the
+/// size is zero), and the payload size shall not exceed the size of that buffer. The payload shall not be modified
+/// while it is referenced by the enqueued frames. The same buffer may be pushed multiple times, e.g., into the queues
+/// of several redundant interfaces; the buffer is retained until the last frame referencing it is freed.
+///
+/// The frames of a multi-frame transfer enqueued this way are lazily materialized: each frame only stores the bytes
+/// that are unique to it (padding, CRC, and the tail byte) and refers to the shared buffer for the rest, which means
+/// that the frame payload pointer is NULL. The frame data shall be obtained by the media driver on demand using
+/// canardTxGetFrameSegments() or canardTxMaterializeFrame(). Lazily materialized frames shall only be deallocated
+/// using canardTxFree(). Single-frame transfers and frames of queues backed by a frame pool are materialized eagerly
+/// as usual because there is nothing to be gained from sharing in these cases.
+///
+/// This mode eliminates the need to keep two copies of the payload of large transfers (the serialization buffer and
+/// the frames) in memory at the same time: each frame takes (sizeof(CanardTxQueueItem) + 3 * sizeof(size_t) + 1)
+/// bytes plus padding and CRC in the last frames, which is considerably less than (sizeof(CanardTxQueueItem) + MTU)
+/// with CAN FD. The semantics, the error handling, and the time complexity are otherwise the same as those of
+/// canardTxPush(); the memory footprint of the frames is independent of the MTU.
+int32_t canardTxPushShared(CanardTxQueue* const                que,
+                           CanardInstance* const               ins,
+                           const CanardMicrosecond             tx_deadline_usec,
+                           const CanardTransferMetadata* const metadata,
+                           const size_t                        payload_size,
+                           void* const                         payload);
+
+/// This function enqueues the same transfer into the transmission queues of several redundant interfaces at once.
+/// The result is equivalent to invoking canardTxPush() for each queue in the order of their appearance in the array
+/// but the transfer is serialized and its CRC is computed only once: the frames generated for one queue are copied
+/// verbatim into the subsequent queues that have the same effective MTU and the same storage kind (heap or frame
+/// pool). Each queue owns its own frames, so the ordering and the pop state of each queue are independent.
+/// All frames are materialized eagerly; see canardTxPushRedundantShared() for the version that stores the payload
+/// of multi-frame transfers only once for all interfaces.
+///
+/// The failure of one queue (e.g., because it is full) does not affect the other queues. If out_results is not NULL,
+/// it shall point to an array of que_count elements which is populated with the per-queue results: the number of
+/// frames enqueued or a negated error as defined for canardTxPush(). The return value is the number of queues that
+/// accepted the transfer, which may be zero; or the negated invalid argument error if any of the pointer arguments
+/// except out_results are NULL (including any of the queue pointers), que_count is zero, or the payload pointer is NULL
+/// while the payload size is nonzero; in the latter case, no queue is modified and out_results is not populated.
+///
+/// The time complexity is O(p + q (f + log e)), where p is the payload size, q is the number of queues, f is the
+/// number of frames per queue, and e is the number of frames already enqueued in a queue. The memory allocation
+/// requirement is that of canardTxPush() for each queue.
+int32_t canardTxPushRedundant(CanardTxQueue* const* const         ques,
+                              const size_t                        que_count,
+                              CanardInstance* const               ins,
+                              const CanardMicrosecond             tx_deadline_usec,
+                              const CanardTransferMetadata* const metadata,
+                              const size_t                        payload_size,
+                              const void* const                   payload,
+                              int32_t* const                      out_results);
+
+/// This is a version of canardTxPushRedundant() that enqueues the frames of multi-frame transfers lazily
+/// materialized (their payload pointer is NULL; see canardTxPushShared()), so the media driver shall obtain their data
+/// using canardTxGetFrameSegments() or canardTxMaterializeFrame() and deallocate them using canardTxFree() only.
+/// The payload is copied once into a shared reference-counted block which the frames of all queues refer to, so that
+/// it is stored only once for all interfaces rather than once per interface; the block is deallocated when the last
+/// frame referencing it is freed. If the shared block cannot be allocated, the frames are materialized eagerly as
+/// usual. Single-frame transfers and the frames of queues backed by a frame pool are always materialized eagerly.
+///
+/// The arguments, the results, and the time complexity are those of canardTxPushRedundant(). The memory allocation
+/// requirement is that of canardTxPushShared() for each queue plus at most one shared block.
+int32_t canardTxPushRedundantShared(CanardTxQueue* const* const         ques,
+                                    const size_t                        que_count,
+                                    CanardInstance* const               ins,
+                                    const CanardMicrosecond             tx_deadline_usec,
+                                    const CanardTransferMetadata* const metadata,
+                                    const size_t                        payload_size,
+                                    const void* const                   payload,
+                                    int32_t* const                      out_results);
+
+typedef struct CanardTxFrameSink CanardTxFrameSink;
+
+/// A pointer to the function that provides a buffer for the payload of the next frame, e.g., a hardware TX mailbox
+/// or a slot in the memory-mapped message RAM of a CAN FD controller. The buffer shall be at least "payload_size"
+/// bytes large; the payload size is always a valid CAN (FD) frame length not exceeding the MTU of the queue.
+/// If the hardware cannot accept another frame at the moment, the returned pointer shall be NULL.
+typedef void* (*CanardTxFrameAcquire)(CanardTxFrameSink* const sink, const size_t payload_size);
+
+/// A pointer to the function that hands over the frame whose payload has been written into the buffer returned by the
+/// last acquisition to the hardware for transmission. The frame payload pointer points to that buffer.
+/// Every successful acquisition is followed by exactly one commit before the next acquisition takes place.
+typedef void (*CanardTxFrameCommit)(CanardTxFrameSink* const sink,
+                                    const CanardMicrosecond  tx_deadline_usec,
+                                    const CanardFrame* const frame);
+
+/// The interface of a media driver that can accept frames directly; see canardTxPushDirect().
+struct CanardTxFrameSink
+{
+    /// User pointer that can link this sink with other objects, e.g., the driver instance.
+    /// The library does not access it.
+    void* user_reference;
+
+    /// These SHALL be valid function pointers. See their type documentation for details.
+    CanardTxFrameAcquire acquire;
+    CanardTxFrameCommit  commit;
+};
+
+/// This is a version of canardTxPush() that serializes the frames of the transfer directly into the buffers provided
+/// by the media driver via the sink instead of allocating them in the queue, which eliminates the copying of the frame
+/// data from the queue into the hardware and keeps the software queue short while the bus is not congested.
+///
+/// The frames are written into the sink one by one for as long as it provides buffers. Once the sink reports that
+/// the hardware is full (backpressure), the remaining frames of the transfer are enqueued into the TX queue as usual
+/// and shall be transmitted later by the application; the sink is not used again during this call. To preserve the
+/// transmission order, the sink is not used at all if the queue is not empty: in that case, the function behaves
+/// exactly like canardTxPush(). The sink is also bypassed if it is NULL. Frames enqueued into a queue backed by
+/// a frame pool are allocated from the pool as usual.
+///
+/// The queue capacity is checked before anything is written into the sink, assuming that every frame of the transfer
+/// will have to be enqueued; so if the queue cannot accommodate the entire transfer, the error is reported and nothing
+/// is transmitted. If the memory is exhausted while the remainder of the transfer is being enqueued, the frames that
+/// have already been committed into the sink cannot be withdrawn, so the transfer is emitted incomplete and will be
+/// discarded by the receivers; the out-of-memory error is reported in this case.
+///
+/// The return value is the total number of frames produced (written into the sink plus enqueued), or a negated
+/// error, which is defined as for canardTxPush(). The time complexity is that of canardTxPush(), where only the frames
+/// that are enqueued contribute to the logarithmic term; the frames written into the sink require no memory.
+int32_t canardTxPushDirect(CanardTxQueue* const                que,
+                           CanardInstance* const               ins,
+                           CanardTxFrameSink* const            sink,
+                           const CanardMicrosecond             tx_deadline_usec,
+                           const CanardTransferMetadata* const metadata,
+                           const size_t                        payload_size,
+                           const void* const                   payload);
+
+typedef struct CanardTxStream CanardTxStream;
+
+/// A pointer to the function that provides the payload of a streamed transfer; see canardTxStreamInit().
+/// It shall copy exactly "size" bytes of the payload starting at "offset" into the destination buffer.
+/// The payload is read sequentially in small pieces not exceeding the MTU, each byte exactly once, while the frames
+/// are being generated by canardTxStreamPump(); so the payload can be produced on the fly (e.g., read from a file).
+typedef void (*CanardTxStreamRead)(CanardTxStream* const stream,
+                                   const size_t          offset,
+                                   const size_t          size,
+                                   void* const           destination);
+
+/// The state of a transfer that is transmitted in the streaming mode; see canardTxStreamInit().
+/// The application is expected to allocate streams statically or as part of its own transfer context.
+/// STREAM INSTANCES SHALL NOT BE MOVED WHILE IN USE.
+struct CanardTxStream
+{
+    /// User pointer that can link this stream with other objects, e.g., the file being transferred.
+    /// The library does not access it.
+    void* user_reference;
+
+    /// The source of the payload. Read-only DO NOT MODIFY THIS
+    CanardTxStreamRead read;
+
+    /// The parameters of the transfer as specified at initialization. The MTU is that of the queue at that moment;
+    /// it is used for all frames of the transfer regardless of later changes. Read-only DO NOT MODIFY THIS
+    CanardTransferMetadata metadata;
+    CanardMicrosecond      tx_deadline_usec;
+    size_t                 payload_size;
+    size_t                 mtu_bytes;
+    uint32_t               can_id;
+
+    /// The state of the serializer: the number of bytes of the payload and the CRC that have been emitted, the number
+    /// of frames emitted and yet to be emitted, the running transfer CRC, and the toggle bit of the next frame.
+    /// The transfer is complete when remaining_frames is zero. Read-only DO NOT MODIFY THIS
+    size_t   offset;
+    size_t   frame_count;
+    size_t   remaining_frames;
+    uint16_t crc;
+    bool     toggle;
+};
+
+/// This function prepares a transfer for transmission in the streaming mode, where the frames are generated
+/// incrementally by canardTxStreamPump() as the space in the queue becomes available, instead of being enqueued all at
+/// once as canardTxPush() does. This keeps the memory footprint of the queue bounded regardless of the size of the
+/// transfer, and prevents a large transfer from failing due to insufficient queue capacity or monopolizing the queue.
+/// The frames are identical to those produced by canardTxPush() for the same transfer; nothing is enqueued here.
+///
+/// The payload is provided by the read function on demand, so it need not be resident in memory (see
+/// CanardTxStreamRead); its total size shall be known in advance. The user reference of the stream is not modified.
+///
+/// The function returns zero on success or the negated invalid argument error if any of the pointers are NULL,
+/// if the metadata is invalid (see canardTxPush()), or if the local node is anonymous because the pseudo node-ID
+/// of an anonymous transfer depends on its payload. The time complexity is constant; no memory is allocated.
+int8_t canardTxStreamInit(CanardTxStream* const               stream,
+                          const CanardTxQueue* const          que,
+                          const CanardInstance* const         ins,
+                          const CanardMicrosecond             tx_deadline_usec,
+                          const CanardTransferMetadata* const metadata,
+                          const size_t                        payload_size,
+                          const CanardTxStreamRead            read);
+
+/// This function enqueues the next frames of a streamed transfer for as long as the queue has room for them
+/// (considering the capacity and the reservations; see CanardTxQueue), but no more than max_frames, which limits
+/// the share of the queue taken by the stream at once. The application is expected to invoke it periodically,
+/// e.g., after popping frames from the queue, until remaining_frames of the stream reaches zero. The queue shall be
+/// the one the stream was initialized with. The frames of the stream are never reordered relative to each other
+/// because the queue keeps the frames with identical CAN ID in the order of their insertion; the same holds for
+/// any other frames with the same CAN ID, though, which are therefore interleaved with the batches of the stream.
+///
+/// Hence, no other transfer shall be pushed into the queue for the same session (i.e., the same port, transfer kind,
+/// and destination) while the stream is incomplete, not even with a different transfer-ID: its first frame would
+/// appear in the middle of the stream, so the receivers would restart the reassembly and discard the stream.
+/// The application shall either pump the stream until remaining_frames is zero before pushing the next transfer on
+/// that session, or hold the next transfer back until then.
+///
+/// Only the frames enqueued by the same invocation are linked via next_in_transfer, so canardTxDropTransfer()
+/// cannot remove the frames enqueued by earlier invocations. A stream can be abandoned at any moment simply by
+/// not pumping it anymore; the receivers will discard the incomplete transfer.
+///
+/// The return value is the number of frames enqueued, which is zero if the queue is full or the transfer is already
+/// complete. In case of failure, the function returns a negated error: invalid argument if any of the pointers are
+/// NULL or the stream is not initialized; out-of-memory if not a single frame could be allocated even though the
+/// queue has room. The stream remains usable after an error; the pumping can be resumed later.
+/// The time complexity is O(n (m + log e)), where n is the number of frames enqueued, m is the MTU, and e is the
+/// number of frames in the queue. There is one allocation per frame, as in canardTxPush().
+int32_t canardTxStreamPump(CanardTxQueue* const  que,
+                           CanardInstance* const ins,
+                           CanardTxStream* const stream,
+                           const size_t          max_frames);
+
+/// This function provides a zero-copy view of the payload of a TX frame as a sequence of memory segments whose
+/// concatenation is the frame payload. It is intended for media drivers that can transmit from several buffers
+/// (e.g., using scatter-gather DMA) and is the only way to access the data of lazily materialized frames without
+/// copying; see canardTxPushShared(). Ordinary frames consist of exactly one segment.
+///
+/// The out_segments array shall be at least CANARD_TX_FRAME_SEGMENTS_MAX elements large. The segments remain valid
+/// until the item is freed. The return value is the number of segments populated; it is zero if any of the arguments
+/// are NULL. The time complexity is constant.
+size_t canardTxGetFrameSegments(const CanardTxQueueItem* const item, CanardPayloadFragment* const out_segments);
+
+/// This function copies the payload of a TX frame, which may be lazily materialized, into the provided buffer,
+/// which shall be at least item->frame.payload_size bytes large. This is a convenience wrapper over
+/// canardTxGetFrameSegments() for media drivers that require the CAN frame data to be contiguous.
+///
+/// The return value is the number of bytes copied, which equals item->frame.payload_size. If any of the arguments
+/// are NULL, the function has no effect and returns zero. The time complexity is linear of the frame size.
+size_t canardTxMaterializeFrame(const CanardTxQueueItem* const item, void* const destination);
+
 /// This function implements the transfer reassembly logic. It accepts a transport frame from any of the redundant
 /// interfaces, locates the appropriate subscription state, and, if found, updates it. If the frame completed a
 /// transfer, the return value is 1 (one) and the out_transfer pointer is populated with the parameters of the
@@ -526,12 +1421,17 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 ///     1. New memory for a session state object is allocated when a new session is initiated.
 ///        This event occurs when a transport frame that matches a known subscription is received from a node that
 ///        did not emit matching frames since the subscription was created.
-///        Once a new session is created, it is not destroyed until the subscription is terminated by invoking
-///        canardRxUnsubscribe(). The number of sessions is bounded and the bound is low (at most the number of nodes
-///        in the network minus one), also the size of a session instance is very small, so the removal is unnecessary.
-///        Real-time networks typically do not change their configuration at runtime, so it is possible to reduce
-///        the time complexity by never deallocating sessions.
-///        The size of a session instance is at most 48 bytes on any conventional platform (typically much smaller).
+///        Once a new session is created, it lives until the subscription is terminated by invoking
+///        canardRxUnsubscribe(), until the session becomes stale and is removed by canardRxCleanup() (if the
+///        application invokes it), or until it is evicted from the session pool. The number of sessions is bounded
+///        and the bound is low (at most the number of nodes in the network minus one), also the size of a session
+///        instance is very small, so the removal is normally unnecessary: real-time networks typically do not change
+///        their configuration at runtime, so canardRxAccept() itself never deallocates sessions.
+///        If the session pool is used (see canardRxSetSessionPool()), the sessions are taken from the pool instead
+///        of the dynamic memory, and if the pool is exhausted, the least recently used session of the instance
+///        (of any subscription) is evicted together with its payload buffer to make room for the new one.
+///        canardRxCleanup() deallocates the payload buffers of the removed sessions as well.
+///        The size of a session instance is at most CANARD_RX_SESSION_SIZE_MAX bytes on any conventional platform.
 ///
 ///     2. New memory for the transfer payload buffer is allocated when a new transfer is initiated, unless the buffer
 ///        was already allocated at the time.
@@ -554,6 +1454,8 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 ///
 /// Where sizeof(session instance) and extent are defined above, and number_of_nodes is the number of remote
 /// nodes emitting transfers that match the subscription (which cannot exceed (CANARD_NODE_ID_MAX-1) by design).
+/// This value is computed by canardRxSubscriptionWorstCaseBytes(); the live consumption is reported by
+/// canardInstanceMemoryUsage().
 /// If the dynamic memory pool is sized correctly, the application is guaranteed to never encounter an
 /// out-of-memory (OOM) error at runtime. The actual size of the dynamic memory pool is typically larger;
 /// for a detailed treatment of the problem and the related theory please refer to the documentation of O1Heap --
@@ -561,10 +1463,12 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 ///
 /// The time complexity is O(p + log n) where n is the number of subject-IDs or service-IDs subscribed to by the
 /// application, depending on the transfer kind of the supplied frame, and p is the amount of payload in the received
-/// frame (because it will be copied into an internal contiguous buffer). Observe that the time complexity is
-/// invariant to the network configuration (such as the number of online nodes) -- this is a very important
-/// design guarantee for real-time applications because the execution time is dependent only on the number of
-/// active subscriptions for a given transfer kind, and the MTU, both of which are easy to predict and account for.
+/// frame (because it will be copied into an internal contiguous buffer). If the subscription lookup table is enabled
+/// (see canardRxSetLookup()), the subscription search is constant-time, so the complexity reduces to O(p).
+/// Observe that the time complexity is invariant to the network configuration (such as the number of online nodes)
+/// -- this is a very important design guarantee for real-time applications because the execution time is dependent
+/// only on the number of active subscriptions for a given transfer kind, and the MTU, both of which are easy to
+/// predict and account for.
 /// Excepting the subscription search and the payload data copying, the entire RX pipeline contains neither loops
 /// nor recursion.
 /// Misaddressed and malformed frames are discarded in constant time.
@@ -572,10 +1476,21 @@ CanardTxQueueItem* canardTxPop(CanardTxQueue* const que, const CanardTxQueueItem
 /// The function returns 1 (one) if the new frame completed a transfer. In this case, the details of the transfer
 /// are stored into out_transfer, and the transfer payload buffer ownership is passed to that object. The lifetime
 /// of the resulting transfer object is not related to the lifetime of the input transport frame (that is, even if
-/// it is a single-frame transfer, its payload is copied out into a new dynamically allocated buffer storage).
+/// it is a single-frame transfer, its payload is copied out into a new dynamically allocated buffer storage),
+/// unless the subscription borrows single-frame transfers (see CanardRxSubscription.borrow_single_frame).
+/// In that case, the payload of a single-frame transfer points into the payload of the input frame, which shall
+/// therefore outlive the use of the transfer; this is indicated by CanardRxTransfer.payload_borrowed, and such
+/// payloads shall not be deallocated.
 /// If the extent is zero, the payload pointer may be NULL, since there is no data to store and so a
 /// buffer is not needed. The application is responsible for deallocating the payload buffer when the processing
-/// is done by invoking memory_free on the transfer payload pointer.
+/// is done by invoking canardRxReleasePayload() with the subscription that accepted the transfer, unless the payload
+/// is borrowed. If the subscription has no payload pool (see canardRxSetPayloadPool()), invoking memory_free on the
+/// transfer payload pointer is equivalent; otherwise, the buffer is a pool block that shall not be passed to the heap.
+///
+/// If the subscription has listeners (see canardRxAddListener()), the completed transfer is dispatched to them
+/// directly and the function returns zero instead; the content of out_transfer is then unspecified.
+/// Likewise, if the subscription is in the streaming mode (see CanardRxSubscription.stream_handler), the payload is
+/// delivered to the stream handler frame by frame, no payload buffers are allocated, and the function returns zero.
 ///
 /// The function returns a negated out-of-memory error if it was unable to allocate dynamic memory.
 ///
@@ -597,6 +1512,47 @@ int8_t canardRxAccept(CanardInstance* const        ins,
                       CanardRxTransfer* const      out_transfer,
                       CanardRxSubscription** const out_subscription);
 
+/// One received frame submitted for processing via canardRxAcceptMany(). The fields have the same meaning as the
+/// arguments of canardRxAccept().
+typedef struct CanardRxBatchItem
+{
+    CanardMicrosecond timestamp_usec;
+    CanardFrame       frame;
+} CanardRxBatchItem;
+
+/// This is a batch version of canardRxAccept() intended for media drivers that deliver received frames in bursts
+/// (e.g., via recvmmsg() or by draining a hardware FIFO). All frames of the batch shall have been received via the
+/// same redundant interface. The argument validation is done once per batch, and the result of the subscription
+/// search is reused across consecutive frames that belong to the same port, which is the common case in bursts.
+///
+/// The semantics are as if canardRxAccept() was invoked for each frame in the order of their appearance in the array.
+/// Each completed transfer is stored into the next element of out_transfers, and the subscription that accepted it is
+/// stored into the corresponding element of out_subscriptions unless it is NULL; the payload ownership of each
+/// transfer is passed to the application as usual. Frames that are invalid (see canardRxAccept()) are ignored like
+/// non-UAVCAN/CAN frames, so that one bad frame does not affect the rest of the batch.
+///
+/// The processing stops early if the output array is full (because every frame may complete a transfer) or if the
+/// memory is exhausted. The number of consumed frames is stored into out_consumed (unless it is NULL), so the
+/// application can resubmit the rest later. If the number of consumed frames is less than the frame count while
+/// the transfer capacity is not exhausted, an out-of-memory condition has occurred. The frame that caused it is not
+/// counted as consumed, but unless the failure occurred while creating a new session, it is lost exactly as it would
+/// be with canardRxAccept(): the session has already moved on to the next transfer-ID, so a resubmitted copy of the
+/// frame is discarded as a duplicate, and the rest of its transfer is discarded as well.
+///
+/// The return value is the number of transfers stored into out_transfers, which may be zero. It is a negated invalid
+/// argument error if the instance is NULL, or if any of the array pointers (except out_subscriptions) is NULL while
+/// the corresponding count is nonzero; the consumed count is then zero.
+///
+/// The time complexity and the memory allocation requirement are those of canardRxAccept() for each frame.
+int32_t canardRxAcceptMany(CanardInstance* const          ins,
+                           const uint8_t                  redundant_transport_index,
+                           const size_t                   frame_count,
+                           const CanardRxBatchItem* const frames,
+                           const size_t                   transfer_capacity,
+                           CanardRxTransfer* const        out_transfers,
+                           CanardRxSubscription** const   out_subscriptions,
+                           size_t* const                  out_consumed);
+
 /// This function creates a new subscription, allowing the application to register its interest in a particular
 /// category of transfers. The library will reject all transport frames for which there is no active subscription.
 /// The reference out_subscription shall retain validity until the subscription is terminated (the referred object
@@ -613,16 +1569,21 @@ int8_t canardRxAccept(CanardInstance* const        ins,
 /// whether its payload is truncated.
 ///
 /// The default transfer-ID timeout value is defined as CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC; use it if not sure.
-/// The redundant transport fail-over timeout (if redundant transports are used) is the same as the transfer-ID timeout.
-/// It may be reduced in a future release of the library, but it will not affect the backward compatibility.
+/// The redundant transport fail-over (if redundant transports are used) occurs after the transfer-ID timeout, or
+/// earlier if the active transport goes quiet; the latter is controlled by CanardInstance.rx_failover_timeout_usec.
 ///
 /// The return value is 1 if a new subscription has been created as requested.
 /// The return value is 0 if such subscription existed at the time the function was invoked. In this case,
 /// the existing subscription is terminated and then a new one is created in its place. Pending transfers may be lost.
 /// The return value is a negated invalid argument error if any of the input arguments are invalid.
-///
-/// The time complexity is logarithmic from the number of current subscriptions under the specified transfer kind.
-/// This function does not allocate new memory. The function may deallocate memory if such subscription already
+/// The return value is a negated out-of-memory error if the subscription lookup table is enabled and its page for the
+/// subject could not be allocated, or if the sorted subscription index is enabled and full (see canardRxSetIndex());
+/// in this case, the subscription is not created (and the old one, if any, is removed).
+///
+/// The time complexity is logarithmic from the number of current subscriptions under the specified transfer kind,
+/// or linear of the total number of subscriptions if the sorted subscription index is enabled.
+/// This function does not allocate new memory unless the subscription lookup table is enabled, in which case it may
+/// allocate one page of the table (see CanardRxLookup). The function may deallocate memory if such subscription already
 /// existed; the deallocation behavior is specified in the documentation for canardRxUnsubscribe().
 ///
 /// Subscription instances have large look-up tables to ensure that the temporal properties of the algorithms are
@@ -644,17 +1605,177 @@ int8_t canardRxSubscribe(CanardInstance* const       ins,
 /// The return value is a negated invalid argument error if any of the input arguments are invalid.
 ///
 /// The time complexity is logarithmic from the number of current subscriptions under the specified transfer kind.
-/// This function does not allocate new memory.
+/// This function does not allocate new memory. If the subscription lookup table is enabled, the page of the table that
+/// contained the last subscription in its range is deallocated.
 int8_t canardRxUnsubscribe(CanardInstance* const    ins,
                            const CanardTransferKind transfer_kind,
                            const CanardPortID       port_id);
 
+/// This function enables the constant-time subscription lookup table (see CanardRxLookup) or disables it if the
+/// lookup pointer is NULL. The table is initialized by this function. The table can be enabled or disabled only while
+/// there are no subscriptions, since the existing subscriptions are not indexed retroactively; it is recommended to
+/// invoke this function once immediately after canardInit().
+///
+/// The return value is zero on success or a negated invalid argument error if the instance is NULL or if there
+/// are active subscriptions. The time complexity is linear of the size of the table; no memory is allocated.
+int8_t canardRxSetLookup(CanardInstance* const ins, CanardRxLookup* const lookup);
+
+/// This function initializes the sorted subscription index (see CanardRxIndex) in the provided memory and enables it,
+/// or disables it if the index pointer is NULL. Like the lookup table, the index can be enabled or disabled only while
+/// there are no subscriptions. The memory shall be aligned at least at max_align_t and shall remain valid and
+/// untouched while the index is in use. Each subscription takes one key and one pointer, i.e., 8 bytes on a 32-bit
+/// platform or 12 bytes on a 64-bit platform; the capacity is available via index->capacity afterwards.
+/// While the index is enabled, canardRxSubscribe() fails with the out-of-memory error if the index is full.
+///
+/// The return value is zero on success, or a negated invalid argument error if the instance is NULL, if there are
+/// active subscriptions, or if the memory pointer is NULL or too small to accommodate at least one subscription while
+/// the index pointer is not NULL. The time complexity is constant; no heap memory is allocated.
+int8_t canardRxSetIndex(CanardInstance* const ins,
+                        CanardRxIndex* const  index,
+                        void* const           memory,
+                        const size_t          memory_size);
+
+/// This function initializes the RX session pool (see CanardRxSessionPool) in the provided memory and makes the
+/// library instance keep its RX sessions there instead of allocating them from the heap; or, if the pool pointer
+/// is NULL, reverts the instance to the default behavior. Like the subscription lookup table, the pool can be
+/// enabled or disabled only while there are no subscriptions. If CANARD_RX_COMPACT_SUBSCRIPTIONS is nonzero,
+/// transfers from non-anonymous nodes cannot be received unless the pool is enabled (canardRxAccept() reports an
+/// out-of-memory error when it needs a new session).
+///
+/// The memory shall be aligned at least at max_align_t and shall remain valid and untouched while the pool is in use.
+/// The pool capacity (the maximum number of concurrent sessions) is determined by the memory size; it is available
+/// via pool->blocks.capacity afterwards. Each session takes about 56 bytes on a 32-bit platform or 88 bytes on a
+/// 64-bit platform, plus up to four pointers of the index.
+///
+/// The return value is zero on success, or a negated invalid argument error if the instance is NULL, if there are
+/// active subscriptions, or if the memory pointer is NULL or too small to accommodate at least one session while the
+/// pool pointer is not NULL. The time complexity is linear of the memory size; no heap memory is allocated.
+int8_t canardRxSetSessionPool(CanardInstance* const      ins,
+                              CanardRxSessionPool* const pool,
+                              void* const                memory,
+                              const size_t               memory_size);
+
+/// This function makes the subscription take its payload buffers from the fixed-size blocks carved out of the provided
+/// memory instead of the memory manager of the library instance, so that the reception of a high-rate port recycles
+/// buffers without heap traffic and without fragmenting the heap shared with the other ports. Each block can hold
+/// "extent" bytes; the number of blocks is (memory_size / extent), with the extent rounded up to the alignment, and it
+/// is available via subscription->payload_pool.capacity afterwards. The memory shall be aligned at least at
+/// max_align_t and shall remain valid and untouched while the subscription exists.
+///
+/// Each transfer in progress holds one block, and so does each received transfer until the application returns its
+/// payload using canardRxReleasePayload(). If there are no free blocks, the transfer is dropped and canardRxAccept()
+/// reports an out-of-memory error; the heap is not used as a fallback.
+///
+/// This function shall be invoked after canardRxSubscribe() and before the first frame is accepted on the
+/// subscription, or while none of its payload buffers are in use. If the memory pointer is NULL, the subscription
+/// reverts to the heap. The buffers of the received transfers that were taken from the heap shall be released by
+/// the application before the pool is installed, because canardRxReleasePayload() would return them to the pool.
+///
+/// The return value is zero on success, or the negated invalid argument error if the instance or the subscription is
+/// NULL, if blocks of the current pool are in use, if any session of the subscription holds a payload buffer (which
+/// is the case while a transfer is in progress, and after it is abandoned until canardRxCleanup() removes the stale
+/// session), if the extent is zero, or if the memory cannot accommodate at least one block.
+/// The time complexity is linear of the number of blocks plus the number of RX sessions of the instance.
+int8_t canardRxSetPayloadPool(CanardInstance* const       ins,
+                              CanardRxSubscription* const subscription,
+                              void* const                 memory,
+                              const size_t                memory_size);
+
+/// This function deallocates the payload of a transfer received on the specified subscription, which shall be the one
+/// reported by canardRxAccept(): the buffer is returned to the payload pool of the subscription if it has one,
+/// otherwise to the memory manager of the library instance. Borrowed payloads shall not be passed here.
+/// If any of the arguments are NULL, the function has no effect. The time complexity is constant.
+void canardRxReleasePayload(CanardInstance* const ins, CanardRxSubscription* const subscription, void* const payload);
+
+/// This function attaches a listener to the subscription, turning on the callback delivery mode for it: whenever
+/// a transfer is received on the subscription, canardRxAccept() or canardRxAcceptMany() invoke the handlers of the
+/// listeners in the order of attachment instead of returning the transfer to the caller (see CanardRxHandler).
+/// This allows several independent consumers to receive the transfers of the same port, and it relieves the
+/// application from dispatching the transfers returned by canardRxAccept() to their consumers manually.
+///
+/// The listeners shall be attached after canardRxSubscribe() because it resets the subscription. Listeners shall not
+/// be attached or detached from within a handler. The handler pointer of the listener shall be set prior to the
+/// invocation. The return value is 1 if the listener was attached, 0 if it was already attached to this subscription,
+/// or the negated invalid argument error if any of the pointers are NULL. The time complexity is linear of the number
+/// of the listeners of the subscription.
+int8_t canardRxAddListener(CanardRxSubscription* const subscription, CanardRxListener* const listener);
+
+/// This function detaches the listener from the subscription; if that was the last one, the subscription returns to
+/// the default mode where the transfers are returned by canardRxAccept(). The return value is 1 if the listener was
+/// detached, 0 if it was not attached to this subscription, or the negated invalid argument error if any of the
+/// pointers are NULL. The time complexity is linear of the number of the listeners of the subscription.
+int8_t canardRxRemoveListener(CanardRxSubscription* const subscription, CanardRxListener* const listener);
+
+/// Utilities for sharded reception on multi-core systems.
+///
+/// The library has no global state, so independent instances can be driven from different threads concurrently
+/// without any locking, provided that their memory managers are thread-safe or, preferably, independent.
+/// A multi-core application can therefore partition its subscriptions across N instances called shards, each
+/// with its own memory manager and driven by its own thread, such that every port is subscribed on exactly one shard.
+/// These functions define the partitioning: the application shall subscribe to each port on the shard returned by
+/// canardRxGetShardForPort(), and it shall feed each received frame into the shard returned by
+/// canardRxGetShardForFrame() for its CAN ID (if a single thread reads a CAN bus, it can route the frames to the
+/// shard threads via SPSC rings of frames). The ports are distributed evenly across the shards; the requests and the
+/// responses of a service share the same shard. Frames that are not valid UAVCAN/CAN frames may be routed to any shard
+/// because they are discarded anyway. If the shard count is zero, the result is zero. The time complexity is constant.
+///
+/// The transport state of the shards (such as the redundant interface statistics) is naturally per-shard.
+/// Transmission is not sharded because the TX queues are independent of the instance anyway.
+uint8_t canardRxGetShardForPort(const CanardTransferKind transfer_kind,
+                                const CanardPortID       port_id,
+                                const uint8_t            shard_count);
+uint8_t canardRxGetShardForFrame(const uint32_t extended_can_id, const uint8_t shard_count);
+
+/// This function initializes the SPSC transfer ring (see CanardRxRing) in the storage of the specified capacity.
+/// Returns zero on success or the negated invalid argument error if any of the pointers are NULL or if the capacity is
+/// not a power of two.
+int8_t canardRxRingInit(CanardRxRing* const ring, CanardRxRingItem* const storage, const size_t capacity);
+
+/// This function is invoked by the producer thread (the one that drives the library instance) to hand a received
+/// transfer over to the consumer thread, e.g., from a listener (see CanardRxHandler, return true to retain the
+/// payload). The transfer object is copied into the ring, and the ownership of the payload is passed on with it.
+/// The consumer thread shall release the payload using the memory manager of the shard in a thread-safe manner.
+///
+/// The return value is 1 if the transfer was enqueued, 0 if the ring is full (the payload ownership is not passed in
+/// this case), or the negated invalid argument error if the ring or the transfer are NULL or the ring is not
+/// initialized. The subscription pointer is stored as-is and may be NULL. The time complexity is constant.
+int8_t canardRxRingPush(CanardRxRing* const           ring,
+                        const CanardRxTransfer* const transfer,
+                        CanardRxSubscription* const   subscription);
+
+/// This function is invoked by the consumer thread to take the oldest transfer from the ring. The subscription pointer
+/// that was pushed alongside is stored into out_subscription unless it is NULL. The return value is 1 if a transfer
+/// was taken, 0 if the ring is empty, or the negated invalid argument error if the ring or the output transfer are
+/// NULL or the ring is not initialized. The time complexity is constant.
+int8_t canardRxRingPop(CanardRxRing* const          ring,
+                       CanardRxTransfer* const      out_transfer,
+                       CanardRxSubscription** const out_subscription);
+
+/// This function frees the RX sessions whose transfer-ID timeout has expired, together with their payload buffers.
+/// Normally, the library keeps a session and its buffer of up to "extent" bytes until the subscription is removed,
+/// even if the remote node has gone offline mid-transfer or it has only ever emitted a single transfer (as is the case
+/// during node-ID allocation or a network scan). The application should invoke this function periodically,
+/// e.g., once per transfer-ID timeout, to keep the heap consumption proportional to the number of active publishers.
+///
+/// A session is stale if more than transfer_id_timeout_usec of its subscription has elapsed since the timestamp of
+/// the first frame of its last transfer. Reception of the next frame from the remote node would reset a stale session
+/// anyway, so reclaiming it does not alter the behavior of the library in any way other than the memory consumption.
+///
+/// The sessions are linked in the order of their last start-of-transfer, so this function visits only the sessions
+/// that are reclaimed plus one. If the subscriptions use different transfer-ID timeouts, a stale session may be
+/// reclaimed later than it became stale (by at most the difference between the timeouts) because the scan stops at
+/// the first session that is not stale. The amortized time complexity is therefore constant per reclaimed session.
+///
+/// The return value is the number of reclaimed sessions, or the negated invalid argument error if the instance is NULL.
+/// Memory allocated for sessions and payload buffers is freed via the instance's memory_free.
+int32_t canardRxCleanup(CanardInstance* const ins, const CanardMicrosecond now_usec);
+
 /// Utilities for generating CAN controller hardware acceptance filter configurations
 /// to accept specific subjects, services, or nodes.
 ///
 /// Complex applications will likely subscribe to more subject IDs than there are
 /// acceptance filters available in the CAN hardware. In this case, the application
-/// should implement filter consolidation. See canardConsolidateFilters()
+/// should implement filter consolidation. See canardConsolidateFilters() and canardComputeFilters()
 /// as well as the UAVCAN specification for details.
 
 /// Generate an acceptance filter configuration to accept a specific subject ID.
@@ -693,6 +1814,84 @@ CanardFilter canardMakeFilterForServices(const CanardNodeID local_node_id);
 /// in the Transport Layer chapter of the UAVCAN specification.
 CanardFilter canardConsolidateFilters(const CanardFilter* const a, const CanardFilter* const b);
 
+/// Generate a set of at most max_filters acceptance filter configurations that admit every transfer the instance
+/// is currently subscribed to, while admitting as little of the remaining extended CAN ID space as possible.
+///
+/// One filter is generated per subscription using canardMakeFilterForSubject() and canardMakeFilterForService();
+/// service subscriptions are ignored if the local node is anonymous. The filters are then clustered hierarchically:
+/// the pair whose consolidation (see canardConsolidateFilters()) adds the least to the total number of admitted
+/// CAN IDs is merged until no more than max_filters remain. Redundant filters are merged regardless of the limit,
+/// hence the result may contain fewer filters than available. No information about the traffic on the bus is used,
+/// so the result is optimal with respect to the admitted ID space only.
+///
+/// If there are more subscriptions than max_filters, a temporary buffer of one CanardFilter per subscription is
+/// allocated via the instance's memory_allocate and freed before returning. The time complexity is cubic in the
+/// number of subscriptions, so this function is intended to be invoked when the set of subscriptions is changed,
+/// not per frame.
+///
+/// The return value is the number of filters written into out_filters (zero if there are no subscriptions).
+/// The invalid argument error is returned if any of the pointers is NULL or max_filters is zero.
+/// The out of memory error is returned if the temporary buffer could not be allocated.
+int32_t canardComputeFilters(CanardInstance* const ins, CanardFilter* const out_filters, const size_t max_filters);
+
+/// The following macros and functions help to size the heap (e.g., the O1Heap arena) or the pools for a particular
+/// configuration instead of estimating it manually. The results account only for the memory requested by the library;
+/// the overhead of the memory manager itself (per-allocation headers, rounding, fragmentation) shall be added on top.
+///
+/// The macros are integer constant expressions that can be used to size static storage. They yield conservative upper
+/// bounds that hold on any conventional platform; the functions return the exact values for the platform at hand.
+
+/// The size of the memory allocation made by canardTxPush() for one frame when the MTU of the queue is mtu_bytes.
+/// The MTU shall be a valid CAN data length, e.g., CANARD_MTU_CAN_CLASSIC or CANARD_MTU_CAN_FD.
+/// Lazily materialized frames (see canardTxPushShared()) are never larger, excepting the shared payload block.
+/// If CANARD_FIXED_MTU is nonzero, every frame takes exactly CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU) bytes.
+#define CANARD_TX_ITEM_SIZE(mtu_bytes) (sizeof(CanardTxQueueItem) + (size_t) (mtu_bytes))
+
+/// The worst-case heap consumption of a TX queue of the specified capacity whose frames are not pool-backed.
+#define CANARD_TX_QUEUE_WORST_CASE_BYTES(capacity, mtu_bytes) ((size_t) (capacity) * CANARD_TX_ITEM_SIZE(mtu_bytes))
+
+/// An upper bound on the size of the RX session state object allocated per remote node per subscription.
+#define CANARD_RX_SESSION_SIZE_MAX (sizeof(CanardMicrosecond) + (6U * sizeof(void*)) + 8U)
+
+/// The worst-case heap consumption of a subscription of the specified extent that receives transfers from
+/// max_sessions remote nodes concurrently; see canardRxAccept() for the derivation of the model.
+/// max_sessions cannot exceed CANARD_NODE_ID_MAX + 1 for each transfer kind.
+#define CANARD_RX_SUBSCRIPTION_WORST_CASE_BYTES(extent, max_sessions) \
+    ((size_t) (max_sessions) * (CANARD_RX_SESSION_SIZE_MAX + (size_t) (extent)))
+
+/// The exact version of CANARD_TX_QUEUE_WORST_CASE_BYTES() for this platform. The MTU is adjusted the same way as
+/// canardTxPush() does it, so any value is accepted. Multiply by the number of redundant queues if necessary.
+size_t canardTxQueueWorstCaseBytes(const size_t capacity, const size_t mtu_bytes);
+
+/// The exact version of CANARD_RX_SUBSCRIPTION_WORST_CASE_BYTES() for this platform. The result is only valid if
+/// neither the session pool nor the payload pool is used; see canardRxSetSessionPool() and canardRxSetPayloadPool().
+size_t canardRxSubscriptionWorstCaseBytes(const size_t extent, const size_t max_sessions);
+
+/// The live heap consumption of the library; see canardInstanceMemoryUsage().
+typedef struct CanardMemoryUsage
+{
+    size_t rx_sessions;         ///< The number of RX sessions allocated from the heap.
+    size_t rx_payload_buffers;  ///< The number of heap buffers of the transfers that are being reassembled.
+    size_t rx_lookup_pages;     ///< The number of subject pages of the subscription lookup table; see CanardRxLookup.
+    size_t tx_frames;           ///< The number of heap-allocated frames in the specified TX queues.
+
+    /// The total number of bytes of the above. The transfers that have been handed over to the application,
+    /// the payload blocks shared between TX frames (see canardTxAllocatePayload()), and the storage supplied by
+    /// the application (pools, TX queues, subscriptions, and the lookup table itself) are not included.
+    size_t total_bytes;
+} CanardMemoryUsage;
+
+/// Reports the amount of memory currently allocated from the heap of the instance. The TX queues are not
+/// referenced by the instance, so those that use its heap shall be supplied explicitly; que_count may be zero.
+/// The pointers shall not be NULL (excepting ques if que_count is zero); otherwise, the result is zero-filled.
+///
+/// This function does not invoke the dynamic memory manager. The time complexity is linear of the number of RX
+/// sessions, lookup pages, and TX frames, so it is intended for diagnostics and for sizing the heap at integration
+/// time (e.g., after a load test), not for the hot path.
+CanardMemoryUsage canardInstanceMemoryUsage(const CanardInstance* const       ins,
+                                            const CanardTxQueue* const* const ques,
+                                            const size_t                      que_count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,26 @@ static inline Cavl* cavlFindExtremum(Cavl* const root, const bool maximum)
     return result;
 }
 
+/// Modified for use with Libcanard: in-order traversal without recursion or a stack using the parent links.
+/// Return the node that follows (cavlNext) or precedes (cavlPrev) the specified one in the in-order sequence,
+/// or NULL if there is no such node or the argument is NULL. The worst-case complexity is O(log n);
+/// traversing the entire tree from the extremum takes O(n) total, so the amortized complexity is O(1).
+/// The tree shall not be modified while it is being traversed, excepting the removal of the node last returned
+/// provided that its successor is obtained before the removal.
+static inline Cavl* cavlNext(const Cavl* const node);
+static inline Cavl* cavlPrev(const Cavl* const node);
+
+/// Modified for use with Libcanard: insert the node immediately after the anchor in the in-order sequence without
+/// invoking the search predicate. The anchor shall be in the tree; the node shall not be. The caller is responsible
+/// for ensuring that the ordering of the tree is preserved, i.e., that no existing node belongs between the anchor
+/// and the new node. The root node may be replaced in the process. The function has no effect if any of the pointers
+/// are NULL.
+///
+/// This enables bulk insertion of a pre-sorted chain: insert the first node using cavlSearch(), then insert each
+/// subsequent node after its predecessor. The position is found in amortized O(1) since the predecessor was just
+/// inserted; the retracing is O(log n) in the worst case and amortized O(1) as well.
+static inline void cavlInsertAfter(Cavl** const root, Cavl* const anchor, Cavl* const node);
+
 // ----------------------------------------     END OF PUBLIC API SECTION      ----------------------------------------
 // ----------------------------------------      POLICE LINE DO NOT CROSS      ----------------------------------------
 
@@ -196,6 +216,68 @@ static inline Cavl* cavlPrivateRetraceOnGrowth(Cavl* const added)
     return (NULL == p) ? c : NULL;  // New root or nothing.
 }
 
+/// INTERNAL USE ONLY. Returns the in-order successor if r, predecessor otherwise.
+static inline Cavl* cavlPrivateAdjacent(const Cavl* const node, const bool r)
+{
+    Cavl* out = NULL;
+    if (node != NULL)
+    {
+        if (node->lr[r] != NULL)
+        {
+            out = cavlFindExtremum(node->lr[r], !r);  // The closest node in the subtree on that side.
+        }
+        else  // Climb up until we arrive from the other side.
+        {
+            const Cavl* c = node;
+            out           = node->up;
+            while ((out != NULL) && (out->lr[r] == c))
+            {
+                c   = out;
+                out = out->up;
+            }
+        }
+    }
+    return out;
+}
+
+static inline Cavl* cavlNext(const Cavl* const node)
+{
+    return cavlPrivateAdjacent(node, true);
+}
+
+static inline Cavl* cavlPrev(const Cavl* const node)
+{
+    return cavlPrivateAdjacent(node, false);
+}
+
+static inline void cavlInsertAfter(Cavl** const root, Cavl* const anchor, Cavl* const node)
+{
+    if ((root != NULL) && (anchor != NULL) && (node != NULL))
+    {
+        CAVL_ASSERT((*root != NULL) && ((anchor->up != NULL) || (anchor == *root)));
+        // The new node becomes either the right child of the anchor or the left child of its in-order successor
+        // located in the right subtree of the anchor; in both cases the attachment point is a NULL link.
+        Cavl* up = anchor;
+        bool  r  = true;
+        if (anchor->lr[1] != NULL)
+        {
+            up = cavlFindExtremum(anchor->lr[1], false);
+            r  = false;
+        }
+        CAVL_ASSERT(NULL == up->lr[r]);
+        up->lr[r]      = node;
+        node->lr[0]    = NULL;
+        node->lr[1]    = NULL;
+        node->up       = up;
+        node->bf       = 0;
+        Cavl* const rt = cavlPrivateRetraceOnGrowth(node);
+        if (rt != NULL)
+        {
+            *root = rt;
+        }
+    }
+}
+
 static inline Cavl* cavlSearch(Cavl** const        root,
                                void* const         user_reference,
                                const CavlPredicate predicate,
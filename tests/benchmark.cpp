@@ -0,0 +1,351 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 UAVCAN Development Team.
+
+// Throughput and latency benchmarks of the TX queue, the RX pipeline, and the CRC.
+// The results are printed to stdout as JSON Lines, one object per measurement, so that they can be compared across
+// builds by simple scripts. This is not a test: the results are not checked and it is not registered with CTest.
+// Usage: benchmark_x64 [iterations]
+// CANARD_BENCHMARK_CONFIG is defined by the build system; it is the name of the target.
+
+#include "exposed.hpp"
+#include "helpers.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// The number of memory manager calls made by the library instance so far.
+struct MemoryCallCounters
+{
+    std::uint64_t allocations = 0U;
+    std::uint64_t frees       = 0U;
+};
+
+auto allocate(CanardInstance* const ins, const std::size_t amount) -> void*
+{
+    static_cast<MemoryCallCounters*>(ins->user_reference)->allocations++;
+    return std::malloc(amount);
+}
+
+void deallocate(CanardInstance* const ins, void* const pointer)
+{
+    if (pointer != nullptr)
+    {
+        static_cast<MemoryCallCounters*>(ins->user_reference)->frees++;
+    }
+    std::free(pointer);
+}
+
+auto makeInstance(MemoryCallCounters& counters) -> CanardInstance
+{
+    CanardInstance ins = canardInit(&allocate, &deallocate);
+    ins.user_reference = &counters;
+    return ins;
+}
+
+/// Collects the latency of every sample and the number of memory manager calls made by the measured code.
+class Meter
+{
+public:
+    Meter(const MemoryCallCounters& counters, const std::size_t expected_samples) : counters_(counters)
+    {
+        samples_.reserve(expected_samples);
+    }
+
+    template <typename F>
+    void measure(const F& fun)
+    {
+        const MemoryCallCounters before  = counters_;
+        const auto               started = Clock::now();
+        fun();
+        const auto finished = Clock::now();
+        samples_.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count()));
+        calls_.allocations += counters_.allocations - before.allocations;
+        calls_.frees += counters_.frees - before.frees;
+    }
+
+    /// Prints one JSON object where params is a sequence of comma-separated "key":value pairs.
+    /// Each sample may consist of several operations, e.g., the frames of a multi-frame transfer.
+    /// The throughput is derived from the median latency so that it is not skewed by preemption of the process.
+    void report(const std::string& name, const std::string& params, const std::uint64_t ops_per_sample = 1U)
+    {
+        std::sort(samples_.begin(), samples_.end());
+        const auto percentile = [&](const std::size_t pct) -> std::uint64_t {
+            return samples_.empty() ? 0U : samples_.at(((samples_.size() - 1U) * pct) / 100U);
+        };
+        const auto ops         = static_cast<double>(samples_.size()) * static_cast<double>(ops_per_sample);
+        const auto median      = static_cast<double>(percentile(50U));
+        const auto throughput  = (median > 0.0) ? ((1e9 * static_cast<double>(ops_per_sample)) / median) : 0.0;
+        const auto allocations = (ops > 0.0) ? (static_cast<double>(calls_.allocations) / ops) : 0.0;
+        const auto frees       = (ops > 0.0) ? (static_cast<double>(calls_.frees) / ops) : 0.0;
+        std::cout << std::fixed << std::setprecision(3)                 //
+                  << R"({"config":")" << CANARD_BENCHMARK_CONFIG        //
+                  << R"(","benchmark":")" << name << R"(",)" << params  //
+                  << R"(,"samples":)" << samples_.size()                //
+                  << R"(,"ops_per_sec":)" << throughput                 //
+                  << R"(,"p50_ns":)" << percentile(50U)                 //
+                  << R"(,"p99_ns":)" << percentile(99U)                 //
+                  << R"(,"max_ns":)" << percentile(100U)                //
+                  << R"(,"allocations_per_op":)" << allocations         //
+                  << R"(,"frees_per_op":)" << frees << "}" << std::endl;
+    }
+
+private:
+    const MemoryCallCounters&  counters_;
+    MemoryCallCounters         calls_;
+    std::vector<std::uint64_t> samples_;
+};
+
+/// A trivial LCG is sufficient; the sequence shall be the same in every run.
+class Random
+{
+public:
+    auto next() -> std::uint32_t
+    {
+        state_ = (state_ * 1103515245U) + 12345U;
+        return state_ >> 8U;
+    }
+
+private:
+    std::uint32_t state_ = 12345U;
+};
+
+auto param(const std::string& key, const std::size_t value) -> std::string
+{
+    return "\"" + key + "\":" + std::to_string(value);
+}
+
+auto param(const std::string& key, const std::string& value) -> std::string
+{
+    return "\"" + key + "\":\"" + value + "\"";
+}
+
+/// Push, peek, and pop single-frame transfers while keeping the queue at the specified depth.
+void benchmarkTx(const CanardTxQueueEngine engine,
+                 const std::size_t         mtu,
+                 const std::size_t         depth,
+                 const std::size_t         iterations)
+{
+    MemoryCallCounters counters;
+    CanardInstance     ins = makeInstance(counters);
+    CanardTxQueue      que = canardTxInit(depth + 1U, mtu);
+    que.engine         = engine;
+    Random                    random;
+    CanardTransferMetadata    meta{};
+    std::vector<std::uint8_t> payload(mtu - 1U);
+    const auto                push = [&]() {
+        meta.priority    = static_cast<CanardPriority>(random.next() % (CANARD_PRIORITY_MAX + 1U));
+        meta.port_id     = static_cast<CanardPortID>(random.next() % (CANARD_SUBJECT_ID_MAX + 1U));
+        meta.transfer_id = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        return canardTxPush(&que, &ins, 0U, &meta, payload.size(), payload.data());
+    };
+    ins.node_id         = 42U;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    while ((que.size < (depth - 1U)) && (push() > 0))
+    {}
+
+    Meter push_meter(counters, iterations);
+    Meter peek_meter(counters, iterations);
+    Meter pop_meter(counters, iterations);
+    for (std::size_t i = 0U; i < iterations; i++)
+    {
+        push_meter.measure([&] { (void) push(); });
+        const CanardTxQueueItem* ti = nullptr;
+        peek_meter.measure([&] { ti = canardTxPeek(&que); });
+        pop_meter.measure([&] { canardTxFree(&que, &ins, canardTxPop(&que, ti)); });
+    }
+    const std::string params = param("engine", (engine == CanardTxQueueEngineTree) ? "tree" : "buckets") + "," +
+                               param("mtu", mtu) + "," + param("depth", depth);
+    push_meter.report("tx_push", params);
+    peek_meter.report("tx_peek", params);
+    pop_meter.report("tx_pop", params);
+
+    while (que.size > 0U)
+    {
+        canardTxFree(&que, &ins, canardTxPop(&que, canardTxPeek(&que)));
+    }
+}
+
+/// Accept single-frame transfers round-robin from every publisher on every subscription.
+void benchmarkRx(const std::size_t subscriptions, const std::size_t publishers, const std::size_t iterations)
+{
+    MemoryCallCounters                counters;
+    CanardInstance                    ins = makeInstance(counters);
+    std::vector<CanardRxSubscription> subs(subscriptions);
+    for (std::size_t i = 0U; i < subscriptions; i++)
+    {
+        const auto port_id = static_cast<CanardPortID>(i);
+        (void) canardRxSubscribe(&ins, CanardTransferKindMessage, port_id, 8U, 2'000'000U, &subs.at(i));
+    }
+    std::vector<std::uint8_t>   transfer_ids(subscriptions * publishers);
+    std::array<std::uint8_t, 8> payload{};
+    CanardMicrosecond           timestamp = 1'000'000U;
+    CanardRxTransfer            transfer{};
+    const auto                  make_frame = [&](const std::size_t index) {
+        const std::size_t sub = index % subscriptions;
+        const std::size_t pub = (index / subscriptions) % publishers;
+        auto&             tid = transfer_ids.at((sub * publishers) + pub);
+        payload.at(7)         = static_cast<std::uint8_t>(0b1110'0000U | tid);
+        tid                   = static_cast<std::uint8_t>((tid + 1U) & CANARD_TRANSFER_ID_MAX);
+        CanardFrame frame{};
+        frame.extended_can_id = helpers::makeMessageID(static_cast<CanardPortID>(sub), static_cast<CanardNodeID>(pub));
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        return frame;
+    };
+    // Warm up: create all sessions outside of the measurement.
+    for (std::size_t i = 0U; i < (subscriptions * publishers); i++)
+    {
+        const CanardFrame frame = make_frame(i);
+        if (canardRxAccept(&ins, ++timestamp, &frame, 0, &transfer, nullptr) > 0)
+        {
+            ins.memory_free(&ins, transfer.payload);
+        }
+    }
+    Meter meter(counters, iterations);
+    for (std::size_t i = 0U; i < iterations; i++)
+    {
+        const CanardFrame frame  = make_frame(i);
+        std::int8_t       result = 0;
+        timestamp++;
+        meter.measure([&] { result = canardRxAccept(&ins, timestamp, &frame, 0, &transfer, nullptr); });
+        if (result > 0)
+        {
+            ins.memory_free(&ins, transfer.payload);
+        }
+    }
+    meter.report("rx_accept", param("subscriptions", subscriptions) + "," + param("publishers", publishers));
+
+    for (std::size_t i = 0U; i < subscriptions; i++)
+    {
+        (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, static_cast<CanardPortID>(i));
+    }
+}
+
+/// Reassemble multi-frame transfers produced by the TX pipeline. One sample is one complete transfer, but the
+/// throughput and the memory manager calls are reported per frame. The payload is freed outside of the measurement.
+void benchmarkReassembly(const std::size_t mtu, const std::size_t payload_size, const std::size_t iterations)
+{
+    MemoryCallCounters counters;
+    CanardInstance     ins = makeInstance(counters);
+    ins.node_id            = 42U;
+    CanardTxQueue          que = canardTxInit(10'000U, mtu);
+    CanardTransferMetadata meta{};
+    meta.port_id        = 1234U;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    std::vector<std::uint8_t> payload(payload_size);
+    for (std::size_t i = 0U; i < payload_size; i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i);
+    }
+    // One transfer per transfer-ID value so that none is rejected as a duplicate.
+    std::vector<std::vector<std::vector<std::uint8_t>>> transfers(CANARD_TRANSFER_ID_MAX + 1U);
+    std::uint32_t                                       can_id = 0U;
+    for (auto& frames : transfers)
+    {
+        (void) canardTxPush(&que, &ins, 0U, &meta, payload.size(), payload.data());
+        meta.transfer_id++;
+        while (que.size > 0U)
+        {
+            CanardTxQueueItem* const ti = canardTxPop(&que, canardTxPeek(&que));
+            const auto* const        bytes = static_cast<const std::uint8_t*>(ti->frame.payload);
+            can_id                         = ti->frame.extended_can_id;
+            frames.emplace_back(bytes, bytes + ti->frame.payload_size);
+            canardTxFree(&que, &ins, ti);
+        }
+    }
+
+    CanardRxSubscription sub{};
+    (void) canardRxSubscribe(&ins, CanardTransferKindMessage, meta.port_id, payload_size, 2'000'000U, &sub);
+    CanardMicrosecond timestamp = 1'000'000U;
+    CanardRxTransfer  transfer{};
+    Meter             meter(counters, iterations);
+    for (std::size_t i = 0U; i < iterations; i++)
+    {
+        const auto& frames = transfers.at(i % transfers.size());
+        transfer.payload   = nullptr;
+        meter.measure([&] {
+            for (const auto& bytes : frames)
+            {
+                CanardFrame frame{};
+                frame.extended_can_id = can_id;
+                frame.payload_size    = bytes.size();
+                frame.payload         = bytes.data();
+                (void) canardRxAccept(&ins, ++timestamp, &frame, 0, &transfer, nullptr);
+            }
+        });
+        ins.memory_free(&ins, transfer.payload);
+    }
+    const std::size_t frame_count = transfers.front().size();
+    meter.report("rx_reassembly",
+                 param("mtu", mtu) + "," + param("payload_size", payload_size) + "," + param("frames", frame_count),
+                 frame_count);
+    (void) canardRxUnsubscribe(&ins, CanardTransferKindMessage, meta.port_id);
+}
+
+/// One sample is one CRC computation over a block of the specified size.
+void benchmarkCRC(const std::size_t block_size, const std::size_t iterations)
+{
+    std::vector<std::uint8_t> block(block_size);
+    Random                    random;
+    for (auto& x : block)
+    {
+        x = static_cast<std::uint8_t>(random.next());
+    }
+    std::uint16_t            crc = 0xFFFFU;
+    const MemoryCallCounters counters;
+    Meter                    meter(counters, iterations);
+    for (std::size_t i = 0U; i < iterations; i++)
+    {
+        meter.measure([&] { crc = exposed::crcAdd(crc, block.size(), block.data()); });
+    }
+    meter.report("crc", param("block_size", block_size) + "," + param("result", crc));
+}
+
+}  // namespace
+
+auto main(const int argc, const char* const argv[]) -> int
+{
+    const std::vector<std::string> args(argv, argv + argc);
+    const std::size_t              iterations = (args.size() > 1U) ? std::stoul(args.at(1)) : 100'000U;
+
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        for (const std::size_t mtu : {CANARD_MTU_CAN_CLASSIC, CANARD_MTU_CAN_FD})
+        {
+            for (const std::size_t depth : {1U, 16U, 256U, 4096U})
+            {
+                benchmarkTx(engine, mtu, depth, iterations);
+            }
+        }
+    }
+    for (const std::size_t subscriptions : {1U, 10U, 100U, 1000U})
+    {
+        for (const std::size_t publishers : {1U, 8U, 128U})
+        {
+            benchmarkRx(subscriptions, publishers, iterations);
+        }
+    }
+    for (const std::size_t mtu : {CANARD_MTU_CAN_CLASSIC, CANARD_MTU_CAN_FD})
+    {
+        for (const std::size_t payload_size : {64U, 256U, 1024U})
+        {
+            benchmarkReassembly(mtu, payload_size, iterations / 10U);
+        }
+    }
+    for (const std::size_t block_size : {8U, 64U, 1024U})
+    {
+        benchmarkCRC(block_size, iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+// This libcanard config header is included from canard.c via CANARD_CONFIG_HEADER
+
+#include "canard_config_private.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Emulates a platform CRC accelerator; defined in the test suite.
+uint16_t testCRCHook(uint16_t crc, size_t size, const void* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define CANARD_CRC_HOOK testCRCHook
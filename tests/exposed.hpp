@@ -19,7 +19,20 @@ struct TxItem final : CanardTxQueueItem
 {
     [[nodiscard]] auto getPayloadByte(const std::size_t offset) const -> std::uint8_t
     {
-        return reinterpret_cast<const std::uint8_t*>(frame.payload)[offset];
+        // Lazily materialized frames do not have a contiguous payload buffer, hence the segments.
+        CanardPayloadFragment segments[CANARD_TX_FRAME_SEGMENTS_MAX]{};
+        const auto            num_segments = canardTxGetFrameSegments(this, &segments[0]);
+        std::size_t           base         = 0;
+        for (std::size_t i = 0; i < num_segments; i++)
+        {
+            if (offset < (base + segments[i].size))
+            {
+                return reinterpret_cast<const std::uint8_t*>(segments[i].data)[offset - base];
+            }
+            base += segments[i].size;
+        }
+        // Can't use REQUIRE because it is not thread-safe.
+        throw std::out_of_range("The payload offset is out of range.");
     }
 
     [[nodiscard]] auto getTailByte() const
@@ -45,14 +58,19 @@ struct TxItem final : CanardTxQueueItem
 
 struct RxSession
 {
-    CanardMicrosecond transfer_timestamp_usec   = std::numeric_limits<std::uint64_t>::max();
-    std::size_t       total_payload_size        = 0U;
-    std::size_t       payload_size              = 0U;
-    std::uint8_t*     payload                   = nullptr;
-    TransferCRC       calculated_crc            = 0U;
-    CanardTransferID  transfer_id               = std::numeric_limits<std::uint8_t>::max();
-    std::uint8_t      redundant_transport_index = std::numeric_limits<std::uint8_t>::max();
-    bool              toggle                    = false;
+    CanardMicrosecond     transfer_timestamp_usec   = std::numeric_limits<std::uint64_t>::max();
+    std::size_t           total_payload_size        = 0U;
+    std::size_t           payload_size              = 0U;
+    std::uint8_t*         payload                   = nullptr;
+    TransferCRC           calculated_crc            = 0U;
+    CanardTransferID      transfer_id               = std::numeric_limits<std::uint8_t>::max();
+    std::uint8_t          redundant_transport_index = std::numeric_limits<std::uint8_t>::max();
+    bool                  toggle                    = false;
+    CanardNodeID          source_node_id            = CANARD_NODE_ID_UNSET;
+    std::uint8_t          stream_carry[2]{};
+    RxSession*            older                     = nullptr;
+    RxSession*            newer                     = nullptr;
+    CanardRxSubscription* subscription              = nullptr;
 };
 
 struct RxFrameModel
@@ -96,6 +114,7 @@ auto txMakeTailByte(const bool         start_of_transfer,
                     const std::uint8_t transfer_id) -> std::uint8_t;
 
 auto txRoundFramePayloadSizeUp(const std::size_t x) -> std::size_t;
+auto txRoundFramePayloadSizeDown(const std::size_t x) -> std::size_t;
 
 auto rxTryParseFrame(const CanardMicrosecond  timestamp_usec,
                      const CanardFrame* const frame,
@@ -6,6 +6,7 @@
 #include "canard.h"
 #include "exposed.hpp"
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdarg>
 #include <cstdlib>
@@ -59,6 +60,23 @@ static inline void traverse(const CanardTreeNode* const root, const F& fun)  //
     }
 }
 
+/// Returns the CAN ID of a message frame of the specified subject from the specified node at the nominal priority.
+inline auto makeMessageID(const CanardPortID subject_id, const CanardNodeID source_node_id) -> std::uint32_t
+{
+    return (4UL << 26U) | (3UL << 21U) | (static_cast<std::uint32_t>(subject_id) << 8U) | source_node_id;
+}
+
+/// Returns the CAN ID of a service frame of the specified service between the specified nodes at the nominal priority.
+inline auto makeServiceID(const CanardPortID service_id,
+                          const bool         request,
+                          const CanardNodeID destination_node_id,
+                          const CanardNodeID source_node_id) -> std::uint32_t
+{
+    return (4UL << 26U) | (1UL << 25U) | ((request ? 1UL : 0UL) << 24U) |
+           (static_cast<std::uint32_t>(service_id) << 14U) | (static_cast<std::uint32_t>(destination_node_id) << 7U) |
+           source_node_id;
+}
+
 /// An allocator that sits on top of the standard malloc() providing additional testing capabilities.
 /// It allows the user to specify the maximum amount of memory that can be allocated; further requests will emulate OOM.
 class TestAllocator
@@ -190,6 +208,37 @@ public:
                               out_subscription);
     }
 
+    /// Feeds a single-frame transfer with an empty payload and returns the subscription that accepted it, if any.
+    /// The transfer-ID is incremented with every call. The payload of the accepted transfer is freed immediately.
+    [[nodiscard]] auto rxAcceptSingleFrame(const std::uint32_t extended_can_id) -> CanardRxSubscription*
+    {
+        const auto  tail = static_cast<std::uint8_t>(0b111'00000U | (rx_transfer_id_++ & 31U));
+        CanardFrame frame{};
+        frame.extended_can_id             = extended_can_id;
+        frame.payload_size                = 1;
+        frame.payload                     = &tail;
+        CanardRxTransfer      transfer{};
+        CanardRxSubscription* subscription = reinterpret_cast<CanardRxSubscription*>(&frame);  // Ensure overwritten.
+        const auto            result       = rxAccept(100'000'000, frame, 0, transfer, &subscription);
+        if ((result != 0) && (result != 1))
+        {
+            throw std::logic_error("Unexpected result of canardRxAccept()");
+        }
+        if ((result == 1) != (subscription != nullptr))
+        {
+            throw std::logic_error("Subscription pointer inconsistent with the result of canardRxAccept()");
+        }
+        if (result == 1)
+        {
+            if (transfer.metadata.port_id != subscription->port_id)
+            {
+                throw std::logic_error("Transfer accepted by a subscription of a different port");
+            }
+            canard_.memory_free(&canard_, transfer.payload);
+        }
+        return subscription;
+    }
+
     [[nodiscard]] auto rxSubscribe(const CanardTransferKind transfer_kind,
                                    const CanardPortID       port_id,
                                    const std::size_t        extent,
@@ -240,6 +289,7 @@ private:
 
     CanardInstance canard_ = canardInit(&Instance::trampolineAllocate, &Instance::trampolineDeallocate);
     TestAllocator  allocator_;
+    std::uint8_t   rx_transfer_id_ = 0;
 };
 
 class TxQueue
@@ -252,6 +302,18 @@ public:
         que_.user_reference = this;  // This is simply to ensure it is not overwritten unexpectedly.
         checkInvariants();
     }
+    explicit TxQueue(const std::size_t capacity,
+                     const std::size_t mtu_bytes,
+                     void* const       pool_memory,
+                     const std::size_t pool_memory_size) :
+        que_(canardTxInitWithPool(capacity, mtu_bytes, pool_memory, pool_memory_size))
+    {
+        enforce(que_.user_reference == nullptr, "Incorrect initialization of the user reference in TxQueue");
+        enforce(que_.mtu_bytes == mtu_bytes, "Incorrect MTU");
+        enforce(que_.pool.used == 0, "Incorrect initialization of the pool");
+        que_.user_reference = this;
+        checkInvariants();
+    }
     virtual ~TxQueue() = default;
 
     TxQueue(const TxQueue&) = delete;
@@ -277,6 +339,47 @@ public:
         return ret;
     }
 
+    [[nodiscard]] auto pushV(CanardInstance* const                     ins,
+                             const CanardMicrosecond                   transmission_deadline_usec,
+                             const CanardTransferMetadata&             metadata,
+                             const std::vector<CanardPayloadFragment>& fragments)
+    {
+        checkInvariants();
+        const auto size_before = que_.size;
+        const auto ret =
+            canardTxPushV(&que_, ins, transmission_deadline_usec, &metadata, fragments.size(), fragments.data());
+        enforce((ret < 0) || ((size_before + static_cast<std::size_t>(ret)) == que_.size),
+                "Unexpected size change after push");
+        checkInvariants();
+        return ret;
+    }
+
+    [[nodiscard]] auto pushShared(CanardInstance* const         ins,
+                                  const CanardMicrosecond       transmission_deadline_usec,
+                                  const CanardTransferMetadata& metadata,
+                                  const size_t                  payload_size,
+                                  void* const                   payload)
+    {
+        checkInvariants();
+        const auto size_before = que_.size;
+        const auto ret = canardTxPushShared(&que_, ins, transmission_deadline_usec, &metadata, payload_size, payload);
+        enforce((ret < 0) || ((size_before + static_cast<std::size_t>(ret)) == que_.size),
+                "Unexpected size change after push");
+        checkInvariants();
+        return ret;
+    }
+
+    [[nodiscard]] auto pushMany(CanardInstance* const ins, const std::vector<CanardTxBatchItem>& items)
+    {
+        checkInvariants();
+        const auto size_before = que_.size;
+        const auto ret         = canardTxPushMany(&que_, ins, items.size(), items.data());
+        enforce((ret < 0) ? (size_before == que_.size) : ((size_before + static_cast<std::size_t>(ret)) == que_.size),
+                "Unexpected size change after batch push");
+        checkInvariants();
+        return ret;
+    }
+
     [[nodiscard]] auto peek() const -> const exposed::TxItem*
     {
         checkInvariants();
@@ -306,10 +409,40 @@ public:
         return static_cast<exposed::TxItem*>(out);  // NOLINT static downcast
     }
 
+    [[nodiscard]] auto purgeExpired(CanardInstance* const ins, const CanardMicrosecond now_usec)
+    {
+        checkInvariants();
+        checkDeadlineIndex();
+        const auto size_before = que_.size;
+        const auto ret         = canardTxPurgeExpired(&que_, ins, now_usec);
+        enforce((size_before - ret) == que_.size, "Unexpected size change after purge");
+        checkInvariants();
+        checkDeadlineIndex();
+        return ret;
+    }
+
+    [[nodiscard]] auto dropTransfer(CanardInstance* const ins, const CanardTxQueueItem* const item)
+    {
+        checkInvariants();
+        const auto size_before = que_.size;
+        const auto ret         = canardTxDropTransfer(&que_, ins, item);
+        enforce((size_before - ret) == que_.size, "Unexpected size change after drop");
+        checkInvariants();
+        checkDeadlineIndex();
+        return ret;
+    }
+
+    void free(CanardInstance* const ins, CanardTxQueueItem* const item)
+    {
+        checkInvariants();
+        canardTxFree(&que_, ins, item);
+        checkInvariants();
+    }
+
     [[nodiscard]] auto getSize() const
     {
         std::size_t out = 0;
-        traverse(que_.root, [&](auto* _) {
+        forEach([&](auto* _) {
             (void) _;
             out++;
         });
@@ -320,7 +453,7 @@ public:
     [[nodiscard]] auto linearize() const -> std::vector<const exposed::TxItem*>
     {
         std::vector<const exposed::TxItem*> out;
-        traverse(que_.root, [&](const CanardTreeNode* const item) {
+        forEach([&](const CanardTreeNode* const item) {
             out.push_back(reinterpret_cast<const exposed::TxItem*>(item));
         });
         enforce(out.size() == getSize(), "Internal error");
@@ -339,10 +472,70 @@ private:
         }
     }
 
+    /// Visits the items in the order of transmission regardless of the queue engine.
+    template <typename F>
+    void forEach(const F& fun) const
+    {
+        if (que_.engine == CanardTxQueueEngineBuckets)
+        {
+            const CanardTreeNode* first = nullptr;
+            for (std::size_t i = 0; i <= CANARD_PRIORITY_MAX; i++)
+            {
+                enforce(((que_.bucket_mask & (1U << i)) != 0) == (que_.bucket_head[i] != nullptr), "Bad bucket mask");
+                const CanardTreeNode* prev = nullptr;
+                for (const auto* item = que_.bucket_head[i]; item != nullptr; item = item->lr[1])
+                {
+                    enforce(item->lr[0] == prev, "Bucket list damaged");
+                    first = (first == nullptr) ? item : first;
+                    prev  = item;
+                    fun(item);
+                }
+                enforce(que_.bucket_tail[i] == prev, "Bucket tail damaged");
+            }
+            enforce(que_.root == first, "Bucket top damaged");
+        }
+        else
+        {
+            const CanardTreeNode* first = nullptr;
+            traverse(que_.root, [&](const CanardTreeNode* const item) {
+                first = (first == nullptr) ? item : first;
+                fun(item);
+            });
+            enforce(que_.tree_top == first, "Tree top damaged");
+        }
+    }
+
     void checkInvariants() const
     {
         enforce(que_.user_reference == this, "User reference damaged");
         enforce(que_.size == getSize(), "Size miscalculation");
+        std::array<std::size_t, CANARD_PRIORITY_MAX + 1U> size_by_priority{};
+        forEach([&](const CanardTreeNode* const item) {
+            const auto can_id = reinterpret_cast<const CanardTxQueueItem*>(item)->frame.extended_can_id;
+            size_by_priority.at((can_id >> 26U) & CANARD_PRIORITY_MAX)++;
+        });
+        enforce(std::equal(size_by_priority.begin(), size_by_priority.end(), std::begin(que_.size_by_priority)),
+                "Size per priority miscalculation");
+    }
+
+    /// This is not a part of checkInvariants() because it is slow on large queues.
+    void checkDeadlineIndex() const
+    {
+#if CANARD_TX_DEADLINE_INDEX
+        std::size_t       num_with_deadline = 0;
+        CanardMicrosecond prev_deadline     = 0;
+        traverse(que_.deadline_root, [&](const CanardTreeNode* const node) {
+            const auto* const item = reinterpret_cast<const CanardTxDeadlineNode*>(node)->owner;
+            enforce(item->tx_deadline_usec >= prev_deadline, "Deadline index ordering violated");
+            prev_deadline = item->tx_deadline_usec;
+            num_with_deadline++;
+        });
+        std::size_t num_expected = 0;
+        forEach([&](const CanardTreeNode* const node) {
+            num_expected += (reinterpret_cast<const CanardTxQueueItem*>(node)->tx_deadline_usec > 0) ? 1U : 0U;
+        });
+        enforce(num_with_deadline == num_expected, "Deadline index size mismatch");
+#endif
     }
 
     CanardTxQueue que_;
@@ -0,0 +1,506 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016 UAVCAN Development Team.
+
+// Replays a recording of real CAN traffic through the RX pipeline to reproduce production bus loads.
+// Supported inputs are the log files written by "candump -l" (one "(timestamp) interface id#data" line per frame,
+// where CAN FD frames use "id##<flags>data") and classic pcap files with the SocketCAN link type (227), such as those
+// captured by Wireshark or tcpdump on a SocketCAN interface. The interfaces are mapped to the redundant transport
+// indexes in the order of their first appearance; pcap files have only one. Standard-ID, remote, and error frames
+// are skipped because they are not UAVCAN/CAN frames.
+//
+// Every message subject seen in the recording is subscribed to; the services are subscribed to only if the local
+// node-ID is given because only the service transfers addressed to the local node are accepted. The frames are
+// accepted as fast as possible by default, or at the recorded speed if requested; the recorded timestamps are passed
+// to the library in either case. Optionally, every received transfer is published again via the TX queue, which is
+// then drained, to exercise the TX pipeline with the same traffic mix.
+//
+// The results are printed to stdout as JSON Lines: one summary object with the throughput, the transfer counts,
+// the error counters, and the behavior of the memory manager; followed by one object per subscription.
+// This is not a test: the results are not checked. The build system defines CANARD_STATS for this target.
+// Usage: replay_x64 <file> [--realtime] [--node-id N] [--extent BYTES] [--heap BYTES] [--tx MTU]
+
+#include "canard.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Record
+{
+    CanardMicrosecond         timestamp_usec  = 0U;
+    std::uint8_t              transport       = 0U;
+    std::uint32_t             extended_can_id = 0U;
+    std::vector<std::uint8_t> payload;
+};
+
+struct Recording
+{
+    std::vector<Record> records;
+    std::size_t         skipped    = 0U;  ///< Frames that are not UAVCAN/CAN frames.
+    std::size_t         transports = 0U;
+};
+
+struct Options
+{
+    std::string  path;
+    bool         realtime = false;
+    CanardNodeID node_id  = CANARD_NODE_ID_UNSET;
+    std::size_t  extent   = 1024U;
+    std::size_t  heap     = 0U;  ///< Zero means unlimited.
+    std::size_t  tx_mtu   = 0U;  ///< Zero means that the TX pipeline is not exercised.
+};
+
+constexpr std::uint32_t CANExtendedFlag = 0x8000'0000UL;
+constexpr std::uint32_t CANRemoteFlag   = 0x4000'0000UL;
+constexpr std::uint32_t CANErrorFlag    = 0x2000'0000UL;
+constexpr std::uint32_t CANExtendedMask = 0x1FFF'FFFFUL;
+
+auto parseHex(const std::string& text) -> std::uint32_t
+{
+    std::size_t         consumed = 0U;
+    const unsigned long out      = std::stoul(text, &consumed, 16);
+    if ((consumed != text.size()) || (out > 0xFFFF'FFFFUL))
+    {
+        throw std::runtime_error("Invalid hex number: " + text);
+    }
+    return static_cast<std::uint32_t>(out);
+}
+
+/// Parses one line of a candump log, e.g., "(1436509052.249713) can0 1A2B3C4D#DEADBEEF".
+void parseCandumpLine(const std::string& line, std::map<std::string, std::uint8_t>& transports, Recording& out)
+{
+    std::istringstream stream(line);
+    std::string        timestamp;
+    std::string        interface;
+    std::string        frame;
+    if (!(stream >> timestamp >> interface >> frame) || (timestamp.size() < 3U) || (timestamp.front() != '(') ||
+        (timestamp.back() != ')'))
+    {
+        throw std::runtime_error("Invalid candump line: " + line);
+    }
+    const std::size_t dot = timestamp.find('.');
+    if (dot == std::string::npos)
+    {
+        throw std::runtime_error("Invalid timestamp: " + timestamp);
+    }
+    std::string fraction = timestamp.substr(dot + 1U, timestamp.size() - dot - 2U);
+    fraction.resize(6U, '0');  // Microseconds; the extra digits are truncated.
+    const std::size_t hash = frame.find('#');
+    if (hash == std::string::npos)
+    {
+        throw std::runtime_error("Invalid frame: " + frame);
+    }
+    const std::string id   = frame.substr(0U, hash);
+    std::string       data = frame.substr(hash + 1U);
+    if ((data.size() >= 2U) && (data.front() == '#'))
+    {
+        data = data.substr(2U);  // CAN FD: skip the flags nibble.
+    }
+    const bool extended = id.size() == 8U;
+    if ((!extended) || ((!data.empty()) && ((data.front() == 'R') || (data.front() == 'r'))))
+    {
+        out.skipped++;
+        return;
+    }
+    const std::uint32_t can_id = parseHex(id);
+    if ((can_id & ~CANExtendedMask) != 0U)
+    {
+        out.skipped++;  // Error frames are logged with the error flag set.
+        return;
+    }
+    if ((data.size() % 2U) != 0U)
+    {
+        throw std::runtime_error("Invalid frame data: " + frame);
+    }
+    Record rec;
+    rec.timestamp_usec = (static_cast<CanardMicrosecond>(std::stoull(timestamp.substr(1U, dot - 1U))) * 1'000'000U) +
+                         std::stoull(fraction);
+    const auto it       = transports.emplace(interface, static_cast<std::uint8_t>(transports.size())).first;
+    rec.transport       = it->second;
+    rec.extended_can_id = can_id;
+    for (std::size_t i = 0U; i < data.size(); i += 2U)
+    {
+        rec.payload.push_back(static_cast<std::uint8_t>(parseHex(data.substr(i, 2U))));
+    }
+    out.records.push_back(rec);
+}
+
+auto loadCandump(std::istream& input) -> Recording
+{
+    Recording                           out;
+    std::map<std::string, std::uint8_t> transports;
+    std::string                         line;
+    while (std::getline(input, line))
+    {
+        if (line.find_first_not_of(" \t\r") != std::string::npos)
+        {
+            parseCandumpLine(line, transports, out);
+        }
+    }
+    out.transports = transports.size();
+    return out;
+}
+
+/// Reads an integer of the specified width; pcap headers use the byte order of the machine that wrote the file.
+auto readInteger(const std::uint8_t* const data, const std::size_t size, const bool big_endian) -> std::uint32_t
+{
+    std::uint32_t out = 0U;
+    for (std::size_t i = 0U; i < size; i++)
+    {
+        const std::size_t index = big_endian ? i : (size - 1U - i);
+        out                     = (out << 8U) | data[index];  // NOLINT pointer arithmetic
+    }
+    return out;
+}
+
+auto loadPcap(const std::vector<std::uint8_t>& file) -> Recording
+{
+    constexpr std::size_t   FileHeaderSize    = 24U;
+    constexpr std::size_t   RecordHeaderSize  = 16U;
+    constexpr std::size_t   FrameHeaderSize   = 8U;  // The SocketCAN frame header: ID, length, flags, and reserved.
+    constexpr std::uint32_t LinkTypeSocketCAN = 227U;
+    if (file.size() < FileHeaderSize)
+    {
+        throw std::runtime_error("Truncated pcap file header");
+    }
+    const std::uint32_t magic = readInteger(file.data(), 4U, true);
+    const bool          big   = (magic == 0xA1B2'C3D4UL) || (magic == 0xA1B2'3C4DUL);
+    const bool          nano  = (magic == 0xA1B2'3C4DUL) || (magic == 0x4D3C'B2A1UL);
+    if (readInteger(&file.at(20U), 4U, big) != LinkTypeSocketCAN)
+    {
+        throw std::runtime_error("Unsupported pcap link type; only SocketCAN (227) is supported");
+    }
+    Recording   out;
+    std::size_t offset = FileHeaderSize;
+    while (offset < file.size())
+    {
+        if ((offset + RecordHeaderSize) > file.size())
+        {
+            throw std::runtime_error("Truncated pcap record header");
+        }
+        const std::uint8_t* const hdr      = &file.at(offset);
+        const CanardMicrosecond   seconds  = readInteger(hdr, 4U, big);
+        const CanardMicrosecond   fraction = readInteger(&hdr[4], 4U, big);  // NOLINT pointer arithmetic
+        const std::size_t         size     = readInteger(&hdr[8], 4U, big);  // NOLINT pointer arithmetic
+        offset += RecordHeaderSize;
+        if (((offset + size) > file.size()) || (size < FrameHeaderSize))
+        {
+            throw std::runtime_error("Truncated pcap record");
+        }
+        const std::uint8_t* const frame  = &file.at(offset);
+        const std::uint32_t       can_id = readInteger(frame, 4U, true);  // Always in the network byte order.
+        const std::size_t         length = std::min<std::size_t>(frame[4], size - FrameHeaderSize);  // NOLINT
+        offset += size;
+        if (((can_id & CANExtendedFlag) == 0U) || ((can_id & (CANRemoteFlag | CANErrorFlag)) != 0U))
+        {
+            out.skipped++;
+            continue;
+        }
+        Record rec;
+        rec.timestamp_usec  = (seconds * 1'000'000U) + (nano ? (fraction / 1'000U) : fraction);
+        rec.extended_can_id = can_id & CANExtendedMask;
+        rec.payload.assign(&frame[FrameHeaderSize], &frame[FrameHeaderSize + length]);  // NOLINT pointer arithmetic
+        out.records.push_back(rec);
+    }
+    out.transports = 1U;
+    return out;
+}
+
+auto load(const std::string& path) -> Recording
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input.good())
+    {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    const std::vector<std::uint8_t> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    const std::uint32_t             magic = (file.size() >= 4U) ? readInteger(file.data(), 4U, true) : 0U;
+    if ((magic == 0xA1B2'C3D4UL) || (magic == 0xD4C3'B2A1UL) || (magic == 0xA1B2'3C4DUL) || (magic == 0x4D3C'B2A1UL))
+    {
+        return loadPcap(file);
+    }
+    std::istringstream text(std::string(file.begin(), file.end()));
+    return loadCandump(text);
+}
+
+/// Tracks the behavior of the memory manager; the heap can be limited to reproduce the out-of-memory conditions.
+struct Heap
+{
+    std::size_t   limit          = 0U;
+    std::size_t   allocated      = 0U;
+    std::size_t   peak_allocated = 0U;
+    std::uint64_t allocations    = 0U;
+    std::uint64_t frees          = 0U;
+    std::uint64_t failures       = 0U;
+};
+
+auto allocate(CanardInstance* const ins, const std::size_t amount) -> void*
+{
+    auto* const heap = static_cast<Heap*>(ins->user_reference);
+    if ((heap->limit > 0U) && ((heap->allocated + amount) > heap->limit))
+    {
+        heap->failures++;
+        return nullptr;
+    }
+    // The size is stored in front of the block to keep track of the amount of memory in use.
+    auto* const block = static_cast<std::max_align_t*>(std::malloc(amount + sizeof(std::max_align_t)));  // NOLINT
+    if (block == nullptr)
+    {
+        heap->failures++;
+        return nullptr;
+    }
+    *reinterpret_cast<std::size_t*>(block) = amount;  // NOLINT
+    heap->allocated += amount;
+    heap->peak_allocated = std::max(heap->peak_allocated, heap->allocated);
+    heap->allocations++;
+    return block + 1;  // NOLINT pointer arithmetic
+}
+
+void deallocate(CanardInstance* const ins, void* const pointer)
+{
+    if (pointer != nullptr)
+    {
+        auto* const heap  = static_cast<Heap*>(ins->user_reference);
+        auto* const block = static_cast<std::max_align_t*>(pointer) - 1;  // NOLINT pointer arithmetic
+        heap->allocated -= *reinterpret_cast<std::size_t*>(block);        // NOLINT
+        heap->frees++;
+        std::free(block);  // NOLINT
+    }
+}
+
+/// The transfer kind and the port-ID of a UAVCAN/CAN frame; see the specification, section 4.2.1.
+auto getPort(const std::uint32_t can_id) -> std::pair<CanardTransferKind, CanardPortID>
+{
+    if ((can_id & (1UL << 25U)) == 0U)
+    {
+        return {CanardTransferKindMessage, static_cast<CanardPortID>((can_id >> 8U) & CANARD_SUBJECT_ID_MAX)};
+    }
+    return {((can_id & (1UL << 24U)) != 0U) ? CanardTransferKindRequest : CanardTransferKindResponse,
+            static_cast<CanardPortID>((can_id >> 14U) & CANARD_SERVICE_ID_MAX)};
+}
+
+auto kindName(const CanardTransferKind kind) -> const char*
+{
+    switch (kind)
+    {
+    case CanardTransferKindMessage:
+        return "message";
+    case CanardTransferKindResponse:
+        return "response";
+    case CanardTransferKindRequest:
+        return "request";
+    }
+    return "?";
+}
+
+struct Port
+{
+    CanardRxSubscription subscription{};
+    std::uint64_t        transfers     = 0U;
+    std::uint64_t        payload_bytes = 0U;
+};
+
+/// Publishes the received transfer again and drains the queue. Returns the number of frames produced.
+auto republish(CanardTxQueue& que, CanardInstance& ins, const CanardRxTransfer& transfer) -> std::size_t
+{
+    CanardTransferMetadata meta = transfer.metadata;
+    if (meta.transfer_kind == CanardTransferKindMessage)
+    {
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    }
+    const std::int32_t result = canardTxPush(&que, &ins, 0U, &meta, transfer.payload_size, transfer.payload);
+    while (que.size > 0U)
+    {
+        canardTxFree(&que, &ins, canardTxPop(&que, canardTxPeek(&que)));
+    }
+    return (result > 0) ? static_cast<std::size_t>(result) : 0U;
+}
+
+auto parseOptions(const std::vector<std::string>& args) -> Options
+{
+    Options out;
+    for (std::size_t i = 1U; i < args.size(); i++)
+    {
+        const std::string& arg  = args.at(i);
+        const auto         next = [&]() -> std::size_t {
+            if ((i + 1U) >= args.size())
+            {
+                throw std::runtime_error("Missing value of " + arg);
+            }
+            return std::stoul(args.at(++i));
+        };
+        if (arg == "--realtime")
+        {
+            out.realtime = true;
+        }
+        else if (arg == "--node-id")
+        {
+            out.node_id = static_cast<CanardNodeID>(std::min<std::size_t>(next(), CANARD_NODE_ID_UNSET));
+        }
+        else if (arg == "--extent")
+        {
+            out.extent = next();
+        }
+        else if (arg == "--heap")
+        {
+            out.heap = next();
+        }
+        else if (arg == "--tx")
+        {
+            out.tx_mtu = next();
+        }
+        else if (out.path.empty())
+        {
+            out.path = arg;
+        }
+        else
+        {
+            throw std::runtime_error("Unexpected argument: " + arg);
+        }
+    }
+    if (out.path.empty())
+    {
+        throw std::runtime_error(
+            "Usage: replay <file> [--realtime] [--node-id N] [--extent BYTES] [--heap BYTES] [--tx MTU]");
+    }
+    return out;
+}
+
+auto param(const std::string& key, const std::uint64_t value) -> std::string
+{
+    return ",\"" + key + "\":" + std::to_string(value);
+}
+
+void replay(const Options& opt, const Recording& rec)
+{
+    Heap           heap;
+    CanardInstance ins = canardInit(&allocate, &deallocate);
+    ins.user_reference = &heap;
+    ins.node_id        = opt.node_id;
+    heap.limit         = opt.heap;
+    CanardTxQueue que  = canardTxInit(1'000'000U, (opt.tx_mtu > 0U) ? opt.tx_mtu : CANARD_MTU_CAN_FD);
+
+    std::map<std::pair<CanardTransferKind, CanardPortID>, Port> ports;
+    for (const auto& r : rec.records)
+    {
+        const auto key = getPort(r.extended_can_id);
+        if (((key.first == CanardTransferKindMessage) || (opt.node_id <= CANARD_NODE_ID_MAX)) &&
+            (ports.find(key) == ports.end()))
+        {
+            Port& port = ports[key];
+            (void) canardRxSubscribe(&ins, key.first, key.second, opt.extent, 2'000'000U, &port.subscription);
+        }
+    }
+
+    std::uint64_t    transfers     = 0U;
+    std::uint64_t    payload_bytes = 0U;
+    std::uint64_t    tx_frames     = 0U;
+    std::uint64_t    errors        = 0U;
+    CanardRxTransfer transfer{};
+    const auto       started = Clock::now();
+    for (const auto& r : rec.records)
+    {
+        if (opt.realtime)
+        {
+            std::this_thread::sleep_until(
+                started + std::chrono::microseconds(r.timestamp_usec - rec.records.front().timestamp_usec));
+        }
+        CanardFrame frame{};
+        frame.extended_can_id    = r.extended_can_id;
+        frame.payload_size       = r.payload.size();
+        frame.payload            = r.payload.data();
+        const std::int8_t result = canardRxAccept(&ins, r.timestamp_usec, &frame, r.transport, &transfer, nullptr);
+        if (result > 0)
+        {
+            Port& port = ports.at({transfer.metadata.transfer_kind, transfer.metadata.port_id});
+            port.transfers++;
+            port.payload_bytes += transfer.payload_size;
+            transfers++;
+            payload_bytes += transfer.payload_size;
+            if (opt.tx_mtu > 0U)
+            {
+                tx_frames += republish(que, ins, transfer);
+            }
+            ins.memory_free(&ins, transfer.payload);
+        }
+        else if (result < 0)
+        {
+            errors++;
+        }
+        else
+        {
+            (void) 0;  // The frame did not complete a transfer.
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+
+    const CanardMemoryUsage usage    = canardInstanceMemoryUsage(&ins, nullptr, 0U);
+    const CanardRxStats&    st       = ins.rx_stats;
+    const auto              rate     = [&](const double x) { return (elapsed > 0.0) ? (x / elapsed) : 0.0; };
+    const double            frames   = static_cast<double>(rec.records.size());
+    const CanardMicrosecond duration = rec.records.empty()
+                                           ? 0U
+                                           : (rec.records.back().timestamp_usec - rec.records.front().timestamp_usec);
+    const double            recorded = 1e-6 * static_cast<double>(duration);
+    std::cout << std::fixed << std::setprecision(3) << R"({"config":")" << CANARD_BENCHMARK_CONFIG
+              << R"(","benchmark":"replay")";
+    std::cout << param("frames", rec.records.size()) << param("frames_skipped", rec.skipped)
+              << param("transports", rec.transports) << param("subscriptions", ports.size());
+    std::cout << R"(,"recorded_sec":)" << recorded << R"(,"elapsed_sec":)" << elapsed << R"(,"frames_per_sec":)"
+              << rate(frames) << R"(,"transfers_per_sec":)" << rate(static_cast<double>(transfers));
+    std::cout << param("transfers", transfers) << param("payload_bytes", payload_bytes)
+              << param("accept_errors", errors) << param("tx_frames", tx_frames);
+    std::cout << param("duplicates", st.duplicates) << param("toggle_errors", st.toggle_errors)
+              << param("sot_misses", st.sot_misses) << param("crc_errors", st.crc_errors)
+              << param("truncations", st.truncations) << param("oom_errors", st.oom_errors)
+              << param("frames_malformed", ins.rx_frames_malformed) << param("frames_ignored", ins.rx_frames_ignored);
+    std::cout << param("allocations", heap.allocations) << param("frees", heap.frees)
+              << param("allocation_failures", heap.failures) << param("peak_heap_bytes", heap.peak_allocated)
+              << param("rx_sessions", usage.rx_sessions) << param("final_heap_bytes", usage.total_bytes) << "}"
+              << std::endl;
+    for (auto& [key, port] : ports)
+    {
+        const CanardRxStats& ps = port.subscription.stats;
+        std::cout << R"({"config":")" << CANARD_BENCHMARK_CONFIG << R"(","benchmark":"replay_port","kind":")"
+                  << kindName(key.first) << "\"" << param("port_id", key.second) << param("transfers", port.transfers)
+                  << param("payload_bytes", port.payload_bytes) << param("frames_accepted", ps.frames_accepted)
+                  << param("crc_errors", ps.crc_errors) << param("truncations", ps.truncations)
+                  << param("oom_errors", ps.oom_errors) << "}" << std::endl;
+        (void) canardRxUnsubscribe(&ins, key.first, key.second);
+    }
+}
+
+}  // namespace
+
+auto main(const int argc, const char* const argv[]) -> int
+{
+    try
+    {
+        const Options   opt = parseOptions(std::vector<std::string>(argv, argv + argc));
+        const Recording rec = load(opt.path);
+        replay(opt, rec);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include <optional>
 #include <numeric>
 #include <iostream>
+#include <vector>
 
 namespace
 {
@@ -1370,3 +1371,106 @@ TEST_CASE("MutationRandomized")
     }
     validate();
 }
+
+TEST_CASE("TraversalIterative")
+{
+    using N = Node<std::uint8_t>;
+    std::array<N, 256> t{};
+    for (auto i = 0U; i < 256U; i++)
+    {
+        t.at(i).value = static_cast<std::uint8_t>(i);
+    }
+    N* root = nullptr;
+    REQUIRE(nullptr == cavlNext(nullptr));
+    REQUIRE(nullptr == cavlPrev(nullptr));
+    for (std::uint32_t iteration = 0U; iteration < 1'000U; iteration++)
+    {
+        const std::uint8_t x         = getRandomByte();
+        const auto         predicate = [&](const N& v) { return x - v.value; };
+        if (N* const existing = search(&root, predicate))
+        {
+            remove(&root, existing);
+        }
+        else
+        {
+            REQUIRE(x == search(&root, predicate, [&]() -> N* { return &t.at(x); })->value);
+        }
+        // The iterative traversal shall visit the same nodes in the same order as the recursive one in both directions.
+        std::vector<const N*> expected;
+        traverse<true>(root, [&](const N* const node) { expected.push_back(node); });
+        std::vector<const N*> actual;
+        for (const Cavl* nd = (root != nullptr) ? root->min() : nullptr; nd != nullptr; nd = cavlNext(nd))
+        {
+            actual.push_back(static_cast<const N*>(nd));
+        }
+        REQUIRE(expected == actual);
+        expected.clear();
+        actual.clear();
+        traverse<false>(root, [&](const N* const node) { expected.push_back(node); });
+        for (const Cavl* nd = (root != nullptr) ? root->max() : nullptr; nd != nullptr; nd = cavlPrev(nd))
+        {
+            actual.push_back(static_cast<const N*>(nd));
+        }
+        REQUIRE(expected == actual);
+    }
+}
+
+TEST_CASE("InsertAfter")
+{
+    using N = Node<std::uint8_t>;
+    std::array<N, 256> t{};
+    for (auto i = 0U; i < 256U; i++)
+    {
+        t.at(i).value = static_cast<std::uint8_t>(i);
+    }
+    N*         root     = nullptr;
+    const auto validate = [&](const std::size_t size) {
+        REQUIRE(nullptr == findBrokenBalanceFactor(root));
+        REQUIRE(nullptr == findBrokenAncestry(root));
+        REQUIRE(size == checkAscension(root));
+    };
+    auto** const cavl_root = reinterpret_cast<Cavl**>(&root);
+    cavlInsertAfter(nullptr, &t.at(0), &t.at(1));  // No effect.
+    cavlInsertAfter(cavl_root, nullptr, &t.at(1));
+    cavlInsertAfter(cavl_root, &t.at(0), nullptr);
+    REQUIRE(nullptr == root);
+
+    // Build the skeleton of every 16th value using the regular search.
+    std::size_t size = 0;
+    for (auto i = 0U; i < 256U; i += 16U)
+    {
+        const auto predicate = [&](const N& v) { return static_cast<std::int32_t>(i) - v.value; };
+        REQUIRE(i == search(&root, predicate, [&]() -> N* { return &t.at(i); })->value);
+        validate(++size);
+    }
+    // Fill in the gaps with pre-sorted chains, each node following its predecessor.
+    // The first insertion into every gap attaches to an anchor that may have a right subtree; the rest attach to
+    // the previously inserted leaf.
+    for (auto base = 0U; base < 256U; base += 16U)
+    {
+        for (auto i = base + 1U; i < (base + 16U); i++)
+        {
+            cavlInsertAfter(cavl_root, &t.at(i - 1U), &t.at(i));
+            REQUIRE(&t.at(i) == cavlNext(&t.at(i - 1U)));
+            validate(++size);
+        }
+    }
+    REQUIRE(256U == size);
+    REQUIRE(0U == root->min()->value);
+    REQUIRE(255U == root->max()->value);
+    REQUIRE(9U >= getHeight(root));  // The AVL bound is 1.44*log2(n+2) i.e. at most 11; it is tighter in practice.
+
+    // A purely ascending bulk build from scratch.
+    root = nullptr;
+    for (auto& n : t)
+    {
+        n = Cavl{};
+    }
+    REQUIRE(0U == search(&root, [](const N& v) { return 0 - v.value; }, [&]() -> N* { return &t.at(0); })->value);
+    for (auto i = 1U; i < 256U; i++)
+    {
+        cavlInsertAfter(cavl_root, &t.at(i - 1U), &t.at(i));
+        validate(i + 1U);
+    }
+    REQUIRE(9U == getHeight(root));  // A sequential build yields a nearly perfect tree.
+}
@@ -2,7 +2,44 @@
 // Copyright (c) 2016-2020 UAVCAN Development Team.
 
 #include "exposed.hpp"
+#include "helpers.hpp"
 #include "catch.hpp"
+#include <array>
+
+#ifdef CANARD_CONFIG_HEADER
+#    include CANARD_CONFIG_HEADER
+#endif
+
+namespace
+{
+/// Bit-by-bit CRC-16/CCITT-FALSE used as the reference for all variants of the library implementation.
+auto crcReference(std::uint16_t crc, const std::size_t size, const void* const data) -> std::uint16_t
+{
+    const auto* const bytes = static_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        crc = static_cast<std::uint16_t>(crc ^ static_cast<std::uint16_t>(bytes[i] << 8U));
+        for (std::size_t k = 0; k < 8U; k++)
+        {
+            crc = static_cast<std::uint16_t>(((crc & 0x8000U) != 0U) ? ((crc << 1U) ^ 0x1021U) : (crc << 1U));
+        }
+    }
+    return crc;
+}
+}  // namespace
+
+#ifdef CANARD_CRC_HOOK
+namespace
+{
+std::size_t g_crc_hook_invocations = 0;  // NOLINT non-const global is needed to observe the hook.
+}  // namespace
+
+extern "C" auto testCRCHook(const std::uint16_t crc, const std::size_t size, const void* const data) -> std::uint16_t
+{
+    g_crc_hook_invocations++;
+    return crcReference(crc, size, data);
+}
+#endif
 
 TEST_CASE("TransferCRC")
 {
@@ -16,3 +53,47 @@ TEST_CASE("TransferCRC")
     crc = crcAdd(crc, 6, "456789");
     REQUIRE(0x29B1U == crc);
 }
+
+TEST_CASE("TransferCRCVariants")
+{
+    using exposed::crcAdd;
+    // The lengths and the alignments are chosen to exercise both the slice loop and the tail handling.
+    REQUIRE(0x29B1U == crcAdd(0xFFFFU, 9, "123456789"));
+    REQUIRE(0xFFFFU == crcAdd(0xFFFFU, 0, nullptr));
+    REQUIRE(0x1234U == crcAdd(0x1234U, 0, nullptr));
+    std::array<std::uint8_t, 300> buf{};
+    for (auto& x : buf)
+    {
+        x = static_cast<std::uint8_t>(helpers::getRandomNatural(256U));
+    }
+    for (std::size_t offset = 0; offset < 8U; offset++)
+    {
+        for (std::size_t size = 0; size <= 80U; size++)
+        {
+            const auto init = static_cast<std::uint16_t>(helpers::getRandomNatural(0x10000U));
+            REQUIRE(crcReference(init, size, &buf.at(offset)) == crcAdd(init, size, &buf.at(offset)));
+        }
+    }
+    // Incremental computation yields the same result regardless of how the data is split.
+    const auto full = crcAdd(0xFFFFU, std::size(buf), buf.data());
+    REQUIRE(full == crcReference(0xFFFFU, std::size(buf), buf.data()));
+    for (std::size_t split = 0; split <= std::size(buf); split += 7U)
+    {
+        const auto head = crcAdd(0xFFFFU, split, buf.data());
+        REQUIRE(full == crcAdd(head, std::size(buf) - split, buf.data() + split));
+    }
+    // Appending the CRC in the big-endian byte order yields the zero residue.
+    std::array<std::uint8_t, 66> frame{};
+    std::copy_n(buf.begin(), 64U, frame.begin());
+    const auto crc = crcAdd(0xFFFFU, 64U, frame.data());
+    frame.at(64)   = static_cast<std::uint8_t>(crc >> 8U);
+    frame.at(65)   = static_cast<std::uint8_t>(crc & 0xFFU);
+    REQUIRE(0x0000U == crcAdd(0xFFFFU, std::size(frame), frame.data()));
+#ifdef CANARD_CRC_HOOK
+    // The hook is used for every non-empty update.
+    const auto before = g_crc_hook_invocations;
+    REQUIRE(0x29B1U == crcAdd(0xFFFFU, 9, "123456789"));
+    REQUIRE(0xFFFFU == crcAdd(0xFFFFU, 0, nullptr));
+    REQUIRE((before + 1U) == g_crc_hook_invocations);
+#endif
+}
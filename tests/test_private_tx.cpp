@@ -174,3 +174,23 @@ TEST_CASE("txRoundFramePayloadSizeUp")
     REQUIRE(64 == txRoundFramePayloadSizeUp(50));
     REQUIRE(64 == txRoundFramePayloadSizeUp(64));
 }
+
+TEST_CASE("txRoundFramePayloadSizeDown")
+{
+    using exposed::txRoundFramePayloadSizeDown;
+    REQUIRE(0 == txRoundFramePayloadSizeDown(0));
+    REQUIRE(7 == txRoundFramePayloadSizeDown(7));
+    REQUIRE(8 == txRoundFramePayloadSizeDown(8));
+    REQUIRE(8 == txRoundFramePayloadSizeDown(9));
+    REQUIRE(8 == txRoundFramePayloadSizeDown(11));
+    REQUIRE(12 == txRoundFramePayloadSizeDown(12));
+    REQUIRE(12 == txRoundFramePayloadSizeDown(15));
+    REQUIRE(16 == txRoundFramePayloadSizeDown(16));
+    REQUIRE(20 == txRoundFramePayloadSizeDown(23));
+    REQUIRE(32 == txRoundFramePayloadSizeDown(47));
+    REQUIRE(48 == txRoundFramePayloadSizeDown(48));
+    REQUIRE(48 == txRoundFramePayloadSizeDown(63));
+    REQUIRE(64 == txRoundFramePayloadSizeDown(64));
+    REQUIRE(64 == txRoundFramePayloadSizeDown(65));
+    REQUIRE(64 == txRoundFramePayloadSizeDown(1000));
+}
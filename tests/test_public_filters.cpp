@@ -1,8 +1,10 @@
 // This software is distributed under the terms of the MIT License.
 // Copyright (c) 2016-2021 UAVCAN Development Team.
 
-#include "exposed.hpp"
+#include "helpers.hpp"
 #include "catch.hpp"
+#include <bitset>
+#include <vector>
 
 namespace
 {
@@ -14,6 +16,27 @@ constexpr std::uint32_t FLAG_SERVICE_NOT_MESSAGE = std::uint32_t(1) << 25U;
 constexpr std::uint32_t FLAG_RESERVED_23         = std::uint32_t(1) << 23U;
 constexpr std::uint32_t FLAG_RESERVED_07         = std::uint32_t(1) << 7U;
 
+constexpr std::uint32_t CAN_EXT_ID_MASK = (std::uint32_t(1) << 29U) - 1U;
+
+auto getAdmittedSpace(const CanardFilter& filter) -> std::uint64_t
+{
+    return std::uint64_t(1) << (29U - std::bitset<32>(filter.extended_mask & CAN_EXT_ID_MASK).count());
+}
+
+auto isAdmitted(const std::vector<CanardFilter>& filters, const std::uint32_t extended_can_id) -> bool
+{
+    return std::any_of(filters.begin(), filters.end(), [&](const CanardFilter& f) {
+        return (extended_can_id & f.extended_mask) == f.extended_can_id;
+    });
+}
+
+auto makeServiceID(const CanardPortID service_id, const bool request, const CanardNodeID dst) -> std::uint32_t
+{
+    return (4UL << 26U) | FLAG_SERVICE_NOT_MESSAGE | ((request ? 1UL : 0UL) << 24U) |
+           (static_cast<std::uint32_t>(service_id) << OFFSET_SERVICE_ID) |
+           (static_cast<std::uint32_t>(dst) << OFFSET_DST_NODE_ID) | 123U;
+}
+
 TEST_CASE("FilterSubject")
 {
     const std::uint16_t heartbeat_subject_id = 7509;
@@ -64,4 +87,146 @@ TEST_CASE("Consolidate")
     REQUIRE((combined.extended_mask | heartbeat_config.extended_mask) == heartbeat_config.extended_mask);
     REQUIRE((combined.extended_mask | access_config.extended_mask) == access_config.extended_mask);
 }
+
+TEST_CASE("ComputeFilters")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    // The subscriptions are not moved while in use because the vector is never resized.
+    std::vector<CanardRxSubscription> subs(250);
+    std::vector<CanardFilter>         filters(200);
+    std::size_t                       sub_index = 0U;
+    const auto subscribe = [&](const CanardTransferKind kind, const CanardPortID port_id) {
+        REQUIRE(1 == ins.rxSubscribe(kind, port_id, 16, 1'000'000, subs.at(sub_index++)));
+    };
+    const auto compute = [&](const std::size_t max_filters) -> std::int32_t {
+        filters.resize(max_filters);
+        const auto result = canardComputeFilters(&ins.getInstance(), filters.data(), max_filters);
+        filters.resize((result > 0) ? static_cast<std::size_t>(result) : 0U);
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+        return result;
+    };
+
+    // Error handling.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardComputeFilters(nullptr, filters.data(), 8U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardComputeFilters(&ins.getInstance(), nullptr, 8U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardComputeFilters(&ins.getInstance(), filters.data(), 0U));
+    REQUIRE(0 == compute(8U));
+
+    // One filter per subscription if there are enough; the request and response of the same service share one.
+    subscribe(CanardTransferKindMessage, 7509U);
+    subscribe(CanardTransferKindRequest, 384U);
+    subscribe(CanardTransferKindResponse, 384U);
+    REQUIRE(1 == compute(8U));  // The services are ignored while the local node is anonymous.
+    REQUIRE(canardMakeFilterForSubject(7509U).extended_can_id == filters.at(0).extended_can_id);
+    REQUIRE(canardMakeFilterForSubject(7509U).extended_mask == filters.at(0).extended_mask);
+    ins.setNodeID(42U);
+    REQUIRE(2 == compute(8U));
+    REQUIRE(isAdmitted(filters, helpers::makeMessageID(7509U, 123U)));
+    REQUIRE(isAdmitted(filters, makeServiceID(384U, true, 42U)));
+    REQUIRE(isAdmitted(filters, makeServiceID(384U, false, 42U)));
+    REQUIRE(!isAdmitted(filters, helpers::makeMessageID(7508U, 123U)));
+    REQUIRE(!isAdmitted(filters, makeServiceID(384U, true, 43U)));
+    REQUIRE(!isAdmitted(filters, makeServiceID(385U, true, 42U)));
+    // A single filter is the consolidation of all.
+    REQUIRE(1 == compute(1U));
+    const CanardFilter a   = canardMakeFilterForSubject(7509U);
+    const CanardFilter b   = canardMakeFilterForService(384U, 42U);
+    const CanardFilter all = canardConsolidateFilters(&a, &b);
+    REQUIRE(all.extended_can_id == filters.at(0).extended_can_id);
+    REQUIRE(all.extended_mask == filters.at(0).extended_mask);
+
+    // Two clusters of subjects that differ in two bits are separated perfectly.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 7509U));
+    for (CanardPortID i = 0U; i < 8U; i++)
+    {
+        subscribe(CanardTransferKindMessage, i);
+        subscribe(CanardTransferKindMessage, static_cast<CanardPortID>(4112U + i));
+    }
+    // The temporary buffer is needed now.
+    alloc.setAllocationCeiling(0U);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == compute(3U));
+    alloc.setAllocationCeiling(sizeof(CanardFilter) * 1000U);
+    REQUIRE(3 == compute(3U));
+    std::uint64_t subject_space = 0U;
+    for (const auto& f : filters)
+    {
+        REQUIRE(getAdmittedSpace(f) > 0U);
+        subject_space += ((f.extended_can_id & FLAG_SERVICE_NOT_MESSAGE) == 0U) ? getAdmittedSpace(f) : 0U;
+    }
+    REQUIRE(subject_space == (2U * 8U * getAdmittedSpace(canardMakeFilterForSubject(0U))));
+    REQUIRE(isAdmitted(filters, makeServiceID(384U, true, 42U)));
+    for (CanardPortID i = 0U; i < 8U; i++)
+    {
+        REQUIRE(isAdmitted(filters, helpers::makeMessageID(i, 123U)));
+        REQUIRE(isAdmitted(filters, helpers::makeMessageID(static_cast<CanardPortID>(4112U + i), 123U)));
+        REQUIRE(!isAdmitted(filters, helpers::makeMessageID(static_cast<CanardPortID>(8U + i), 123U)));
+        REQUIRE(!isAdmitted(filters, helpers::makeMessageID(static_cast<CanardPortID>(4096U + i), 123U)));
+    }
+    // Consolidation that does not admit anything extra is performed even if there are enough filters.
+    for (CanardPortID i = 0U; i < 8U; i++)
+    {
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, static_cast<CanardPortID>(4112U + i)));
+        subscribe(CanardTransferKindMessage, static_cast<CanardPortID>(4096U + i));
+    }
+    REQUIRE(compute(16U) < 17);  // There are 17 subscriptions.
+    subject_space = 0U;
+    for (const auto& f : filters)
+    {
+        subject_space += ((f.extended_can_id & FLAG_SERVICE_NOT_MESSAGE) == 0U) ? getAdmittedSpace(f) : 0U;
+    }
+    REQUIRE(subject_space == (2U * 8U * getAdmittedSpace(canardMakeFilterForSubject(0U))));
+    REQUIRE(isAdmitted(filters, makeServiceID(384U, true, 42U)));
+    for (CanardPortID i = 0U; i < 8U; i++)
+    {
+        REQUIRE(isAdmitted(filters, helpers::makeMessageID(i, 123U)));
+        REQUIRE(isAdmitted(filters, helpers::makeMessageID(static_cast<CanardPortID>(4096U + i), 123U)));
+        REQUIRE(!isAdmitted(filters, helpers::makeMessageID(static_cast<CanardPortID>(8U + i), 123U)));
+    }
+    for (CanardPortID i = 0U; i < 8U; i++)
+    {
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, i));
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, static_cast<CanardPortID>(4096U + i)));
+    }
+
+    // Many random subjects reduced to a few filters admit less than naive consolidation of neighbors by port-ID.
+    std::vector<CanardPortID> subject_ids;
+    std::uint32_t             state = 12345U;
+    while (subject_ids.size() < 150U)
+    {
+        state                   = (state * 1103515245U) + 12345U;
+        const auto subject_id   = static_cast<CanardPortID>((state >> 16U) & CANARD_SUBJECT_ID_MAX);
+        if (std::find(subject_ids.begin(), subject_ids.end(), subject_id) == subject_ids.end())
+        {
+            subject_ids.push_back(subject_id);
+            subscribe(CanardTransferKindMessage, subject_id);
+        }
+    }
+    REQUIRE(8 == compute(8U));
+    std::uint64_t optimized_space = 0U;
+    for (const auto& f : filters)
+    {
+        optimized_space += getAdmittedSpace(f);
+    }
+    for (const auto subject_id : subject_ids)
+    {
+        REQUIRE(isAdmitted(filters, helpers::makeMessageID(subject_id, 123U)));
+    }
+    REQUIRE(isAdmitted(filters, makeServiceID(384U, false, 42U)));
+    std::sort(subject_ids.begin(), subject_ids.end());
+    std::uint64_t naive_space = getAdmittedSpace(canardMakeFilterForService(384U, 42U));
+    for (std::size_t i = 0U; i < 7U; i++)
+    {
+        const std::size_t begin = (subject_ids.size() * i) / 7U;
+        const std::size_t end   = (subject_ids.size() * (i + 1U)) / 7U;
+        CanardFilter      group = canardMakeFilterForSubject(subject_ids.at(begin));
+        for (std::size_t k = begin + 1U; k < end; k++)
+        {
+            const CanardFilter next = canardMakeFilterForSubject(subject_ids.at(k));
+            group                   = canardConsolidateFilters(&group, &next);
+        }
+        naive_space += getAdmittedSpace(group);
+    }
+    REQUIRE(optimized_space < naive_space);
+}
 }  // namespace
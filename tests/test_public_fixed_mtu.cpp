@@ -0,0 +1,214 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016-2020 UAVCAN Development Team.
+
+#include "exposed.hpp"
+#include "helpers.hpp"
+#include "catch.hpp"
+#include <cstddef>
+#include <cstring>
+
+#if !CANARD_FIXED_MTU
+#    error "This test requires CANARD_FIXED_MTU"
+#endif
+
+namespace
+{
+/// Feeds the frames of the queue into the receiving instance in the order of transmission, freeing them.
+/// Returns the payload of the reassembled transfer; the transfer shall be the only one in the queue.
+/// The timestamps advance past the transfer-ID timeout so that the transfer-ID values can be reused.
+auto receive(helpers::Instance& tx_ins, helpers::TxQueue& que, helpers::Instance& rx_ins) -> std::vector<std::uint8_t>
+{
+    static CanardMicrosecond now_usec = 0;
+    now_usec += CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC * 2U;
+    std::vector<std::uint8_t> out;
+    std::size_t               accepted = 0;
+    while (const auto* const ti = que.peek())
+    {
+        REQUIRE(ti->frame.payload != nullptr);  // Always materialized eagerly.
+        REQUIRE(ti->frame.payload_size <= CANARD_FIXED_MTU);
+        CanardRxTransfer      transfer{};
+        CanardRxSubscription* sub = nullptr;
+        const auto            res = rx_ins.rxAccept(now_usec, ti->frame, 0, transfer, &sub);
+        REQUIRE(res >= 0);
+        if (res > 0)
+        {
+            const auto* const data = static_cast<const std::uint8_t*>(transfer.payload);
+            out.assign(data, data + transfer.payload_size);
+            canardRxReleasePayload(&rx_ins.getInstance(), sub, transfer.payload);
+            accepted++;
+        }
+        que.free(&tx_ins.getInstance(), que.pop(ti));
+    }
+    REQUIRE(1 == accepted);
+    return out;
+}
+}  // namespace
+
+TEST_CASE("TxFixedMTU")
+{
+    helpers::Instance ins;
+    helpers::Instance rx;
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    CanardRxSubscription sub{};
+    REQUIRE(1 == rx.rxSubscribe(CanardTransferKindMessage, 321, 1024, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, sub));
+
+    std::array<std::uint8_t, 1024> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>((i * 7U) & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 321;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 0;
+
+    // The MTU of the queue is ignored; every item takes the same amount of memory regardless of the frame size.
+    for (const auto mtu : {std::size_t{0}, std::size_t{CANARD_MTU_CAN_CLASSIC}, std::size_t{CANARD_MTU_CAN_FD}})
+    {
+        for (const std::size_t size : {0U, 1U, 6U, 7U, 8U, 12U, 13U, 62U, 63U, 64U, 100U, 500U, 1024U})
+        {
+            helpers::TxQueue que(1000, mtu);
+            const auto       num_frames = que.push(&ins.getInstance(), 1'000, meta, size, payload.data());
+            REQUIRE(num_frames > 0);
+            REQUIRE(static_cast<std::size_t>(num_frames) == que.getSize());
+            REQUIRE(static_cast<std::size_t>(num_frames) == alloc.getNumAllocatedFragments());
+            REQUIRE((static_cast<std::size_t>(num_frames) * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)) ==
+                    alloc.getTotalAllocatedAmount());
+            // The frame layout is the same as with the run-time MTU.
+            const auto expected_frames = (size < CANARD_FIXED_MTU)
+                                             ? 1U
+                                             : (((size + 2U) + (CANARD_FIXED_MTU - 2U)) / (CANARD_FIXED_MTU - 1U));
+            REQUIRE(expected_frames == static_cast<std::size_t>(num_frames));
+            for (const auto* const ti : que.linearize())
+            {
+                REQUIRE(CanardCANDLCToLength[CanardCANLengthToDLC[ti->frame.payload_size]] == ti->frame.payload_size);
+            }
+            // The padding is received as part of the payload; there is none in the Classic CAN build.
+            const auto out = receive(ins, que, rx);
+            REQUIRE(out.size() >= size);
+            REQUIRE(((CANARD_FIXED_MTU != CANARD_MTU_CAN_CLASSIC) || (out.size() == size)));
+            REQUIRE(std::equal(payload.begin(), payload.begin() + size, out.begin()));
+            REQUIRE(0 == alloc.getNumAllocatedFragments());
+            meta.transfer_id = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        }
+    }
+
+    // The shared payloads are copied into the frames rather than referenced.
+    {
+        helpers::TxQueue que(1000, CANARD_MTU_CAN_FD);
+        auto* const      shared = canardTxAllocatePayload(&ins.getInstance(), 500);
+        REQUIRE(shared != nullptr);
+        std::memcpy(shared, payload.data(), 500);
+        const auto num_frames = que.pushShared(&ins.getInstance(), 1'000, meta, 500, shared);
+        REQUIRE(num_frames > 1);
+        canardTxReleasePayload(&ins.getInstance(), shared);
+        REQUIRE(static_cast<std::size_t>(num_frames) == alloc.getNumAllocatedFragments());
+        REQUIRE((static_cast<std::size_t>(num_frames) * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)) ==
+                alloc.getTotalAllocatedAmount());
+        const auto out = receive(ins, que, rx);
+        REQUIRE(out.size() >= 500);
+        REQUIRE(std::equal(payload.begin(), payload.begin() + 500, out.begin()));
+        meta.transfer_id = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+    }
+
+    // The redundant queues do not allocate the shared block either.
+    {
+        helpers::TxQueue     que_a(1000, CANARD_MTU_CAN_CLASSIC);
+        helpers::TxQueue     que_b(1000, CANARD_MTU_CAN_FD);
+        CanardTxQueue* const ques[] = {&que_a.getInstance(), &que_b.getInstance()};
+        int32_t              results[2]{};
+        REQUIRE(2 == canardTxPushRedundantShared(&ques[0],  //
+                                                 2,
+                                                 &ins.getInstance(),
+                                                 1'000,
+                                                 &meta,
+                                                 200,
+                                                 payload.data(),
+                                                 &results[0]));
+        REQUIRE(results[0] == results[1]);
+        REQUIRE((static_cast<std::size_t>(results[0]) * 2U) == alloc.getNumAllocatedFragments());
+        REQUIRE((static_cast<std::size_t>(results[0]) * 2U * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)) ==
+                alloc.getTotalAllocatedAmount());
+        REQUIRE(receive(ins, que_a, rx).size() >= 200);
+        while (const auto* const ti = que_b.peek())
+        {
+            que_b.free(&ins.getInstance(), que_b.pop(ti));
+        }
+    }
+
+    // The memory planning helpers agree with the actual allocations regardless of the MTU argument.
+    REQUIRE(canardTxQueueWorstCaseBytes(10, CANARD_MTU_CAN_CLASSIC) == (10U * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)));
+    REQUIRE(canardTxQueueWorstCaseBytes(10, CANARD_MTU_CAN_FD) == (10U * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("TxFixedMTUPool")
+{
+    helpers::Instance ins;
+    helpers::Instance rx;
+    ins.setNodeID(42);
+
+    CanardRxSubscription sub{};
+    REQUIRE(1 == rx.rxSubscribe(CanardTransferKindMessage, 321, 1024, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, sub));
+
+    std::array<std::uint8_t, 300> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 321;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 0;
+
+    // The pool blocks have the same size regardless of the MTU argument, so the capacity is known at compile time.
+    constexpr std::size_t Capacity = 50;
+    alignas(std::max_align_t) std::array<std::uint8_t, Capacity * CANARD_TX_ITEM_SIZE(CANARD_FIXED_MTU)> arena{};
+    helpers::TxQueue que(1000, CANARD_MTU_CAN_CLASSIC, arena.data(), arena.size());
+    REQUIRE(Capacity == que.getInstance().pool.capacity);
+    const auto num_frames = que.push(&ins.getInstance(), 1'000, meta, payload.size(), payload.data());
+    REQUIRE(num_frames > 0);
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+    const auto out = receive(ins, que, rx);
+    REQUIRE(out.size() >= payload.size());
+    REQUIRE(std::equal(payload.begin(), payload.end(), out.begin()));
+    REQUIRE(0 == que.getInstance().pool.used);
+}
+
+TEST_CASE("RxFixedMTU")
+{
+    helpers::Instance ins;
+
+    CanardRxSubscription sub{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 321, 100, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, sub));
+
+    std::array<std::uint8_t, CANARD_FIXED_MTU + 4U> data{};
+    CanardFrame                                     frame{};
+    frame.extended_can_id = 0x1061'412AUL;  // Message 321 from node 42.
+    frame.payload         = data.data();
+
+    // A single-frame transfer that fits into the fixed MTU is accepted.
+    frame.payload_size             = CANARD_FIXED_MTU;
+    data.at(CANARD_FIXED_MTU - 1U) = 0b1110'0000U;  // SOT, EOT, toggle, transfer-ID 0.
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription* out_sub = nullptr;
+    REQUIRE(1 == ins.rxAccept(1'000, frame, 0, transfer, &out_sub));
+    REQUIRE(&sub == out_sub);
+    REQUIRE(transfer.payload_size == (CANARD_FIXED_MTU - 1U));
+    canardRxReleasePayload(&ins.getInstance(), out_sub, transfer.payload);
+    const auto fragments = ins.getAllocator().getNumAllocatedFragments();  // The session is retained.
+
+    // A longer frame cannot be produced by the transport, so it is discarded as malformed.
+    frame.payload_size        = data.size();
+    data.at(data.size() - 1U) = 0b1110'0001U;  // SOT, EOT, toggle, transfer-ID 1.
+    REQUIRE(0 == ins.rxAccept(2'000, frame, 0, transfer, &out_sub));
+    REQUIRE(fragments == ins.getAllocator().getNumAllocatedFragments());
+}
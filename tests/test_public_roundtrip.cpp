@@ -2,7 +2,6 @@
 // Copyright (c) 2016-2020 UAVCAN Development Team.
 
 #include "helpers.hpp"
-#include "exposed.hpp"
 #include "catch.hpp"
 #include <array>
 #include <atomic>
@@ -52,7 +51,7 @@ TEST_CASE("RoundtripSimple")
                                         CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC,
                                         s.subscription));
         // The true worst case is 128 times larger, but there is only one transmitting node.
-        rx_worst_case_memory_consumption += sizeof(exposed::RxSession) + s.extent;
+        rx_worst_case_memory_consumption += canardRxSubscriptionWorstCaseBytes(s.extent, 1);
     }
     ins_rx.getAllocator().setAllocationCeiling(rx_worst_case_memory_consumption);  // This is guaranteed to be enough.
 
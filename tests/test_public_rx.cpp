@@ -4,7 +4,9 @@
 #include "exposed.hpp"
 #include "helpers.hpp"
 #include "catch.hpp"
+#include <atomic>
 #include <cstring>
+#include <thread>
 
 // clang-tidy mistakenly suggests to avoid C arrays here, which is clearly an error
 template <typename P, std::size_t N>
@@ -331,3 +333,1258 @@ TEST_CASE("RxSubscriptionErrors")
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAccept(&ins.getInstance(), 0, &frame, 0, nullptr, nullptr));
     REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAccept(nullptr, 0, nullptr, 0, nullptr, nullptr));
 }
+
+TEST_CASE("RxLookup")
+{
+    using helpers::Instance;
+
+    Instance       ins;
+    auto&          alloc = ins.getAllocator();
+    CanardRxLookup lookup{};
+    ins.setNodeID(42);
+
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetLookup(nullptr, &lookup));
+    REQUIRE(nullptr == ins.getInstance().rx_lookup);
+    REQUIRE(0 == canardRxSetLookup(&ins.getInstance(), &lookup));
+    REQUIRE(&lookup == ins.getInstance().rx_lookup);
+
+    // The subject pages are allocated on demand, the services do not require memory.
+    std::array<CanardRxSubscription, 8> subs{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(0)));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 16, 1'000'000, subs.at(1)));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());  // Same page.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, CANARD_SUBJECT_ID_MAX, 16, 1'000'000, subs.at(2)));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 0, 16, 1'000'000, subs.at(3)));
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 9000, 16, 1'000'000, subs.at(4)));  // Not indexed.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindRequest, CANARD_SERVICE_ID_MAX, 16, 1'000'000, subs.at(5)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindResponse, 0, 16, 1'000'000, subs.at(6)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindRequest, 600, 16, 1'000'000, subs.at(7)));  // Not indexed.
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(5 == ins.getMessageSubs().size());
+    REQUIRE(2 == ins.getRequestSubs().size());
+    REQUIRE(1 == ins.getResponseSubs().size());
+
+    // The lookup table cannot be changed while there are subscriptions.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetLookup(&ins.getInstance(), nullptr));
+    REQUIRE(&lookup == ins.getInstance().rx_lookup);
+
+    // Matching subscriptions are found.
+    REQUIRE(&subs.at(0) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1001, 11)));
+    REQUIRE(&subs.at(2) == ins.rxAcceptSingleFrame(helpers::makeMessageID(CANARD_SUBJECT_ID_MAX, 11)));
+    REQUIRE(&subs.at(3) == ins.rxAcceptSingleFrame(helpers::makeMessageID(0, 11)));
+    REQUIRE(&subs.at(5) == ins.rxAcceptSingleFrame(helpers::makeServiceID(CANARD_SERVICE_ID_MAX, true, 42, 11)));
+    REQUIRE(&subs.at(6) == ins.rxAcceptSingleFrame(helpers::makeServiceID(0, false, 42, 11)));
+    // Non-matching frames are rejected.
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(1002, 11)));  // Allocated page, no subscription.
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(5000, 11)));  // Unallocated page.
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(CANARD_SERVICE_ID_MAX, false, 42, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(0, true, 42, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(1, false, 42, 11)));
+
+    // Replacement of an existing subscription keeps it indexed.
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(0)));
+    REQUIRE(&subs.at(0) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+
+    // The pages are deallocated when they become empty.
+    const auto fragments = alloc.getNumAllocatedFragments();
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));  // Frees the session as well.
+    REQUIRE((fragments - 1) == alloc.getNumAllocatedFragments());
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1001, 11)));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));  // The session and the page.
+    REQUIRE((fragments - 3) == alloc.getNumAllocatedFragments());
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(1001, 11)));
+    REQUIRE(0 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+
+    // Out of memory: the page cannot be allocated, so the subscription is not created.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(0)));
+    REQUIRE(3 == ins.getMessageSubs().size());
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 0, 16, 1'000'000, subs.at(3)));  // The page exists.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindResponse, 100, 16, 1'000'000, subs.at(1)));
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // Remove everything, then disable the lookup table.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 0));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, CANARD_SUBJECT_ID_MAX));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 9000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindRequest, CANARD_SERVICE_ID_MAX));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindRequest, 600));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindResponse, 0));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindResponse, 100));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == canardRxSetLookup(&ins.getInstance(), nullptr));
+    REQUIRE(nullptr == ins.getInstance().rx_lookup);
+
+    // The tree is used again.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(0)));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(&subs.at(0) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxIndex")
+{
+    using helpers::Instance;
+
+    Instance      ins;
+    auto&         alloc = ins.getAllocator();
+    CanardRxIndex index{};
+    ins.setNodeID(42);
+
+    const auto check_sorted = [&]() {
+        for (std::size_t i = 1; i < index.size; i++)
+        {
+            REQUIRE(index.keys[i - 1] < index.keys[i]);
+        }
+    };
+
+    // The storage fits exactly 6 entries; the remainder is not used.
+    alignas(std::max_align_t) std::array<std::uint8_t, (6 * (sizeof(void*) + 4)) + 3> storage{};
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetIndex(nullptr, &index, storage.data(), storage.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetIndex(&ins.getInstance(), &index, nullptr, storage.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetIndex(&ins.getInstance(), &index, storage.data(), 11));
+    REQUIRE(nullptr == ins.getInstance().rx_index);
+    REQUIRE(0 == canardRxSetIndex(&ins.getInstance(), &index, storage.data(), storage.size()));
+    REQUIRE(&index == ins.getInstance().rx_index);
+    REQUIRE(6 == index.capacity);
+    REQUIRE(0 == index.size);
+
+    // The entries are kept sorted regardless of the order of subscription; no memory is allocated.
+    std::array<CanardRxSubscription, 8> subs{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindRequest, 100, 16, 1'000'000, subs.at(0)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(1)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 0, 16, 1'000'000, subs.at(2)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindResponse, 100, 16, 1'000'000, subs.at(3)));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, CANARD_SUBJECT_ID_MAX, 16, 1'000'000, subs.at(4)));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(5 == index.size);
+    check_sorted();
+    REQUIRE(&subs.at(2) == index.subscriptions[0]);
+    REQUIRE(&subs.at(0) == index.subscriptions[4]);
+
+    // The index cannot be changed while there are subscriptions.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetIndex(&ins.getInstance(), nullptr, nullptr, 0));
+    REQUIRE(&index == ins.getInstance().rx_index);
+
+    // Matching subscriptions are found; the transfer kinds are not confused.
+    REQUIRE(&subs.at(0) == ins.rxAcceptSingleFrame(helpers::makeServiceID(100, true, 42, 11)));
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(&subs.at(2) == ins.rxAcceptSingleFrame(helpers::makeMessageID(0, 11)));
+    REQUIRE(&subs.at(3) == ins.rxAcceptSingleFrame(helpers::makeServiceID(100, false, 42, 11)));
+    REQUIRE(&subs.at(4) == ins.rxAcceptSingleFrame(helpers::makeMessageID(CANARD_SUBJECT_ID_MAX, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(100, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(999, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(101, true, 42, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(0, false, 42, 11)));
+
+    // Replacement of an existing subscription keeps it indexed once.
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(1)));
+    REQUIRE(5 == index.size);
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+
+    // The index is full after one more subscription; the next one is rejected.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 500, 16, 1'000'000, subs.at(5)));
+    REQUIRE(6 == index.size);
+    check_sorted();
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxSubscribe(CanardTransferKindMessage, 501, 16, 1'000'000, subs.at(6)));
+    REQUIRE(6 == index.size);
+    REQUIRE(6 == ins.getMessageSubs().size() + ins.getRequestSubs().size() + ins.getResponseSubs().size());
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(501, 11)));
+    REQUIRE(&subs.at(5) == ins.rxAcceptSingleFrame(helpers::makeMessageID(500, 11)));
+
+    // Removal from the middle and from the ends.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 500));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 0));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindRequest, 100));
+    REQUIRE(0 == ins.rxUnsubscribe(CanardTransferKindRequest, 100));
+    REQUIRE(3 == index.size);
+    check_sorted();
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(500, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeMessageID(0, 11)));
+    REQUIRE(nullptr == ins.rxAcceptSingleFrame(helpers::makeServiceID(100, true, 42, 11)));
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(&subs.at(3) == ins.rxAcceptSingleFrame(helpers::makeServiceID(100, false, 42, 11)));
+    REQUIRE(&subs.at(4) == ins.rxAcceptSingleFrame(helpers::makeMessageID(CANARD_SUBJECT_ID_MAX, 11)));
+
+    // When the lookup table is enabled as well, both are maintained; a failure of either leaves neither populated.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindResponse, 100));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, CANARD_SUBJECT_ID_MAX));
+    REQUIRE(0 == index.size);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    CanardRxLookup lookup{};
+    REQUIRE(0 == canardRxSetLookup(&ins.getInstance(), &lookup));
+    alloc.setAllocationCeiling(0);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(1)));
+    REQUIRE(0 == index.size);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(1)));
+    REQUIRE(1 == index.size);
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == index.size);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == canardRxSetLookup(&ins.getInstance(), nullptr));
+
+    // Disable the index; the tree is used again.
+    REQUIRE(0 == canardRxSetIndex(&ins.getInstance(), nullptr, nullptr, 0));
+    REQUIRE(nullptr == ins.getInstance().rx_index);
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, subs.at(1)));
+    REQUIRE(&subs.at(1) == ins.rxAcceptSingleFrame(helpers::makeMessageID(1000, 11)));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxAcceptMany")
+{
+    using helpers::Instance;
+
+    Instance ins;
+    auto&    alloc = ins.getAllocator();
+    ins.setNodeID(42);
+    CanardRxSubscription sub_msg{};
+    CanardRxSubscription sub_req{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 64, 1'000'000, sub_msg));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindRequest, 10, 16, 1'000'000, sub_req));
+
+    // The frames are generated by the TX pipeline of a remote node.
+    Instance         remote;
+    helpers::TxQueue que(100, CANARD_MTU_CAN_CLASSIC);
+    remote.setNodeID(11);
+    std::array<std::uint8_t, 30> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i + 1U);
+    }
+    std::vector<std::vector<std::uint8_t>> storage;
+    std::vector<CanardRxBatchItem>         frames;
+    const auto push = [&](const CanardTransferKind kind,
+                          const CanardPortID       port_id,
+                          const CanardNodeID       remote_node_id,
+                          const std::size_t        payload_size) {
+        CanardTransferMetadata meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = kind;
+        meta.port_id        = port_id;
+        meta.remote_node_id = remote_node_id;
+        meta.transfer_id    = 0;
+        REQUIRE(0 < que.push(&remote.getInstance(), 0, meta, payload_size, payload.data()));
+        // The frames of the transfer are enqueued at the same priority after the others, so they are popped in order.
+        while (const auto* const ti = que.peek())
+        {
+            const auto* const data = static_cast<const std::uint8_t*>(ti->frame.payload);
+            storage.emplace_back(data, data + ti->frame.payload_size);
+            CanardRxBatchItem item{};
+            item.timestamp_usec        = 1'000'000 + frames.size();
+            item.frame.extended_can_id = ti->frame.extended_can_id;
+            item.frame.payload_size    = ti->frame.payload_size;
+            frames.push_back(item);
+            que.free(&remote.getInstance(), que.pop(ti));
+        }
+    };
+    push(CanardTransferKindMessage, 1000, CANARD_NODE_ID_UNSET, 30);  // 0..4: five frames.
+    push(CanardTransferKindRequest, 10, 42, 3);                       // 5: completes a transfer.
+    push(CanardTransferKindMessage, 2000, CANARD_NODE_ID_UNSET, 3);   // 6: no subscription.
+    push(CanardTransferKindRequest, 10, 43, 3);                       // 7: mis-addressed.
+    push(CanardTransferKindMessage, 1000, CANARD_NODE_ID_UNSET, 5);   // 8: a duplicate transfer-ID, ignored.
+    storage.emplace_back();                                           // 9: an invalid frame is ignored.
+    frames.push_back(CanardRxBatchItem{0, CanardFrame{0, 1, nullptr}});
+    for (std::size_t i = 0; i < (frames.size() - 1U); i++)
+    {
+        frames.at(i).frame.payload = storage.at(i).data();
+    }
+    REQUIRE(10 == frames.size());
+
+    std::array<CanardRxTransfer, 10>      transfers{};
+    std::array<CanardRxSubscription*, 10> subscriptions{};
+    std::size_t                           consumed = 0;
+    const auto accept = [&](const std::size_t offset, const std::size_t count, const std::size_t capacity) {
+        return canardRxAcceptMany(&ins.getInstance(),
+                                  2,
+                                  count,
+                                  &frames.at(offset),
+                                  capacity,
+                                  transfers.data(),
+                                  subscriptions.data(),
+                                  &consumed);
+    };
+    const auto free_payloads = [&](const std::size_t count) {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ins.getInstance().memory_free(&ins.getInstance(), transfers.at(i).payload);
+        }
+    };
+
+    // Out of memory: the first frame cannot be accepted, so nothing is consumed.
+    alloc.setAllocationCeiling(0);
+    REQUIRE(0 == accept(0, frames.size(), transfers.size()));
+    REQUIRE(0 == consumed);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // The output array is full after the first transfer.
+    REQUIRE(1 == accept(0, frames.size(), 1));
+    REQUIRE(5 == consumed);
+    REQUIRE(&sub_msg == subscriptions.at(0));
+    REQUIRE(CanardTransferKindMessage == transfers.at(0).metadata.transfer_kind);
+    REQUIRE(1000 == transfers.at(0).metadata.port_id);
+    REQUIRE(11 == transfers.at(0).metadata.remote_node_id);
+    REQUIRE(1'000'000 == transfers.at(0).timestamp_usec);
+    REQUIRE(30 == transfers.at(0).payload_size);
+    REQUIRE(0 == std::memcmp(transfers.at(0).payload, payload.data(), 30));
+    free_payloads(1);
+
+    // Process the rest.
+    REQUIRE(1 == accept(5, frames.size() - 5, transfers.size()));
+    REQUIRE(5 == consumed);
+    REQUIRE(&sub_req == subscriptions.at(0));
+    REQUIRE(CanardTransferKindRequest == transfers.at(0).metadata.transfer_kind);
+    REQUIRE(10 == transfers.at(0).metadata.port_id);
+    REQUIRE(11 == transfers.at(0).metadata.remote_node_id);
+    REQUIRE(3 == transfers.at(0).payload_size);
+    REQUIRE(0 == std::memcmp(transfers.at(0).payload, payload.data(), 3));
+    free_payloads(1);
+
+    // Replaying the batch yields nothing because the transfer-IDs are not new.
+    REQUIRE(0 == accept(0, frames.size(), transfers.size()));
+    REQUIRE(frames.size() == consumed);
+
+    // Out of memory in an existing session: the frame is not consumed, but it is lost nonetheless because the session
+    // has advanced to the next transfer-ID; resubmitting it yields nothing.
+    CanardRxBatchItem late = frames.at(5);
+    late.timestamp_usec += 10'000'000;  // The transfer-ID timeout has expired, so the transfer is new.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(0 == canardRxAcceptMany(&ins.getInstance(), 2, 1, &late, 1, transfers.data(), nullptr, &consumed));
+    REQUIRE(0 == consumed);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(0 == canardRxAcceptMany(&ins.getInstance(), 2, 1, &late, 1, transfers.data(), nullptr, &consumed));
+    REQUIRE(1 == consumed);
+
+    // Empty batches and empty outputs.
+    REQUIRE(0 == canardRxAcceptMany(&ins.getInstance(), 0, 0, nullptr, 0, nullptr, nullptr, &consumed));
+    REQUIRE(0 == consumed);
+    REQUIRE(0 == canardRxAcceptMany(&ins.getInstance(), 0, frames.size(), frames.data(), 0, nullptr, nullptr, nullptr));
+    consumed = 123;
+    REQUIRE(0 == accept(0, frames.size(), 0));
+    REQUIRE(0 == consumed);
+
+    // Error handling.
+    auto& i = ins.getInstance();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAcceptMany(nullptr, 0, 0, nullptr, 0, nullptr, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxAcceptMany(&i, 0, 1, nullptr, 1, transfers.data(), nullptr, nullptr));
+    consumed = 123;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxAcceptMany(&i, 0, 1, frames.data(), 1, nullptr, nullptr, &consumed));
+    REQUIRE(0 == consumed);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindRequest, 10));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxCleanup")
+{
+    using helpers::Instance;
+
+    Instance             ins;
+    auto&                alloc = ins.getAllocator();
+    CanardRxTransfer     transfer{};
+    CanardRxSubscription sub_slow{};
+    CanardRxSubscription sub_fast{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub_slow));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 16, 100'000, sub_fast));
+
+    // Accepts a single-frame transfer or a frame of a multi-frame transfer; the payload is freed immediately.
+    std::array<std::uint8_t, 8> payload{};
+    const auto accept = [&](const CanardMicrosecond timestamp_usec,
+                            const CanardPortID      subject_id,
+                            const CanardNodeID      source_node_id,
+                            const std::uint8_t      tail) -> std::int8_t {
+        CanardRxSubscription* subscription = nullptr;
+        CanardFrame           frame{};
+        payload.at(7U)        = tail;
+        frame.extended_can_id = helpers::makeMessageID(subject_id, source_node_id);
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        const auto result     = ins.rxAccept(timestamp_usec, frame, 0, transfer, &subscription);
+        if (result == 1)
+        {
+            ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+        }
+        return result;
+    };
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxCleanup(nullptr, 0));
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 0));
+
+    // Two sessions on the slow subscription, one of which holds an incomplete transfer; one on the fast one.
+    REQUIRE(1 == accept(10'000'000, 1000, 1, 0b111'00000U));
+    REQUIRE(0 == accept(10'000'000, 1000, 2, 0b101'00000U));
+    REQUIRE(1 == accept(10'050'000, 1001, 3, 0b111'00000U));
+    REQUIRE(4 == alloc.getNumAllocatedFragments());  // Three sessions and one payload buffer.
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 10'500'000));
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 11'000'000));  // The timeout has not been exceeded yet.
+    REQUIRE(4 == alloc.getNumAllocatedFragments());
+    REQUIRE(3 == canardRxCleanup(&ins.getInstance(), 11'000'001));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(ensureAllNullptr(sub_slow.sessions));
+    REQUIRE(ensureAllNullptr(sub_fast.sessions));
+    REQUIRE(nullptr == ins.getInstance().rx_sessions_oldest);
+    REQUIRE(nullptr == ins.getInstance().rx_sessions_newest);
+    // The last frame of the reclaimed incomplete transfer is dropped as it would have been without the cleanup.
+    REQUIRE(0 == accept(11'000'002, 1000, 2, 0b010'00000U));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The scan stops at the first session that is not stale, so a stale session with a shorter timeout may linger.
+    REQUIRE(1 == accept(20'000'000, 1000, 1, 0b111'00001U));
+    REQUIRE(1 == accept(20'100'000, 1001, 3, 0b111'00001U));
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 20'300'000));
+    REQUIRE(sub_fast.sessions[3] != nullptr);
+    REQUIRE(2 == canardRxCleanup(&ins.getInstance(), 21'000'001));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // A new transfer moves the session to the end of the list; duplicates and continuations do not.
+    REQUIRE(1 == accept(30'000'000, 1000, 1, 0b111'00010U));
+    REQUIRE(1 == accept(30'500'000, 1000, 2, 0b111'00010U));
+    REQUIRE(0 == accept(30'600'000, 1000, 1, 0b111'00010U));  // Duplicate.
+    REQUIRE(1 == canardRxCleanup(&ins.getInstance(), 31'100'000));
+    REQUIRE(sub_slow.sessions[1] == nullptr);
+    REQUIRE(sub_slow.sessions[2] != nullptr);
+    REQUIRE(1 == accept(31'200'000, 1000, 1, 0b111'00011U));
+    REQUIRE(1 == accept(31'400'000, 1000, 2, 0b111'00011U));
+    REQUIRE(1 == accept(31'450'000, 1000, 1, 0b111'00100U));
+    REQUIRE(1 == canardRxCleanup(&ins.getInstance(), 32'420'000));
+    REQUIRE(sub_slow.sessions[1] != nullptr);
+    REQUIRE(sub_slow.sessions[2] == nullptr);
+
+    // Unsubscription removes the sessions from the list.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(nullptr == ins.getInstance().rx_sessions_oldest);
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 100'000'000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxBorrowSingleFrame")
+{
+    using helpers::Instance;
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription  sub_borrow{};
+    CanardRxSubscription  sub_copy{};
+    CanardRxSubscription* subscription = nullptr;
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 4, 1'000'000, sub_borrow));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 4, 1'000'000, sub_copy));
+    REQUIRE(!sub_borrow.borrow_single_frame);
+    sub_borrow.borrow_single_frame = true;
+
+    std::vector<std::uint8_t> frame_payload;
+    const auto accept = [&](const CanardPortID               subject_id,
+                            const CanardNodeID               source_node_id,
+                            const std::vector<std::uint8_t>& payload,
+                            const std::uint8_t               tail) -> std::int8_t {
+        frame_payload = payload;
+        frame_payload.push_back(tail);
+        CanardFrame frame{};
+        frame.extended_can_id = (source_node_id > CANARD_NODE_ID_MAX)
+                                    ? ((1UL << 24U) | helpers::makeMessageID(subject_id, 0x55U))
+                                    : helpers::makeMessageID(subject_id, source_node_id);
+        frame.payload_size = frame_payload.size();
+        frame.payload      = frame_payload.data();
+        return ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+    };
+
+    // The payload is a view into the frame; the implicit truncation rule is applied. Only the session is allocated.
+    REQUIRE(1 == accept(1000, 5, {1, 2, 3, 4, 5, 6}, 0b111'00000U));
+    REQUIRE(&sub_borrow == subscription);
+    REQUIRE(transfer.payload_borrowed);
+    REQUIRE(transfer.payload == frame_payload.data());
+    REQUIRE(4 == transfer.payload_size);
+    REQUIRE(5 == transfer.metadata.remote_node_id);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == accept(1000, 5, {7, 8}, 0b111'00001U));
+    REQUIRE(transfer.payload_borrowed);
+    REQUIRE(2 == transfer.payload_size);
+    REQUIRE(0 == accept(1000, 5, {7, 8}, 0b111'00001U));  // Duplicates are still rejected.
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // Anonymous transfers are borrowed as well.
+    REQUIRE(1 == accept(1000, CANARD_NODE_ID_UNSET, {9}, 0b111'00000U));
+    REQUIRE(transfer.payload_borrowed);
+    REQUIRE(transfer.payload == frame_payload.data());
+    REQUIRE(1 == transfer.payload_size);
+    REQUIRE(CANARD_NODE_ID_UNSET == transfer.metadata.remote_node_id);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // A single-frame transfer that supersedes an incomplete multi-frame one releases its buffer.
+    REQUIRE(0 == accept(1000, 5, {1, 2, 3, 4, 5, 6, 7}, 0b101'00011U));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == accept(1000, 5, {3}, 0b111'01010U));
+    REQUIRE(transfer.payload_borrowed);
+    REQUIRE(transfer.payload == frame_payload.data());
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // Multi-frame transfers are reassembled into an allocated buffer as usual.
+    const std::vector<std::uint8_t> mf_payload{1, 2, 3, 4, 5, 6, 7};
+    std::uint16_t                   crc = 0xFFFFU;  // CRC-16/CCITT-FALSE
+    for (const auto x : mf_payload)
+    {
+        crc = static_cast<std::uint16_t>(crc ^ static_cast<std::uint16_t>(x << 8U));
+        for (auto i = 0; i < 8; i++)
+        {
+            crc = static_cast<std::uint16_t>(((crc & 0x8000U) != 0U) ? ((crc << 1U) ^ 0x1021U) : (crc << 1U));
+        }
+    }
+    REQUIRE(0 == accept(1000, 5, mf_payload, 0b101'00100U));
+    const std::vector<std::uint8_t> mf_crc{static_cast<std::uint8_t>(crc >> 8U), static_cast<std::uint8_t>(crc)};
+    REQUIRE(1 == accept(1000, 5, mf_crc, 0b010'00100U));
+    REQUIRE(!transfer.payload_borrowed);
+    REQUIRE(4 == transfer.payload_size);
+    REQUIRE(0 == std::memcmp(transfer.payload, mf_payload.data(), 4));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+
+    // The subscriptions that do not borrow are not affected.
+    REQUIRE(1 == accept(1001, 5, {1, 2}, 0b111'00000U));
+    REQUIRE(&sub_copy == subscription);
+    REQUIRE(!transfer.payload_borrowed);
+    REQUIRE(transfer.payload != frame_payload.data());
+    REQUIRE(2 == transfer.payload_size);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+    REQUIRE(1 == accept(1001, CANARD_NODE_ID_UNSET, {1, 2}, 0b111'00000U));
+    REQUIRE(!transfer.payload_borrowed);
+    ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxPayloadPool")
+{
+    using helpers::Instance;
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription  sub_pool{};
+    CanardRxSubscription  sub_heap{};
+    CanardRxSubscription  sub_empty{};
+    CanardRxSubscription* subscription = nullptr;
+    alignas(std::max_align_t) std::array<std::uint8_t, 70> memory{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub_pool));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 16, 1'000'000, sub_heap));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1002, 0, 1'000'000, sub_empty));
+    REQUIRE(0 == sub_pool.payload_pool.block_size);
+
+    std::array<std::uint8_t, 8> payload{};
+    const auto accept = [&](const CanardPortID subject_id, const CanardNodeID source_node_id, const std::uint8_t tail) {
+        CanardFrame frame{};
+        payload.at(7U)        = tail;
+        frame.extended_can_id = (source_node_id > CANARD_NODE_ID_MAX)
+                                    ? ((1UL << 24U) | helpers::makeMessageID(subject_id, 0x55U))
+                                    : helpers::makeMessageID(subject_id, source_node_id);
+        frame.payload_size = payload.size();
+        frame.payload      = payload.data();
+        return ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+    };
+    const auto set_pool = [&](CanardRxSubscription* const sub, void* const mem, const std::size_t size) {
+        return canardRxSetPayloadPool(&ins.getInstance(), sub, mem, size);
+    };
+    const auto in_pool = [&](const void* const ptr) {
+        return (ptr >= static_cast<const void*>(memory.data())) &&
+               (ptr < static_cast<const void*>(memory.data() + memory.size()));
+    };
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == set_pool(nullptr, memory.data(), memory.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetPayloadPool(nullptr, &sub_pool, memory.data(), memory.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == set_pool(&sub_pool, memory.data(), 15U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == set_pool(&sub_empty, memory.data(), memory.size()));
+    REQUIRE(0 == sub_pool.payload_pool.block_size);
+    REQUIRE(0 == set_pool(&sub_pool, memory.data(), memory.size()));
+    REQUIRE(4 == sub_pool.payload_pool.capacity);
+    REQUIRE(0 == sub_pool.payload_pool.used);
+
+    // The payloads are taken from the pool; only the sessions are allocated from the heap.
+    std::array<void*, 4> payloads{};
+    for (std::uint8_t i = 0U; i < 3U; i++)
+    {
+        REQUIRE(1 == accept(1000, i, 0b111'00000U));
+        REQUIRE(&sub_pool == subscription);
+        REQUIRE(in_pool(transfer.payload));
+        REQUIRE(7 == transfer.payload_size);
+        payloads.at(i) = transfer.payload;
+    }
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == accept(1000, CANARD_NODE_ID_UNSET, 0b111'00000U));  // Anonymous transfers use the pool as well.
+    REQUIRE(in_pool(transfer.payload));
+    payloads.at(3) = transfer.payload;
+    REQUIRE(4 == sub_pool.payload_pool.used);
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+
+    // The pool is exhausted; the heap is not used as a fallback.
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(1000, 3, 0b111'00000U));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(1000, CANARD_NODE_ID_UNSET, 0b111'00000U));
+    REQUIRE(4 == alloc.getNumAllocatedFragments());  // The new session.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == set_pool(&sub_pool, nullptr, 0U));  // Blocks in use.
+
+    // Released buffers are recycled.
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, payloads.at(1));
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, nullptr);
+    canardRxReleasePayload(nullptr, &sub_pool, payloads.at(0));
+    canardRxReleasePayload(&ins.getInstance(), nullptr, payloads.at(0));
+    REQUIRE(3 == sub_pool.payload_pool.used);
+    REQUIRE(1 == accept(1000, 3, 0b111'00001U));  // The transfer-ID was advanced by the failed transfer.
+    REQUIRE(transfer.payload == payloads.at(1));
+    REQUIRE(4 == sub_pool.payload_pool.used);
+
+    // A multi-frame transfer in progress holds a block until it is completed or abandoned.
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, payloads.at(0));
+    REQUIRE(0 == accept(1000, 4, 0b101'00000U));
+    REQUIRE(4 == sub_pool.payload_pool.used);
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, transfer.payload);
+    REQUIRE(3 == sub_pool.payload_pool.used);
+
+    // The subscriptions without a pool are not affected; the release function works for them too.
+    REQUIRE(1 == accept(1001, 1, 0b111'00000U));
+    REQUIRE(&sub_heap == subscription);
+    REQUIRE(!in_pool(transfer.payload));
+    REQUIRE(7 == alloc.getNumAllocatedFragments());  // Five sessions on sub_pool, one on sub_heap, one payload.
+    canardRxReleasePayload(&ins.getInstance(), &sub_heap, transfer.payload);
+    REQUIRE(6 == alloc.getNumAllocatedFragments());
+
+    // The storage of the buffers cannot be changed while a session holds one, even if it is not taken from a pool.
+    REQUIRE(0 == accept(1001, 1, 0b101'00001U));
+    REQUIRE(7 == alloc.getNumAllocatedFragments());
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == set_pool(&sub_heap, memory.data(), memory.size()));
+    REQUIRE(0 == sub_heap.payload_pool.block_size);
+
+    // Unsubscription returns the buffers of the transfers in progress; the application returns the rest.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(2 == sub_pool.payload_pool.used);
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, payloads.at(2));
+    canardRxReleasePayload(&ins.getInstance(), &sub_pool, payloads.at(3));
+    REQUIRE(0 == sub_pool.payload_pool.used);
+    REQUIRE(0 == set_pool(&sub_pool, nullptr, 0U));
+    REQUIRE(0 == sub_pool.payload_pool.block_size);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1002));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+namespace
+{
+struct ListenerLog
+{
+    std::vector<std::pair<const CanardRxListener*, std::vector<std::uint8_t>>> calls;
+    const CanardRxListener*                                                   retainer = nullptr;
+    void*                                                                     retained = nullptr;
+};
+
+auto logTransfer(CanardInstance* const       ins,
+                 CanardRxListener* const     listener,
+                 CanardRxSubscription* const subscription,
+                 CanardRxTransfer* const     transfer) -> bool
+{
+    REQUIRE(ins != nullptr);
+    REQUIRE(subscription->port_id == transfer->metadata.port_id);
+    auto* const       log  = static_cast<ListenerLog*>(listener->user_reference);
+    const auto* const data = static_cast<const std::uint8_t*>(transfer->payload);
+    log->calls.emplace_back(listener, std::vector<std::uint8_t>(data, data + transfer->payload_size));
+    const bool retain = (log->retainer == listener);
+    if (retain)
+    {
+        log->retained = transfer->payload;
+    }
+    return retain;
+}
+}  // namespace
+
+TEST_CASE("RxListeners")
+{
+    using helpers::Instance;
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription  sub{};
+    CanardRxSubscription* subscription = nullptr;
+    ListenerLog           log;
+    CanardRxListener      listener_a{&logTransfer, &log, nullptr};
+    CanardRxListener      listener_b{&logTransfer, &log, nullptr};
+    CanardRxListener      listener_bad{nullptr, &log, nullptr};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub));
+    REQUIRE(nullptr == sub.listeners);
+
+    std::array<std::uint8_t, 4> payload{};
+    const auto accept = [&](const std::uint8_t value, const std::uint8_t tail) {
+        CanardFrame frame{};
+        payload.at(0)         = value;
+        payload.at(3)         = tail;
+        frame.extended_can_id = helpers::makeMessageID(1000, 31);
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        return ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+    };
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAddListener(nullptr, &listener_a));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAddListener(&sub, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxAddListener(&sub, &listener_bad));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRemoveListener(nullptr, &listener_a));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRemoveListener(&sub, nullptr));
+    REQUIRE(1 == canardRxAddListener(&sub, &listener_a));
+    REQUIRE(1 == canardRxAddListener(&sub, &listener_b));
+    REQUIRE(0 == canardRxAddListener(&sub, &listener_a));
+    REQUIRE(0 == canardRxRemoveListener(&sub, &listener_bad));
+
+    // Both listeners receive the transfer in the order of attachment; the library releases the payload afterwards.
+    REQUIRE(0 == accept(0xAA, 0b111'00000U));
+    REQUIRE(&sub == subscription);
+    REQUIRE(2 == log.calls.size());
+    REQUIRE(&listener_a == log.calls.at(0).first);
+    REQUIRE(&listener_b == log.calls.at(1).first);
+    REQUIRE(std::vector<std::uint8_t>{0xAA, 0, 0} == log.calls.at(0).second);
+    REQUIRE(std::vector<std::uint8_t>{0xAA, 0, 0} == log.calls.at(1).second);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());  // Only the session.
+
+    // The last listener retains the payload.
+    log.calls.clear();
+    log.retainer = &listener_b;
+    REQUIRE(0 == accept(0xBB, 0b111'00001U));
+    REQUIRE(2 == log.calls.size());
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(0xBB == *static_cast<std::uint8_t*>(log.retained));
+    canardRxReleasePayload(&ins.getInstance(), &sub, log.retained);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // The first listener retains the payload so the second one is not invoked.
+    log.calls.clear();
+    log.retainer = &listener_a;
+    REQUIRE(0 == accept(0xCC, 0b111'00010U));
+    REQUIRE(1 == log.calls.size());
+    REQUIRE(&listener_a == log.calls.at(0).first);
+    canardRxReleasePayload(&ins.getInstance(), &sub, log.retained);
+
+    // Borrowed payloads are not released by the library.
+    log.calls.clear();
+    log.retainer            = nullptr;
+    sub.borrow_single_frame = true;
+    REQUIRE(0 == accept(0xDD, 0b111'00011U));
+    REQUIRE(2 == log.calls.size());
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    sub.borrow_single_frame = false;
+
+    // Once the last listener is detached, the transfers are returned to the caller again.
+    REQUIRE(1 == canardRxRemoveListener(&sub, &listener_a));
+    REQUIRE(0 == canardRxRemoveListener(&sub, &listener_a));
+    REQUIRE(&listener_b == sub.listeners);
+    REQUIRE(1 == canardRxRemoveListener(&sub, &listener_b));
+    REQUIRE(nullptr == sub.listeners);
+    log.calls.clear();
+    REQUIRE(1 == accept(0xEE, 0b111'00100U));
+    REQUIRE(log.calls.empty());
+    REQUIRE(0xEE == *static_cast<std::uint8_t*>(transfer.payload));
+    ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+namespace
+{
+struct StreamChunk
+{
+    CanardTransferMetadata    metadata;
+    std::size_t               offset;
+    std::vector<std::uint8_t> data;
+    bool                      end_of_transfer;
+    bool                      valid;
+};
+
+void logChunk(CanardInstance* const ins, CanardRxSubscription* const subscription, const CanardRxChunk* const chunk)
+{
+    REQUIRE(ins != nullptr);
+    REQUIRE(subscription->port_id == chunk->metadata.port_id);
+    auto* const       log  = static_cast<std::vector<StreamChunk>*>(subscription->user_reference);
+    const auto* const data = static_cast<const std::uint8_t*>(chunk->data);
+    log->push_back(StreamChunk{chunk->metadata,
+                               chunk->offset,
+                               std::vector<std::uint8_t>(data, data + chunk->size),
+                               chunk->end_of_transfer,
+                               chunk->valid});
+}
+}  // namespace
+
+TEST_CASE("RxStreaming")
+{
+    using helpers::Instance;
+
+    Instance                 ins;
+    auto&                    alloc = ins.getAllocator();
+    CanardRxTransfer         transfer{};
+    CanardRxSubscription     sub{};
+    CanardRxSubscription*    subscription = nullptr;
+    std::vector<StreamChunk> log;
+    sub.stream_handler = &logChunk;
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 100, 1'000'000, sub));
+    REQUIRE(nullptr == sub.stream_handler);  // Reset by the subscription.
+    sub.stream_handler = &logChunk;
+    sub.user_reference = &log;
+
+    std::vector<std::uint8_t> frame_payload;
+    const auto accept = [&](const CanardNodeID               source_node_id,
+                            const std::vector<std::uint8_t>& payload,
+                            const std::uint8_t               tail) -> std::int8_t {
+        frame_payload = payload;
+        frame_payload.push_back(tail);
+        CanardFrame frame{};
+        frame.extended_can_id = (source_node_id > CANARD_NODE_ID_MAX)
+                                    ? ((1UL << 24U) | helpers::makeMessageID(1000, 0x55U))
+                                    : helpers::makeMessageID(1000, source_node_id);
+        frame.payload_size = frame_payload.size();
+        frame.payload      = frame_payload.data();
+        return ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+    };
+
+    // A multi-frame transfer of 16 bytes plus the CRC split into frames of 7+7+4 bytes.
+    std::vector<std::uint8_t> mf_payload;
+    std::uint16_t             crc = 0xFFFFU;  // CRC-16/CCITT-FALSE
+    for (std::uint8_t x = 1; x <= 16; x++)
+    {
+        mf_payload.push_back(x);
+        crc = static_cast<std::uint16_t>(crc ^ static_cast<std::uint16_t>(x << 8U));
+        for (auto i = 0; i < 8; i++)
+        {
+            crc = static_cast<std::uint16_t>(((crc & 0x8000U) != 0U) ? ((crc << 1U) ^ 0x1021U) : (crc << 1U));
+        }
+    }
+    mf_payload.push_back(static_cast<std::uint8_t>(crc >> 8U));
+    mf_payload.push_back(static_cast<std::uint8_t>(crc));
+    const auto accept_mf = [&](const std::uint8_t transfer_id) {
+        const auto it = mf_payload.begin();
+        REQUIRE(0 == accept(5, {it, it + 7}, static_cast<std::uint8_t>(0b101'00000U | transfer_id)));
+        REQUIRE(0 == accept(5, {it + 7, it + 14}, static_cast<std::uint8_t>(0b000'00000U | transfer_id)));
+        REQUIRE(0 == accept(5, {it + 14, mf_payload.end()}, static_cast<std::uint8_t>(0b011'00000U | transfer_id)));
+    };
+
+    // The data is delivered as it arrives; the trailing bytes are held back until it is known they are not the CRC.
+    // No payload buffers are allocated, only the session.
+    accept_mf(0);
+    REQUIRE(&sub == subscription);
+    REQUIRE(3 == log.size());
+    REQUIRE(0 == log.at(0).offset);
+    REQUIRE(std::vector<std::uint8_t>{1, 2, 3, 4, 5} == log.at(0).data);
+    REQUIRE(!log.at(0).end_of_transfer);
+    REQUIRE(5 == log.at(1).offset);
+    REQUIRE(std::vector<std::uint8_t>{6, 7, 8, 9, 10, 11, 12} == log.at(1).data);
+    REQUIRE(!log.at(1).end_of_transfer);
+    REQUIRE(12 == log.at(2).offset);
+    REQUIRE(std::vector<std::uint8_t>{13, 14, 15, 16} == log.at(2).data);
+    REQUIRE(log.at(2).end_of_transfer);
+    REQUIRE(log.at(2).valid);
+    REQUIRE(5 == log.at(2).metadata.remote_node_id);
+    REQUIRE(0 == log.at(2).metadata.transfer_id);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // A corrupted transfer is reported as invalid in the last chunk.
+    log.clear();
+    mf_payload.back() = static_cast<std::uint8_t>(~mf_payload.back());
+    accept_mf(1);
+    REQUIRE(3 == log.size());
+    REQUIRE(log.at(2).end_of_transfer);
+    REQUIRE(!log.at(2).valid);
+    mf_payload.back() = static_cast<std::uint8_t>(~mf_payload.back());
+
+    // Single-frame and anonymous transfers are delivered as one chunk.
+    log.clear();
+    REQUIRE(0 == accept(5, {1, 2, 3}, 0b111'00010U));
+    REQUIRE(0 == accept(CANARD_NODE_ID_UNSET, {4, 5}, 0b111'00000U));
+    REQUIRE(2 == log.size());
+    REQUIRE(std::vector<std::uint8_t>{1, 2, 3} == log.at(0).data);
+    REQUIRE(log.at(0).end_of_transfer);
+    REQUIRE(log.at(0).valid);
+    REQUIRE(std::vector<std::uint8_t>{4, 5} == log.at(1).data);
+    REQUIRE(CANARD_NODE_ID_UNSET == log.at(1).metadata.remote_node_id);
+    REQUIRE(log.at(1).valid);
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // The implicit truncation rule applies: the data beyond the extent is not delivered but the CRC is still checked.
+    REQUIRE(0 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 10, 1'000'000, sub));  // Replaced.
+    sub.stream_handler = &logChunk;
+    sub.user_reference = &log;
+    log.clear();
+    accept_mf(3);
+    REQUIRE(3 == log.size());
+    REQUIRE(std::vector<std::uint8_t>{1, 2, 3, 4, 5} == log.at(0).data);
+    REQUIRE(std::vector<std::uint8_t>{6, 7, 8, 9, 10} == log.at(1).data);
+    REQUIRE(10 == log.at(2).offset);
+    REQUIRE(log.at(2).data.empty());
+    REQUIRE(log.at(2).valid);
+    log.clear();
+    REQUIRE(0 == accept(5, {1, 2, 3, 4, 5, 6, 7}, 0b111'00100U));
+    REQUIRE(1 == log.size());
+    REQUIRE(7 == log.at(0).data.size());
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxRedundantTransports")
+{
+    using helpers::Instance;
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    auto&                 inst  = ins.getInstance();
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription  sub{};
+    CanardRxSubscription* subscription = nullptr;
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 2'000'000, sub));
+    REQUIRE(0 == inst.rx_failover_timeout_usec);
+
+    std::array<std::uint8_t, 8> payload{};
+    const auto accept = [&](const CanardMicrosecond ts, const std::uint8_t iface, const std::uint8_t tail) {
+        CanardFrame frame{};
+        payload.at(7)         = tail;
+        frame.extended_can_id = helpers::makeMessageID(1000, 5);
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        const auto result     = ins.rxAccept(ts, frame, iface, transfer, &subscription);
+        if (result == 1)
+        {
+            inst.memory_free(&inst, transfer.payload);
+        }
+        return result;
+    };
+
+    // The copies from the other transports are dropped and counted.
+    REQUIRE(1 == accept(1'000, 0, 0b111'00000U));
+    REQUIRE(0 == accept(1'010, 1, 0b111'00000U));
+    REQUIRE(0 == accept(1'020, 2, 0b111'00000U));
+    REQUIRE(0 == accept(1'030, 7, 0b111'00000U));  // Not tracked.
+    REQUIRE(0 == inst.rx_redundant_frames_dropped[0]);
+    REQUIRE(1 == inst.rx_redundant_frames_dropped[1]);
+    REQUIRE(1 == inst.rx_redundant_frames_dropped[2]);
+    REQUIRE(1'000 == inst.rx_last_frame_usec[0]);
+    REQUIRE(1'010 == inst.rx_last_frame_usec[1]);
+    REQUIRE(1'020 == inst.rx_last_frame_usec[2]);
+
+    // Without the failover timeout, the session stays on the quiet transport until the transfer-ID timeout.
+    REQUIRE(0 == accept(500'000, 1, 0b111'00001U));
+    REQUIRE(2 == inst.rx_redundant_frames_dropped[1]);
+
+    // With the failover timeout, the session switches over as soon as the active transport is found quiet.
+    inst.rx_failover_timeout_usec = 100'000;
+    REQUIRE(1 == accept(600'000, 1, 0b111'00010U));
+    REQUIRE(2 == inst.rx_redundant_frames_dropped[1]);
+    REQUIRE(0 == accept(600'010, 0, 0b111'00010U));  // Now the other transport is the one being dropped.
+    REQUIRE(1 == inst.rx_redundant_frames_dropped[0]);
+
+    // A transfer in progress on the failed transport is abandoned; only start-of-transfer frames trigger switchover.
+    REQUIRE(0 == accept(700'000, 1, 0b101'00011U));
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == accept(710'000, 0, 0b101'00011U));  // Transport 1 is not quiet yet.
+    REQUIRE(0 == accept(900'000, 0, 0b010'00011U));  // Not a start-of-transfer frame.
+    REQUIRE(3 == inst.rx_redundant_frames_dropped[0]);
+    REQUIRE(2 == alloc.getNumAllocatedFragments());
+    REQUIRE(1 == accept(900'010, 0, 0b111'00100U));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == accept(900'020, 1, 0b111'00100U));
+    REQUIRE(3 == inst.rx_redundant_frames_dropped[1]);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("RxSharding")
+{
+    using helpers::Instance;
+
+    // The ports are distributed evenly; the requests and the responses of a service share the same shard.
+    REQUIRE(0 == canardRxGetShardForPort(CanardTransferKindMessage, 1000, 0));
+    REQUIRE(0 == canardRxGetShardForPort(CanardTransferKindMessage, 1000, 1));
+    REQUIRE(0 == canardRxGetShardForPort(CanardTransferKindMessage, 1000, 4));
+    REQUIRE(1 == canardRxGetShardForPort(CanardTransferKindMessage, 1001, 4));
+    REQUIRE(3 == canardRxGetShardForPort(CanardTransferKindMessage, 1003, 4));
+    REQUIRE(2 == canardRxGetShardForPort(CanardTransferKindRequest, 10, 4));
+    REQUIRE(2 == canardRxGetShardForPort(CanardTransferKindResponse, 10, 4));
+    REQUIRE(3 == canardRxGetShardForPort(CanardTransferKindResponse, 11, 4));
+    std::array<std::size_t, 3> histogram{};
+    for (CanardPortID i = 0; i <= CANARD_SUBJECT_ID_MAX; i++)
+    {
+        histogram.at(canardRxGetShardForPort(CanardTransferKindMessage, i, 3))++;
+    }
+    REQUIRE(2731 == histogram.at(0));
+    REQUIRE(2731 == histogram.at(1));
+    REQUIRE(2730 == histogram.at(2));
+
+    // The frames are routed consistently with the subscriptions.
+    REQUIRE(0 == canardRxGetShardForFrame(helpers::makeMessageID(1000, 5), 4));
+    REQUIRE(1 == canardRxGetShardForFrame(helpers::makeMessageID(1001, 5), 4));
+    REQUIRE(2 == canardRxGetShardForFrame(helpers::makeServiceID(10, true, 42, 5), 4));
+    REQUIRE(2 == canardRxGetShardForFrame(helpers::makeServiceID(10, false, 42, 5), 4));
+
+    // Two independent shards driven from their own threads hand the transfers over to one consumer each.
+    // The assertions are not checked from the worker threads because the test framework is not thread-safe.
+    struct Shard
+    {
+        Instance                            ins;
+        std::array<CanardRxSubscription, 4> subs{};
+        CanardRxListener                    listener{};
+        std::array<CanardRxRingItem, 8>     storage{};
+        CanardRxRing                        ring{};
+        std::vector<void*>                  payloads;
+        std::atomic<bool>                   ok{true};
+    };
+    std::array<Shard, 2> shards;
+    for (std::uint8_t i = 0U; i < 2U; i++)
+    {
+        auto& sh = shards.at(i);
+        REQUIRE(0 == canardRxRingInit(&sh.ring, sh.storage.data(), sh.storage.size()));
+        sh.listener.user_reference = &sh;
+        sh.listener.handler        = [](CanardInstance* const       ins,
+                                        CanardRxListener* const     listener,
+                                        CanardRxSubscription* const subscription,
+                                        CanardRxTransfer* const     transfer) -> bool {
+            (void) ins;
+            auto* const s      = static_cast<Shard*>(listener->user_reference);
+            std::int8_t result = 0;
+            // Keep trying until the consumer makes room; a real application would rather drop the transfer.
+            while (0 == (result = canardRxRingPush(&s->ring, transfer, subscription)))
+            {
+                std::this_thread::yield();
+            }
+            if (result != 1)
+            {
+                s->ok = false;
+            }
+            return true;
+        };
+    }
+    for (CanardPortID port = 1000; port < 1008; port++)
+    {
+        auto& sh = shards.at(canardRxGetShardForPort(CanardTransferKindMessage, port, 2));
+        auto& sb = sh.subs.at((port - 1000U) / 2U);
+        REQUIRE(1 == sh.ins.rxSubscribe(CanardTransferKindMessage, port, 8, 1'000'000, sb));
+        REQUIRE(1 == canardRxAddListener(&sb, &sh.listener));
+    }
+
+    constexpr std::size_t      TransferCount = 10'000;
+    std::array<std::thread, 4> threads;
+    for (std::uint8_t i = 0U; i < 2U; i++)
+    {
+        threads.at(i) = std::thread([&shards, i]() {
+            auto& sh = shards.at(i);
+            for (std::size_t k = 0U; k < TransferCount; k++)
+            {
+                // Generate the frames for all subjects and let the router drop those that belong to the other shard.
+                const auto                        subject = static_cast<CanardPortID>(1000U + (k % 8U));
+                const auto                        tid     = static_cast<std::uint8_t>((k / 8U) % 32U);
+                const std::array<std::uint8_t, 3> data{static_cast<std::uint8_t>(k),
+                                                       static_cast<std::uint8_t>(k >> 8U),
+                                                       static_cast<std::uint8_t>(0b111'00000U | tid)};
+                CanardFrame                       frame{};
+                frame.extended_can_id = helpers::makeMessageID(subject, 5);
+                frame.payload_size    = data.size();
+                frame.payload         = data.data();
+                if (canardRxGetShardForFrame(frame.extended_can_id, 2) == i)
+                {
+                    CanardRxTransfer transfer{};
+                    if (0 != sh.ins.rxAccept(1'000'000 + k, frame, 0, transfer, nullptr))
+                    {
+                        sh.ok = false;
+                    }
+                }
+            }
+        });
+        threads.at(i + 2U) = std::thread([&shards, i]() {
+            auto&       sh       = shards.at(i);
+            std::size_t expected = i;  // The even subjects go to the first shard, the odd ones to the second one.
+            while (expected < TransferCount)
+            {
+                CanardRxTransfer      transfer{};
+                CanardRxSubscription* sub = nullptr;
+                if (1 == canardRxRingPop(&sh.ring, &transfer, &sub))
+                {
+                    const auto* const data = static_cast<const std::uint8_t*>(transfer.payload);
+                    if ((2 != transfer.payload_size) || (sub->port_id != transfer.metadata.port_id) ||
+                        (sub->port_id != (1000U + (expected % 8U))) ||
+                        (expected != (data[0] | (static_cast<std::size_t>(data[1]) << 8U))))
+                    {
+                        sh.ok = false;
+                    }
+                    sh.payloads.push_back(transfer.payload);
+                    expected += 2U;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    for (std::uint8_t i = 0U; i < 2U; i++)
+    {
+        auto& sh = shards.at(i);
+        REQUIRE(sh.ok);
+        REQUIRE((TransferCount / 2U) == sh.payloads.size());
+        CanardRxTransfer transfer{};
+        REQUIRE(0 == canardRxRingPop(&sh.ring, &transfer, nullptr));
+        for (auto* const p : sh.payloads)
+        {
+            sh.ins.getInstance().memory_free(&sh.ins.getInstance(), p);
+        }
+        for (std::uint16_t k = 0U; k < 4U; k++)
+        {
+            REQUIRE(1 == sh.ins.rxUnsubscribe(CanardTransferKindMessage, sh.subs.at(k).port_id));
+        }
+        REQUIRE(0 == sh.ins.getAllocator().getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("RxRing")
+{
+    std::array<CanardRxRingItem, 4> storage{};
+    CanardRxRing                    ring{};
+    CanardRxTransfer                transfer{};
+    CanardRxSubscription*           sub = nullptr;
+    CanardRxSubscription            dummy{};
+
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingInit(nullptr, storage.data(), 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingInit(&ring, nullptr, 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingInit(&ring, storage.data(), 0));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingInit(&ring, storage.data(), 3));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPush(&ring, &transfer, nullptr));  // Not initialized.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPop(&ring, &transfer, &sub));
+    REQUIRE(0 == canardRxRingInit(&ring, storage.data(), 4));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPush(nullptr, &transfer, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPush(&ring, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPop(nullptr, &transfer, &sub));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxRingPop(&ring, nullptr, &sub));
+    REQUIRE(0 == canardRxRingPop(&ring, &transfer, &sub));
+
+    // Fill the ring and drain it several times over to exercise the wraparound.
+    std::uint8_t next_in  = 0U;
+    std::uint8_t next_out = 0U;
+    for (auto round = 0; round < 3; round++)
+    {
+        while (true)
+        {
+            transfer.metadata.transfer_id = next_in;
+            const auto result = canardRxRingPush(&ring, &transfer, ((next_in % 2U) == 0U) ? &dummy : nullptr);
+            if (result == 0)
+            {
+                break;
+            }
+            REQUIRE(1 == result);
+            next_in++;
+        }
+        REQUIRE((next_in - next_out) == 4);
+        for (auto i = 0; i < 3; i++)
+        {
+            sub = reinterpret_cast<CanardRxSubscription*>(&ring);
+            REQUIRE(1 == canardRxRingPop(&ring, &transfer, &sub));
+            REQUIRE(next_out == transfer.metadata.transfer_id);
+            REQUIRE((((next_out % 2U) == 0U) ? &dummy : nullptr) == sub);
+            next_out++;
+        }
+    }
+    REQUIRE(1 == canardRxRingPop(&ring, &transfer, nullptr));
+    REQUIRE(next_out == transfer.metadata.transfer_id);
+    REQUIRE(0 == canardRxRingPop(&ring, &transfer, &sub));
+}
+
+TEST_CASE("RxMemoryUsage")
+{
+    using helpers::Instance;
+    using exposed::RxSession;
+
+    // The macros are usable in constant expressions; the functions return the exact values which cannot be larger.
+    static_assert(CANARD_RX_SUBSCRIPTION_WORST_CASE_BYTES(16, 3) == (3U * (CANARD_RX_SESSION_SIZE_MAX + 16U)));
+    REQUIRE(sizeof(RxSession) <= CANARD_RX_SESSION_SIZE_MAX);
+    REQUIRE((3U * (sizeof(RxSession) + 16U)) == canardRxSubscriptionWorstCaseBytes(16, 3));
+    REQUIRE(0U == canardRxSubscriptionWorstCaseBytes(16, 0));
+    REQUIRE(canardRxSubscriptionWorstCaseBytes(64, CANARD_NODE_ID_MAX + 1U) <=
+            CANARD_RX_SUBSCRIPTION_WORST_CASE_BYTES(64, CANARD_NODE_ID_MAX + 1U));
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    CanardRxLookup        lookup{};
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription* subscription = nullptr;
+    ins.setNodeID(42);
+
+    const auto accept = [&](const CanardPortID subject_id, const CanardNodeID source_node_id, const std::uint8_t tail) {
+        std::array<std::uint8_t, 8> payload{};
+        payload.at(7)         = tail;
+        CanardFrame frame{};
+        frame.extended_can_id = helpers::makeMessageID(subject_id, source_node_id);
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        const auto result     = ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+        if (result == 1)
+        {
+            ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+        }
+        return result;
+    };
+
+    // Error handling.
+    auto& i = ins.getInstance();
+    {
+        const std::array<const CanardTxQueue*, 1> ques{nullptr};
+        REQUIRE(0U == canardInstanceMemoryUsage(nullptr, nullptr, 0U).total_bytes);
+        REQUIRE(0U == canardInstanceMemoryUsage(&ins.getInstance(), nullptr, 1U).total_bytes);
+        REQUIRE(0U == canardInstanceMemoryUsage(&ins.getInstance(), ques.data(), 1U).total_bytes);
+    }
+
+    REQUIRE(0 == canardRxSetLookup(&ins.getInstance(), &lookup));
+    CanardRxSubscription sub_a{};
+    CanardRxSubscription sub_b{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub_a));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 2000, 64, 1'000'000, sub_b));
+
+    // Two transfers are being reassembled and one has been completed.
+    REQUIRE(0 == accept(1000, 1, 0b101'00000U));
+    REQUIRE(0 == accept(2000, 2, 0b101'00000U));
+    REQUIRE(1 == accept(2000, 3, 0b111'00000U));
+    CanardMemoryUsage usage = canardInstanceMemoryUsage(&ins.getInstance(), nullptr, 0U);
+    REQUIRE(3U == usage.rx_sessions);
+    REQUIRE(2U == usage.rx_payload_buffers);
+    REQUIRE(2U == usage.rx_lookup_pages);
+    REQUIRE(0U == usage.tx_frames);
+    REQUIRE(alloc.getTotalAllocatedAmount() == usage.total_bytes);
+    REQUIRE(usage.total_bytes <= (2U * canardRxSubscriptionWorstCaseBytes(64, 3) + (2U * 33U * sizeof(void*))));
+
+    // The payload buffer is released when the transfer is completed; this one is dropped because its CRC is wrong.
+    REQUIRE(0 == accept(1000, 1, 0b000'00000U));
+    REQUIRE(0 == accept(1000, 1, 0b011'00000U));
+    usage = canardInstanceMemoryUsage(&ins.getInstance(), nullptr, 0U);
+    REQUIRE(3U == usage.rx_sessions);
+    REQUIRE(1U == usage.rx_payload_buffers);
+    REQUIRE(alloc.getTotalAllocatedAmount() == usage.total_bytes);
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 2000));
+    usage = canardInstanceMemoryUsage(&ins.getInstance(), nullptr, 0U);
+    REQUIRE(0U == usage.total_bytes);
+    REQUIRE(0U == usage.rx_sessions);
+    REQUIRE(0U == usage.rx_lookup_pages);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
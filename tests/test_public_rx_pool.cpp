@@ -0,0 +1,168 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016-2020 UAVCAN Development Team.
+
+#include "helpers.hpp"
+#include "catch.hpp"
+#include <cstddef>
+
+// This test does not access CanardRxSubscription::sessions because it is also built with compact subscriptions.
+
+namespace
+{
+auto makeAnonymousMessageID(const CanardPortID subject_id) -> std::uint32_t
+{
+    return (4UL << 26U) | (1UL << 24U) | (3UL << 21U) | (static_cast<std::uint32_t>(subject_id) << 8U) | 0x55U;
+}
+}  // namespace
+
+TEST_CASE("RxSessionPool")
+{
+    using helpers::Instance;
+
+    Instance              ins;
+    auto&                 alloc = ins.getAllocator();
+    CanardRxSessionPool   pool{};
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription* subscription = nullptr;
+    alignas(std::max_align_t) std::array<std::uint8_t, 1024> memory{};
+
+    // Accepts a single-frame transfer or a frame of a multi-frame transfer; the payload is freed immediately.
+    std::array<std::uint8_t, 8> payload{};
+    const auto accept = [&](const std::uint32_t extended_can_id, const std::uint8_t tail) -> std::int8_t {
+        CanardFrame frame{};
+        payload.at(7U)        = tail;
+        frame.extended_can_id = extended_can_id;
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        const auto result     = ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+        if (result == 1)
+        {
+            ins.getInstance().memory_free(&ins.getInstance(), transfer.payload);
+        }
+        return result;
+    };
+
+    // Error handling.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSessionPool(nullptr, &pool, memory.data(), memory.size()));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSessionPool(&ins.getInstance(), &pool, nullptr, 1024U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSessionPool(&ins.getInstance(), &pool, memory.data(), 8U));
+    REQUIRE(nullptr == ins.getInstance().rx_session_pool);
+    REQUIRE(0 == canardRxSetSessionPool(&ins.getInstance(), nullptr, nullptr, 0U));
+    REQUIRE(nullptr == ins.getInstance().rx_session_pool);
+
+#if CANARD_RX_COMPACT_SUBSCRIPTIONS
+    // Without the pool, only the stateless anonymous transfers can be received.
+    {
+        CanardRxSubscription sub{};
+        REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub));
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(helpers::makeMessageID(1000, 1), 0b111'00000U));
+        REQUIRE(1 == accept(makeAnonymousMessageID(1000), 0b111'00000U));
+        REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    }
+#endif
+
+    REQUIRE(0 == canardRxSetSessionPool(&ins.getInstance(), &pool, memory.data(), memory.size()));
+    REQUIRE(&pool == ins.getInstance().rx_session_pool);
+    const std::size_t capacity = pool.blocks.capacity;
+    REQUIRE(capacity > 2U);
+    REQUIRE(capacity <= ((pool.index_size * 3U) / 4U));
+    REQUIRE(0U == pool.blocks.used);
+    REQUIRE(0U == pool.evictions);
+
+    // The pool cannot be replaced while there are subscriptions.
+    CanardRxSubscription sub_a{};
+    CanardRxSubscription sub_b{};
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 16, 1'000'000, sub_a));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardRxSetSessionPool(&ins.getInstance(), nullptr, nullptr, 0U));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardRxSetSessionPool(&ins.getInstance(), &pool, memory.data(), memory.size()));
+    REQUIRE(&pool == ins.getInstance().rx_session_pool);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Anonymous transfers are stateless so they do not occupy the pool.
+    REQUIRE(1 == accept(makeAnonymousMessageID(1000), 0b111'00000U));
+    REQUIRE(0U == pool.blocks.used);
+
+    // Fill the pool; the sessions do not require heap memory.
+    for (std::size_t i = 0U; i < capacity; i++)
+    {
+        REQUIRE(1 == accept(helpers::makeMessageID(1000, static_cast<CanardNodeID>(i)), 0b111'00000U));
+        REQUIRE(&sub_a == subscription);
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    }
+    REQUIRE(capacity == pool.blocks.used);
+    REQUIRE(0U == pool.evictions);
+    // Duplicates are still rejected, so the sessions are retained.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 0), 0b111'00000U));
+    REQUIRE(capacity == pool.blocks.used);
+
+    // Begin a multi-frame transfer from node 0, which makes it the most recently used session.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 0), 0b101'00001U));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+
+    // New nodes evict the least recently used sessions: 1, 2, ..., capacity-1.
+    for (std::size_t i = 0U; i < (capacity - 1U); i++)
+    {
+        REQUIRE(1 == accept(helpers::makeMessageID(1000, static_cast<CanardNodeID>(capacity + i)), 0b111'00000U));
+        REQUIRE(capacity == pool.blocks.used);
+        REQUIRE((i + 1U) == pool.evictions);
+        REQUIRE(1 == alloc.getNumAllocatedFragments());  // The transfer from node 0 is still in progress.
+    }
+    // Node 1 was evicted, so its duplicate is accepted as a new transfer.
+    REQUIRE(1 == accept(helpers::makeMessageID(1000, 1), 0b111'00000U));
+    REQUIRE(capacity == pool.evictions);
+    // That evicted node 0 and aborted its transfer; the payload buffer is freed and the last frame is not accepted.
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 0), 0b010'00001U));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The sessions of different subscriptions from the same node are distinct.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 16, 1'000'000, sub_b));
+    pool.evictions = 0U;
+    REQUIRE(1 == accept(helpers::makeMessageID(1001, 1), 0b111'00000U));
+    REQUIRE(&sub_b == subscription);
+    REQUIRE(1 == pool.evictions);
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), 0b111'00000U));  // Still a duplicate; the session is intact.
+    REQUIRE(1 == accept(helpers::makeMessageID(1001, 1), 0b111'00001U));
+    REQUIRE(1 == pool.evictions);
+
+    // Churn through many sessions to exercise the index; every transfer is new so every one shall be accepted.
+    std::array<std::uint8_t, CANARD_NODE_ID_MAX + 1U> transfer_ids{};
+    std::uint32_t                                     state = 12345U;
+    transfer_ids.fill(1U);  // Avoid the transfer-ID values used above.
+    for (std::size_t i = 0U; i < 10'000U; i++)
+    {
+        state                          = (state * 1103515245U) + 12345U;
+        const auto         node_id     = static_cast<CanardNodeID>((state >> 16U) % 40U);
+        const CanardPortID subject_id  = (((state >> 8U) & 1U) != 0U) ? 1000U : 1001U;
+        auto&              transfer_id = transfer_ids.at(node_id + ((subject_id == 1000U) ? 0U : 64U));
+        transfer_id                    = static_cast<std::uint8_t>((transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+        const auto         tail        = static_cast<std::uint8_t>(0b111'00000U | transfer_id);
+        REQUIRE(1 == accept(helpers::makeMessageID(subject_id, node_id), tail));
+        REQUIRE(pool.blocks.used <= capacity);
+    }
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(capacity == pool.blocks.used);
+
+    // Unsubscription and the cleanup of stale sessions return the blocks to the pool and leave the index empty.
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    const std::size_t remaining = pool.blocks.used;
+    REQUIRE(remaining < capacity);
+    REQUIRE(0 == canardRxCleanup(&ins.getInstance(), 100'500'000));
+    REQUIRE(static_cast<std::int32_t>(remaining) == canardRxCleanup(&ins.getInstance(), 200'000'000));
+    REQUIRE(0U == pool.blocks.used);
+    REQUIRE(nullptr == ins.getInstance().rx_sessions_oldest);
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+    REQUIRE(nullptr == pool.lru_head);
+    REQUIRE(nullptr == pool.lru_tail);
+    for (std::size_t i = 0U; i < pool.index_size; i++)
+    {
+        REQUIRE(nullptr == pool.index[i]);
+    }
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The pool can be detached once there are no subscriptions.
+    REQUIRE(0 == canardRxSetSessionPool(&ins.getInstance(), nullptr, nullptr, 0U));
+    REQUIRE(nullptr == ins.getInstance().rx_session_pool);
+}
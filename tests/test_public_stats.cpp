@@ -0,0 +1,266 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (c) 2016-2020 UAVCAN Development Team.
+
+#include "helpers.hpp"
+#include "catch.hpp"
+#include <vector>
+
+#if !CANARD_STATS
+#    error "This test requires CANARD_STATS"
+#endif
+
+namespace
+{
+struct TraceRecord
+{
+    CanardTraceEvent       event;
+    bool                   has_metadata;
+    CanardTransferMetadata metadata;
+};
+
+/// Records the events reported via the trace hook.
+class TracingInstance : public helpers::Instance
+{
+public:
+    TracingInstance() { getInstance().trace_hook = &TracingInstance::trampolineTrace; }
+
+    [[nodiscard]] auto popTrace() -> std::vector<TraceRecord>
+    {
+        std::vector<TraceRecord> out;
+        std::swap(out, trace_);
+        return out;
+    }
+
+private:
+    static void trampolineTrace(CanardInstance* const               ins,
+                                const CanardTraceEvent              event,
+                                const CanardTransferMetadata* const metadata)
+    {
+        auto* const self = static_cast<TracingInstance*>(static_cast<helpers::Instance*>(ins->user_reference));
+        TraceRecord rec{event, metadata != nullptr, {}};
+        if (metadata != nullptr)
+        {
+            rec.metadata = *metadata;
+        }
+        self->trace_.push_back(rec);
+    }
+
+    std::vector<TraceRecord> trace_;
+};
+}  // namespace
+
+TEST_CASE("StatsRx")
+{
+    TracingInstance       ins;
+    CanardInstance&       canard = ins.getInstance();
+    auto&                 alloc  = ins.getAllocator();
+    CanardRxTransfer      transfer{};
+    CanardRxSubscription* subscription = nullptr;
+
+    const auto accept = [&](const std::uint32_t extended_can_id, const std::vector<std::uint8_t>& payload) {
+        CanardFrame frame{};
+        frame.extended_can_id = extended_can_id;
+        frame.payload_size    = payload.size();
+        frame.payload         = payload.data();
+        const auto result     = ins.rxAccept(100'000'000, frame, 0, transfer, &subscription);
+        if (result > 0)
+        {
+            canard.memory_free(&canard, transfer.payload);
+        }
+        return result;
+    };
+
+    // The counters are zero-initialized and there is no hook by default.
+    {
+        const CanardInstance fresh = canardInit(canard.memory_allocate, canard.memory_free);
+        REQUIRE(nullptr == fresh.trace_hook);
+        REQUIRE(0U == fresh.rx_stats.frames_accepted);
+        REQUIRE(0U == fresh.rx_frames_malformed);
+        REQUIRE(0U == fresh.memory_allocations);
+        REQUIRE(0U == fresh.memory_allocated_bytes);
+    }
+
+    CanardRxSubscription sub{};
+    CanardRxSubscription sub_small{};
+    sub.stats.transfers = 123U;  // Reset by the subscription.
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1000, 8, 1'000'000, sub));
+    REQUIRE(1 == ins.rxSubscribe(CanardTransferKindMessage, 1001, 4, 1'000'000, sub_small));
+    REQUIRE(0U == sub.stats.transfers);
+    const std::uint32_t allocations_before = canard.memory_allocations;
+
+    // A valid single-frame transfer allocates a session and a payload buffer.
+    REQUIRE(1 == accept(helpers::makeMessageID(1000, 1), {1, 2, 3, 0b111'00000U}));
+    REQUIRE(1U == canard.rx_stats.frames_accepted);
+    REQUIRE(1U == canard.rx_stats.transfers);
+    REQUIRE(1U == sub.stats.transfers);
+    REQUIRE((allocations_before + 2U) == canard.memory_allocations);
+    REQUIRE(canard.memory_allocated_bytes >= alloc.getTotalAllocatedAmount());
+    REQUIRE(ins.popTrace().empty());
+
+    // The transfer is received again, e.g., via another redundant interface.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), {1, 2, 3, 0b111'00000U}));
+    REQUIRE(1U == canard.rx_stats.duplicates);
+    REQUIRE(1U == sub.stats.duplicates);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(1U == trace.size());
+        REQUIRE(CanardTraceEventRxDuplicate == trace.at(0).event);
+        REQUIRE(trace.at(0).has_metadata);
+        REQUIRE(CanardTransferKindMessage == trace.at(0).metadata.transfer_kind);
+        REQUIRE(1000U == trace.at(0).metadata.port_id);
+        REQUIRE(1U == trace.at(0).metadata.remote_node_id);
+        REQUIRE(0U == trace.at(0).metadata.transfer_id);
+    }
+
+    // The first frame of a multi-frame transfer from a new node is missed.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 2), {1, 2, 3, 4, 5, 6, 7, 0b000'00000U}));
+    REQUIRE(1U == canard.rx_stats.sot_misses);
+    REQUIRE(1U == sub.stats.sot_misses);
+    // The first frame of the next transfer from an existing node is missed.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), {1, 2, 3, 4, 5, 6, 7, 0b000'00101U}));
+    REQUIRE(2U == canard.rx_stats.sot_misses);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(2U == trace.size());
+        REQUIRE(CanardTraceEventRxSOTMiss == trace.at(0).event);
+        REQUIRE(2U == trace.at(0).metadata.remote_node_id);
+        REQUIRE(CanardTraceEventRxSOTMiss == trace.at(1).event);
+        REQUIRE(5U == trace.at(1).metadata.transfer_id);
+    }
+
+    // A frame of a multi-frame transfer is repeated, so the toggle bit is wrong.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), {1, 2, 3, 4, 5, 6, 7, 0b101'00001U}));
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), {1, 2, 3, 4, 5, 6, 7, 0b101'00001U}));
+    REQUIRE(1U == canard.rx_stats.toggle_errors);
+    REQUIRE(1U == sub.stats.toggle_errors);
+    // The transfer completes but its CRC is wrong.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1), {1, 2, 0b010'00001U}));
+    REQUIRE(1U == canard.rx_stats.crc_errors);
+    REQUIRE(1U == sub.stats.crc_errors);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(2U == trace.size());
+        REQUIRE(CanardTraceEventRxToggleError == trace.at(0).event);
+        REQUIRE(CanardTraceEventRxCRCError == trace.at(1).event);
+        REQUIRE(1U == trace.at(1).metadata.transfer_id);
+    }
+    REQUIRE(3U == canard.rx_stats.frames_accepted);  // The frames of the transfer with the bad CRC are counted.
+    REQUIRE(1U == canard.rx_stats.transfers);
+
+    // The payload exceeds the extent of the subscription.
+    REQUIRE(1 == accept(helpers::makeMessageID(1001, 1), {1, 2, 3, 4, 5, 0b111'00000U}));
+    REQUIRE(1 == accept(helpers::makeMessageID(1001, 1), {1, 2, 3, 4, 0b111'00001U}));  // Not truncated.
+    REQUIRE(1U == canard.rx_stats.truncations);
+    REQUIRE(0U == sub.stats.truncations);
+    REQUIRE(1U == sub_small.stats.truncations);
+    REQUIRE(2U == sub_small.stats.transfers);
+    REQUIRE(3U == canard.rx_stats.transfers);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(1U == trace.size());
+        REQUIRE(CanardTraceEventRxTruncation == trace.at(0).event);
+        REQUIRE(1001U == trace.at(0).metadata.port_id);
+    }
+
+    // Out of memory for the session of a new node.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == accept(helpers::makeMessageID(1000, 3), {1, 0b111'00000U}));
+    REQUIRE(1U == canard.rx_stats.oom_errors);
+    REQUIRE(1U == sub.stats.oom_errors);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(1U == trace.size());
+        REQUIRE(CanardTraceEventRxOutOfMemory == trace.at(0).event);
+        REQUIRE(3U == trace.at(0).metadata.remote_node_id);
+    }
+
+    // Malformed frames are reported without the metadata; the frames of no interest are counted but not traced.
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1) | (UINT32_C(1) << 23U), {1, 0b111'00000U}));
+    REQUIRE(0 == accept(helpers::makeMessageID(2000, 1), {1, 0b111'00000U}));
+    REQUIRE(1U == canard.rx_frames_malformed);
+    REQUIRE(1U == canard.rx_frames_ignored);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(1U == trace.size());
+        REQUIRE(CanardTraceEventRxMalformed == trace.at(0).event);
+        REQUIRE(!trace.at(0).has_metadata);
+    }
+
+    // The counters of the instance cover all subscriptions.
+    REQUIRE(canard.rx_stats.transfers == (sub.stats.transfers + sub_small.stats.transfers));
+    REQUIRE(canard.rx_stats.frames_accepted == (sub.stats.frames_accepted + sub_small.stats.frames_accepted));
+
+    // No events are reported without the hook.
+    canard.trace_hook = nullptr;
+    REQUIRE(0 == accept(helpers::makeMessageID(1000, 1) | (UINT32_C(1) << 23U), {1, 0b111'00000U}));
+    REQUIRE(2U == canard.rx_frames_malformed);
+    REQUIRE(ins.popTrace().empty());
+
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1000));
+    REQUIRE(1 == ins.rxUnsubscribe(CanardTransferKindMessage, 1001));
+}
+
+TEST_CASE("StatsTx")
+{
+    TracingInstance           ins;
+    CanardInstance&           canard = ins.getInstance();
+    helpers::TxQueue          que(3, CANARD_MTU_CAN_CLASSIC);
+    CanardTxQueue&            tx = que.getInstance();
+    std::vector<std::uint8_t> payload(20U);
+    canard.node_id = 42;
+
+    REQUIRE(0U == tx.stats.transfers);
+    REQUIRE(0U == tx.stats.peak_size);
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 321;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 7;
+
+    REQUIRE(1 == que.push(&canard, 1'000, meta, 5, payload.data()));
+    REQUIRE(1U == tx.stats.transfers);
+    REQUIRE(1U == tx.stats.frames);
+    REQUIRE(1U == tx.stats.peak_size);
+
+    // Three frames do not fit into the remaining capacity.
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&canard, 1'000, meta, 15, payload.data()));
+    REQUIRE(1U == tx.stats.oom_errors);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(1U == trace.size());
+        REQUIRE(CanardTraceEventTxOutOfMemory == trace.at(0).event);
+        REQUIRE(trace.at(0).has_metadata);
+        REQUIRE(321U == trace.at(0).metadata.port_id);
+        REQUIRE(7U == trace.at(0).metadata.transfer_id);
+    }
+
+    meta.transfer_id = 8;
+    REQUIRE(2 == que.push(&canard, 2'000, meta, 10, payload.data()));
+    REQUIRE(2U == tx.stats.transfers);
+    REQUIRE(3U == tx.stats.frames);
+    REQUIRE(3U == tx.stats.peak_size);
+
+    // The peak size is retained after the frames are removed.
+    REQUIRE(1U == que.purgeExpired(&canard, 1'500));
+    REQUIRE(1U == tx.stats.frames_expired);
+    REQUIRE(3U == tx.stats.peak_size);
+    REQUIRE(2U == que.purgeExpired(&canard, 2'500));
+    REQUIRE(3U == tx.stats.frames_expired);
+    {
+        const auto trace = ins.popTrace();
+        REQUIRE(3U == trace.size());
+        for (const auto& rec : trace)
+        {
+            REQUIRE(CanardTraceEventTxExpired == rec.event);
+            REQUIRE(!rec.has_metadata);
+        }
+    }
+
+    // Invalid arguments are not counted.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == que.push(&canard, 1'000, meta, 5, nullptr));
+    REQUIRE(2U == tx.stats.transfers);
+    REQUIRE(1U == tx.stats.oom_errors);
+    REQUIRE(ins.popTrace().empty());
+}
@@ -67,7 +67,7 @@ TEST_CASE("TxBasic0")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(20 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
 
     // Check the TX queue.
     {
@@ -109,7 +109,7 @@ TEST_CASE("TxBasic0")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(20 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
 
     // Pop the queue.
     // hex(pyuavcan.transport.commons.crc.CRC16CCITT.new(list(range(8))).value)
@@ -173,7 +173,7 @@ TEST_CASE("TxBasic0")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(40 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
     // Read the generated frames.
     ti = que.peek();
     REQUIRE(nullptr != ti);
@@ -215,7 +215,7 @@ TEST_CASE("TxBasic0")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(40 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
     // Read the generated frames.
     ti = que.peek();
     REQUIRE(nullptr != ti);
@@ -384,7 +384,7 @@ TEST_CASE("TxBasic1")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(20 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
 
     // Check the TX queue.
     {
@@ -424,7 +424,7 @@ TEST_CASE("TxBasic1")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(20 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
 
     // Pop the queue.
     // hex(pyuavcan.transport.commons.crc.CRC16CCITT.new(list(range(8))).value)
@@ -486,7 +486,7 @@ TEST_CASE("TxBasic1")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(40 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
     // Read the generated frames.
     ti = que.peek();
     REQUIRE(nullptr != ti);
@@ -528,7 +528,7 @@ TEST_CASE("TxBasic1")
     REQUIRE(3 == que.getSize());
     REQUIRE(3 == alloc.getNumAllocatedFragments());
     REQUIRE(40 < alloc.getTotalAllocatedAmount());
-    REQUIRE(400 > alloc.getTotalAllocatedAmount());
+    REQUIRE(500 > alloc.getTotalAllocatedAmount());
     // Read the generated frames.
     ti = que.peek();
     REQUIRE(nullptr != ti);
@@ -639,3 +639,1536 @@ TEST_CASE("TxBasic1")
     REQUIRE(nullptr == canardTxPop(nullptr, nullptr));             // No effect.
     REQUIRE(nullptr == canardTxPop(&que.getInstance(), nullptr));  // No effect.
 }
+
+TEST_CASE("TxPool")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    alloc.setAllocationCeiling(0);  // The heap shall not be used at all.
+    ins.setNodeID(42);
+
+    constexpr std::size_t BlockSize = sizeof(CanardTxQueueItem) + CANARD_MTU_CAN_CLASSIC;
+    alignas(std::max_align_t) std::array<std::uint8_t, 10 * BlockSize> arena{};
+    helpers::TxQueue que(100, CANARD_MTU_CAN_CLASSIC, arena.data(), arena.size());
+    REQUIRE(10 == que.getInstance().pool.capacity);
+    REQUIRE(0 == que.getInstance().pool.used);
+
+    std::array<std::uint8_t, 1024> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 321;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 21;
+
+    // Multi-frame and single-frame transfers are served from the pool.
+    REQUIRE(2 == que.push(&ins.getInstance(), 1'000'000'000'000ULL, meta, 8, payload.data()));
+    REQUIRE(1 == que.push(&ins.getInstance(), 1'000'000'000'000ULL, meta, 7, payload.data()));
+    REQUIRE(3 == que.getSize());
+    REQUIRE(3 == que.getInstance().pool.used);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Pool exhaustion: 50 bytes + CRC take 8 frames, only 7 blocks are left. Nothing is leaked.
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 50, payload.data()));
+    REQUIRE(3 == que.getSize());
+    REQUIRE(3 == que.getInstance().pool.used);
+
+    // The MTU is limited by the block size; 20 bytes + CRC take 4 Classic CAN frames instead of one CAN FD frame.
+    que.setMTU(CANARD_MTU_CAN_FD);
+    REQUIRE(4 == que.push(&ins.getInstance(), 1'000'000'000'000ULL, meta, 20, payload.data()));
+    REQUIRE(7 == que.getSize());
+    REQUIRE(7 == que.getInstance().pool.used);
+    for (const auto* const ti : que.linearize())
+    {
+        REQUIRE(ti->frame.payload_size <= CANARD_MTU_CAN_CLASSIC);
+    }
+
+    // Return everything back to the pool.
+    while (const auto* const ti = que.peek())
+    {
+        que.free(&ins.getInstance(), que.pop(ti));
+    }
+    REQUIRE(0 == que.getSize());
+    REQUIRE(0 == que.getInstance().pool.used);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The full capacity of the pool is available again.
+    REQUIRE(10 == que.push(&ins.getInstance(), 1'000'000'000'000ULL, meta, 66, payload.data()));
+    REQUIRE(10 == que.getInstance().pool.used);
+    while (const auto* const ti = que.peek())
+    {
+        que.free(&ins.getInstance(), que.pop(ti));
+    }
+    REQUIRE(0 == que.getInstance().pool.used);
+
+    // A pool that cannot fit a single block rejects everything.
+    helpers::TxQueue tiny(100, CANARD_MTU_CAN_CLASSIC, arena.data(), sizeof(CanardTxQueueItem));
+    REQUIRE(0 == tiny.getInstance().pool.capacity);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == tiny.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+
+    // Without the pool memory, the queue falls back to the heap.
+    alloc.setAllocationCeiling(1024);
+    helpers::TxQueue heap(100, CANARD_MTU_CAN_CLASSIC, nullptr, 0);
+    REQUIRE(0 == heap.getInstance().pool.block_size);
+    REQUIRE(1 == heap.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    heap.free(&ins.getInstance(), heap.pop(heap.peek()));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Error handling.
+    canardTxFree(nullptr, nullptr, nullptr);                        // No effect.
+    canardTxFree(&que.getInstance(), &ins.getInstance(), nullptr);  // No effect.
+}
+
+TEST_CASE("TxPushMany")
+{
+    helpers::Instance ins;
+    helpers::TxQueue  que(10, CANARD_MTU_CAN_CLASSIC);
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 1024> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i & 0xFFU);
+    }
+
+    std::vector<CanardTxBatchItem> batch(3);
+    batch.at(0).tx_deadline_usec        = 1'000'000'000'000ULL;
+    batch.at(0).metadata.priority       = CanardPriorityNominal;
+    batch.at(0).metadata.transfer_kind  = CanardTransferKindMessage;
+    batch.at(0).metadata.port_id        = 100;
+    batch.at(0).metadata.remote_node_id = CANARD_NODE_ID_UNSET;
+    batch.at(0).metadata.transfer_id    = 1;
+    batch.at(0).payload_size            = 8;  // Two frames.
+    batch.at(0).payload                 = payload.data();
+    batch.at(1)                         = batch.at(0);
+    batch.at(1).metadata.priority       = CanardPriorityHigh;
+    batch.at(1).metadata.port_id        = 200;
+    batch.at(1).metadata.transfer_id    = 2;
+    batch.at(1).payload_size            = 3;  // One frame.
+    batch.at(2).tx_deadline_usec        = 1'000'000'000'100ULL;
+    batch.at(2).metadata.priority       = CanardPriorityFast;
+    batch.at(2).metadata.transfer_kind  = CanardTransferKindRequest;
+    batch.at(2).metadata.port_id        = 10;
+    batch.at(2).metadata.remote_node_id = 5;
+    batch.at(2).metadata.transfer_id    = 3;
+    batch.at(2).payload_size            = 20;  // Four frames.
+    batch.at(2).payload                 = payload.data();
+
+    REQUIRE(7 == que.pushMany(&ins.getInstance(), batch));
+    REQUIRE(7 == que.getSize());
+    REQUIRE(7 == alloc.getNumAllocatedFragments());
+    {
+        const auto q = que.linearize();
+        REQUIRE(7 == q.size());
+        // The service request goes first because it has the highest priority; its frames are linked together.
+        for (std::size_t i = 0; i < 4; i++)
+        {
+            REQUIRE(q.at(i)->tx_deadline_usec == 1'000'000'000'100ULL);
+            REQUIRE(q.at(i)->isStartOfTransfer() == (i == 0));
+            REQUIRE(q.at(i)->isEndOfTransfer() == (i == 3));
+            REQUIRE(q.at(i)->next_in_transfer == ((i < 3) ? q.at(i + 1) : nullptr));
+        }
+        REQUIRE(q.at(4)->frame.payload_size == 4);
+        REQUIRE(q.at(4)->isStartOfTransfer());
+        REQUIRE(q.at(4)->isEndOfTransfer());
+        REQUIRE(q.at(4)->next_in_transfer == nullptr);
+        REQUIRE((q.at(4)->getTailByte() & 31U) == 2U);
+        REQUIRE(q.at(5)->isStartOfTransfer());
+        REQUIRE(q.at(5)->next_in_transfer == q.at(6));
+        REQUIRE(q.at(6)->isEndOfTransfer());
+        REQUIRE(q.at(6)->next_in_transfer == nullptr);
+        REQUIRE((q.at(6)->getTailByte() & 31U) == 1U);
+    }
+
+    // The batch does not fit into the remaining capacity; nothing is allocated.
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.pushMany(&ins.getInstance(), {batch.at(0), batch.at(0)}));
+    REQUIRE(7 == que.getSize());
+    REQUIRE(7 == alloc.getNumAllocatedFragments());
+
+    // Invalid item in the middle of the batch: the frames generated for the preceding items are dropped.
+    batch.at(1).metadata.remote_node_id = 1;  // Messages cannot be addressed.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == que.pushMany(&ins.getInstance(), {batch.at(0), batch.at(1)}));
+    REQUIRE(7 == que.getSize());
+    REQUIRE(7 == alloc.getNumAllocatedFragments());
+    batch.at(1).metadata.remote_node_id = CANARD_NODE_ID_UNSET;
+    batch.at(1).payload                 = nullptr;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == que.pushMany(&ins.getInstance(), {batch.at(1)}));
+    batch.at(1).payload = payload.data();
+
+    // Out of memory in the middle of the batch: everything is deallocated.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount() + 150U);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.pushMany(&ins.getInstance(), {batch.at(1), batch.at(0)}));
+    REQUIRE(7 == que.getSize());
+    REQUIRE(7 == alloc.getNumAllocatedFragments());
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // Frame ordering is preserved for the transfers sharing the same CAN ID.
+    REQUIRE(3 == que.pushMany(&ins.getInstance(), {batch.at(1), batch.at(1), batch.at(1)}));
+    REQUIRE(10 == que.getSize());
+    {
+        const auto q = que.linearize();
+        REQUIRE(q.at(4)->frame.extended_can_id == q.at(5)->frame.extended_can_id);
+        REQUIRE(q.at(5)->frame.extended_can_id == q.at(6)->frame.extended_can_id);
+        REQUIRE(q.at(6)->frame.extended_can_id == q.at(7)->frame.extended_can_id);
+    }
+
+    // Empty batch is a no-op.
+    REQUIRE(0 == que.pushMany(&ins.getInstance(), {}));
+    REQUIRE(10 == que.getSize());
+
+    while (const auto* const ti = que.peek())
+    {
+        que.free(&ins.getInstance(), que.pop(ti));
+    }
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Error handling.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushMany(nullptr, nullptr, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushMany(&que.getInstance(), nullptr, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushMany(nullptr, &ins.getInstance(), 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushMany(&que.getInstance(), &ins.getInstance(), 1, nullptr));
+}
+
+TEST_CASE("TxPushV")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+
+    std::array<std::uint8_t, 256> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>((i * 7U) & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 321;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 11;
+
+    // The scattered payload must produce exactly the same frames as the contiguous one regardless of where the
+    // fragment boundaries fall relative to the frame boundaries.
+    const auto check = [&](const std::size_t mtu, const std::size_t size, const std::vector<std::size_t>& cuts) {
+        helpers::TxQueue                   ref(1000, mtu);
+        helpers::TxQueue                   dut(1000, mtu);
+        std::vector<CanardPayloadFragment> frags;
+        std::size_t                        offset = 0;
+        for (const auto c : cuts)
+        {
+            const auto end = std::min(c, size);
+            frags.push_back({end - offset, (end > offset) ? &payload.at(offset) : nullptr});
+            offset = end;
+        }
+        frags.push_back({size - offset, (size > offset) ? &payload.at(offset) : nullptr});
+        const auto num_frames = ref.push(&ins.getInstance(), 1'000'000, meta, size, payload.data());
+        REQUIRE(num_frames > 0);
+        REQUIRE(num_frames == dut.pushV(&ins.getInstance(), 1'000'000, meta, frags));
+        const auto a = ref.linearize();
+        const auto b = dut.linearize();
+        REQUIRE(a.size() == b.size());
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            REQUIRE(a.at(i)->frame.extended_can_id == b.at(i)->frame.extended_can_id);
+            REQUIRE(a.at(i)->tx_deadline_usec == b.at(i)->tx_deadline_usec);
+            REQUIRE(a.at(i)->frame.payload_size == b.at(i)->frame.payload_size);
+            REQUIRE(0 == std::memcmp(a.at(i)->frame.payload, b.at(i)->frame.payload, a.at(i)->frame.payload_size));
+        }
+        while (const auto* const ti = ref.peek())
+        {
+            ref.free(&ins.getInstance(), ref.pop(ti));
+        }
+        while (const auto* const ti = dut.peek())
+        {
+            dut.free(&ins.getInstance(), dut.pop(ti));
+        }
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    };
+
+    ins.setNodeID(42);
+    check(CANARD_MTU_CAN_CLASSIC, 0, {});
+    check(CANARD_MTU_CAN_CLASSIC, 7, {0, 0, 3, 3, 7});
+    check(CANARD_MTU_CAN_CLASSIC, 8, {1});
+    check(CANARD_MTU_CAN_CLASSIC, 13, {5, 6});  // CRC spans two frames.
+    check(CANARD_MTU_CAN_CLASSIC, 100, {3, 7, 8, 50, 51, 99});
+    check(CANARD_MTU_CAN_CLASSIC, 256, {128});
+    check(CANARD_MTU_CAN_FD, 30, {10, 20});  // Single frame with padding.
+    check(CANARD_MTU_CAN_FD, 70, {0, 62, 63, 64});
+    check(CANARD_MTU_CAN_FD, 256, {1, 2, 3, 100, 200, 255});
+    ins.setNodeID(CANARD_NODE_ID_UNSET);  // The pseudo node-ID is derived from the CRC of the scattered payload.
+    check(CANARD_MTU_CAN_CLASSIC, 7, {2, 4});
+    check(CANARD_MTU_CAN_FD, 63, {31});
+    ins.setNodeID(42);
+
+    // Error handling.
+    helpers::TxQueue que(3, CANARD_MTU_CAN_CLASSIC);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushV(nullptr, nullptr, 0, nullptr, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushV(&que.getInstance(), &ins.getInstance(), 0, nullptr, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushV(&que.getInstance(), &ins.getInstance(), 0, &meta, 1, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            que.pushV(&ins.getInstance(), 0, meta, {{3, payload.data()}, {1, nullptr}}));
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.pushV(&ins.getInstance(), 0, meta, {{20, payload.data()}}));
+    REQUIRE(1 == canardTxPushV(&que.getInstance(), &ins.getInstance(), 0, &meta, 0, nullptr));
+    REQUIRE(1 == que.getSize());
+    que.free(&ins.getInstance(), que.pop(que.peek()));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("TxBuckets")
+{
+    helpers::Instance ins;
+    helpers::TxQueue  tree(10'000, CANARD_MTU_CAN_FD);
+    helpers::TxQueue  buckets(10'000, CANARD_MTU_CAN_FD);
+    buckets.getInstance().engine = CanardTxQueueEngineBuckets;
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 256> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>(i & 0xFFU);
+    }
+
+    // The bucket engine shall produce exactly the same transmission order as the tree engine.
+    const auto compare = [&]() {
+        const auto a = tree.linearize();
+        const auto b = buckets.linearize();
+        REQUIRE(a.size() == b.size());
+        REQUIRE(std::equal(a.begin(), a.end(), b.begin(), [](const auto* const x, const auto* const y) {
+            return (x->frame.extended_can_id == y->frame.extended_can_id) &&
+                   (x->frame.payload_size == y->frame.payload_size) &&
+                   (0 == std::memcmp(x->frame.payload, y->frame.payload, x->frame.payload_size));
+        }));
+        REQUIRE((tree.peek() == nullptr) == (buckets.peek() == nullptr));
+    };
+
+    CanardTransferMetadata meta{};
+    for (std::uint32_t i = 0; i < 3'000; i++)
+    {
+        const auto op = helpers::getRandomNatural(3U);
+        if (((op == 0U) && (tree.getSize() < 200U)) || (tree.getSize() == 0))
+        {
+            meta.priority = static_cast<CanardPriority>(helpers::getRandomNatural(CANARD_PRIORITY_MAX + 1U));
+            if (helpers::getRandomNatural(2U) == 0U)
+            {
+                meta.transfer_kind  = CanardTransferKindMessage;
+                meta.port_id        = helpers::getRandomNatural<CanardPortID>(4U);  // Few ports to get equal IDs.
+                meta.remote_node_id = CANARD_NODE_ID_UNSET;
+            }
+            else
+            {
+                meta.transfer_kind  = CanardTransferKindRequest;
+                meta.port_id        = helpers::getRandomNatural<CanardPortID>(4U);
+                meta.remote_node_id = helpers::getRandomNatural<CanardNodeID>(4U);
+            }
+            meta.transfer_id        = static_cast<CanardTransferID>(i);
+            const auto payload_size = helpers::getRandomNatural(std::size(payload));
+
+            const auto mtu = (helpers::getRandomNatural(2U) == 0U) ? CANARD_MTU_CAN_CLASSIC : CANARD_MTU_CAN_FD;
+            tree.setMTU(mtu);
+            buckets.setMTU(mtu);
+            const auto res = tree.push(&ins.getInstance(), i, meta, payload_size, payload.data());
+            REQUIRE(res > 0);
+            REQUIRE(res == buckets.push(&ins.getInstance(), i, meta, payload_size, payload.data()));
+        }
+        else if (op == 1U)  // Pop the top.
+        {
+            tree.free(&ins.getInstance(), tree.pop(tree.peek()));
+            buckets.free(&ins.getInstance(), buckets.pop(buckets.peek()));
+        }
+        else  // Pop an arbitrary item.
+        {
+            const auto index = helpers::getRandomNatural(tree.getSize());
+            tree.free(&ins.getInstance(), canardTxPop(&tree.getInstance(), tree.linearize().at(index)));
+            buckets.free(&ins.getInstance(), canardTxPop(&buckets.getInstance(), buckets.linearize().at(index)));
+            REQUIRE(tree.getSize() == buckets.getSize());
+        }
+        compare();
+    }
+
+    while (const auto* const ti = buckets.peek())
+    {
+        buckets.free(&ins.getInstance(), buckets.pop(ti));
+    }
+    REQUIRE(0 == buckets.getInstance().bucket_mask);
+    REQUIRE(nullptr == buckets.getInstance().root);
+    while (const auto* const ti = tree.peek())
+    {
+        tree.free(&ins.getInstance(), tree.pop(ti));
+    }
+    REQUIRE(0 == ins.getAllocator().getNumAllocatedFragments());
+}
+
+TEST_CASE("TxPurgeExpired")
+{
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        helpers::Instance ins;
+        helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+        que.getInstance().engine = engine;
+        auto& alloc              = ins.getAllocator();
+        ins.setNodeID(42);
+
+        std::array<std::uint8_t, 256> payload{};
+        CanardTransferMetadata        meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 321;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));    // Never expires.
+        REQUIRE(2 == que.push(&ins.getInstance(), 300, meta, 8, payload.data()));  // Pushed out of order.
+        meta.priority = CanardPriorityLow;
+        REQUIRE(3 == que.push(&ins.getInstance(), 100, meta, 16, payload.data()));
+        meta.priority = CanardPriorityHigh;
+        REQUIRE(1 == que.push(&ins.getInstance(), 200, meta, 1, payload.data()));
+        REQUIRE(7 == que.getSize());
+        REQUIRE(7 == alloc.getNumAllocatedFragments());
+
+        REQUIRE(0 == que.purgeExpired(&ins.getInstance(), 99));
+        REQUIRE(7 == que.getSize());
+        REQUIRE(3 == que.purgeExpired(&ins.getInstance(), 100));  // The deadline is inclusive.
+        REQUIRE(4 == que.getSize());
+        REQUIRE(4 == alloc.getNumAllocatedFragments());
+
+        // A frame that has already been popped is not affected.
+        const auto* const top = que.peek();
+        REQUIRE(top->tx_deadline_usec == 200);
+        auto* const popped = que.pop(top);
+        REQUIRE(0 == que.purgeExpired(&ins.getInstance(), 250));
+        REQUIRE(3 == que.getSize());
+        que.free(&ins.getInstance(), popped);
+
+        REQUIRE(2 == que.purgeExpired(&ins.getInstance(), 1'000'000));
+        REQUIRE(1 == que.getSize());
+        REQUIRE(0 == que.peek()->tx_deadline_usec);
+        REQUIRE(0 == que.purgeExpired(&ins.getInstance(), std::numeric_limits<CanardMicrosecond>::max()));
+#if CANARD_TX_DEADLINE_INDEX
+        REQUIRE(nullptr == que.getInstance().deadline_root);
+#endif
+        que.free(&ins.getInstance(), que.pop(que.peek()));
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+        // Error handling.
+        REQUIRE(0 == canardTxPurgeExpired(nullptr, nullptr, 0));
+        REQUIRE(0 == canardTxPurgeExpired(&que.getInstance(), nullptr, 0));
+        REQUIRE(0 == canardTxPurgeExpired(nullptr, &ins.getInstance(), 0));
+    }
+}
+
+TEST_CASE("TxDropTransfer")
+{
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        helpers::Instance ins;
+        helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+        que.getInstance().engine = engine;
+        auto& alloc              = ins.getAllocator();
+        ins.setNodeID(42);
+
+        std::array<std::uint8_t, 256> payload{};
+        CanardTransferMetadata        meta{};
+        meta.priority       = CanardPriorityHigh;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 321;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        REQUIRE(5 == que.push(&ins.getInstance(), 1000, meta, 30, payload.data()));
+        meta.priority = CanardPriorityLow;
+        REQUIRE(3 == que.push(&ins.getInstance(), 2000, meta, 15, payload.data()));
+        REQUIRE(8 == que.getSize());
+
+        // The first frame is popped but fails to transmit; the rest of its transfer is dropped.
+        auto* const failed = que.pop(que.peek());
+        REQUIRE(failed->isStartOfTransfer());
+        REQUIRE(failed->tx_deadline_usec == 1000);
+        REQUIRE(4 == que.dropTransfer(&ins.getInstance(), failed));
+        REQUIRE(3 == que.getSize());
+        REQUIRE(4 == alloc.getNumAllocatedFragments());  // The popped one is still owned by the application.
+        REQUIRE(failed->next_in_transfer != nullptr);   // The popped item is not modified.
+        que.free(&ins.getInstance(), failed);
+        REQUIRE(3 == alloc.getNumAllocatedFragments());
+
+        // The frames that are no longer enqueued are skipped.
+        auto* const first  = que.pop(que.peek());
+        auto* const second = que.pop(que.peek());
+        REQUIRE(first->next_in_transfer == second);
+        REQUIRE(1 == que.dropTransfer(&ins.getInstance(), first));
+        REQUIRE(0 == que.getSize());
+        que.free(&ins.getInstance(), first);
+        que.free(&ins.getInstance(), second);
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+        // An enqueued item is dropped along with the rest of its transfer.
+        REQUIRE(3 == que.push(&ins.getInstance(), 2000, meta, 15, payload.data()));
+        auto* const sent = que.pop(que.peek());
+        REQUIRE(2 == que.dropTransfer(&ins.getInstance(), que.peek()));
+        REQUIRE(0 == que.getSize());
+        que.free(&ins.getInstance(), sent);
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+        // Single-frame transfer.
+        REQUIRE(1 == que.push(&ins.getInstance(), 1000, meta, 1, payload.data()));
+        REQUIRE(1 == que.dropTransfer(&ins.getInstance(), que.peek()));
+        REQUIRE(0 == que.getSize());
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+        // Error handling.
+        REQUIRE(0 == canardTxDropTransfer(nullptr, nullptr, nullptr));
+        REQUIRE(0 == canardTxDropTransfer(&que.getInstance(), &ins.getInstance(), nullptr));
+        REQUIRE(0 == canardTxDropTransfer(&que.getInstance(), nullptr, nullptr));
+    }
+}
+
+TEST_CASE("TxPushShared")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 1024> reference{};
+    for (std::size_t i = 0; i < std::size(reference); i++)
+    {
+        reference.at(i) = static_cast<std::uint8_t>((i * 13U) & 0xFFU);
+    }
+    const auto make_payload = [&](const std::size_t size) {
+        auto* const out = static_cast<std::uint8_t*>(canardTxAllocatePayload(&ins.getInstance(), size));
+        REQUIRE(out != nullptr);
+        std::memcpy(out, reference.data(), size);
+        return out;
+    };
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityNominal;
+    meta.transfer_kind  = CanardTransferKindResponse;
+    meta.port_id        = 400;
+    meta.remote_node_id = 33;
+    meta.transfer_id    = 5;
+
+    const auto drain = [&](helpers::TxQueue& q) {
+        while (const auto* const ti = q.peek())
+        {
+            q.free(&ins.getInstance(), q.pop(ti));
+        }
+    };
+
+    // The lazily materialized frames shall be identical to the eagerly materialized ones.
+    for (const auto mtu : {CANARD_MTU_CAN_CLASSIC, CANARD_MTU_CAN_FD})
+    {
+        for (const std::size_t size : {1U, 7U, 8U, 12U, 13U, 63U, 64U, 100U, 125U, 126U, 127U, 500U, 1024U})
+        {
+            helpers::TxQueue ref(1000, mtu);
+            helpers::TxQueue dut(1000, mtu);
+            const auto       num_frames   = ref.push(&ins.getInstance(), 1'000, meta, size, reference.data());
+            const auto       eager_amount = alloc.getTotalAllocatedAmount();
+            REQUIRE(num_frames > 0);
+            auto* const payload = make_payload(size);
+            REQUIRE(num_frames == dut.pushShared(&ins.getInstance(), 1'000, meta, size, payload));
+            canardTxReleasePayload(&ins.getInstance(), payload);
+            const auto lazy_amount = alloc.getTotalAllocatedAmount() - eager_amount;
+            // The shared block is retained by the multi-frame transfers only.
+            REQUIRE(alloc.getNumAllocatedFragments() ==
+                    (static_cast<std::size_t>(num_frames) * 2U + ((num_frames > 1) ? 1U : 0U)));
+            const auto a = ref.linearize();
+            const auto b = dut.linearize();
+            REQUIRE(a.size() == b.size());
+            for (std::size_t i = 0; i < a.size(); i++)
+            {
+                REQUIRE(a.at(i)->frame.extended_can_id == b.at(i)->frame.extended_can_id);
+                REQUIRE(a.at(i)->frame.payload_size == b.at(i)->frame.payload_size);
+                REQUIRE(a.at(i)->frame.payload != nullptr);
+                CanardPayloadFragment segments[CANARD_TX_FRAME_SEGMENTS_MAX]{};
+                REQUIRE(1 == canardTxGetFrameSegments(a.at(i), &segments[0]));
+                REQUIRE(segments[0].data == a.at(i)->frame.payload);
+                REQUIRE(segments[0].size == a.at(i)->frame.payload_size);
+                const auto num_segments = canardTxGetFrameSegments(b.at(i), &segments[0]);
+                REQUIRE(num_segments == ((b.at(i)->frame.payload == nullptr) ? 2U : 1U));
+                REQUIRE((segments[0].size + ((num_segments > 1) ? segments[1].size : 0U)) ==
+                        b.at(i)->frame.payload_size);
+                std::array<std::uint8_t, CANARD_MTU_CAN_FD> buf{};
+                REQUIRE(b.at(i)->frame.payload_size == canardTxMaterializeFrame(b.at(i), buf.data()));
+                REQUIRE(0 == std::memcmp(a.at(i)->frame.payload, buf.data(), a.at(i)->frame.payload_size));
+            }
+            if (num_frames > 1)
+            {
+                REQUIRE(b.front()->frame.payload == nullptr);
+                if ((mtu == CANARD_MTU_CAN_FD) && (size >= 500U))
+                {
+                    // The serialization buffer is not duplicated; the frames are much smaller.
+                    REQUIRE(lazy_amount < (eager_amount + size / 2U));
+                }
+            }
+            drain(ref);
+            REQUIRE(ref.getSize() == 0);
+            drain(dut);
+            REQUIRE(0 == alloc.getNumAllocatedFragments());
+        }
+    }
+
+    // The shared block is released together with the last reference to it, in any order.
+    helpers::TxQueue que_a(100, CANARD_MTU_CAN_FD);
+    helpers::TxQueue que_b(100, CANARD_MTU_CAN_FD);
+    auto* payload = make_payload(300);
+    REQUIRE(5 == que_a.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    REQUIRE(5 == que_b.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));  // Redundant interface.
+    REQUIRE(11 == alloc.getNumAllocatedFragments());
+    canardTxReleasePayload(&ins.getInstance(), payload);
+    REQUIRE(11 == alloc.getNumAllocatedFragments());  // Still referenced by the frames.
+    drain(que_b);
+    REQUIRE(6 == alloc.getNumAllocatedFragments());
+    {
+        const auto q = que_a.linearize();
+        REQUIRE(q.at(0)->isStartOfTransfer());
+        REQUIRE(q.at(4)->isEndOfTransfer());
+        std::vector<CanardTxQueueItem*> popped;
+        for (const auto* const ti : q)
+        {
+            popped.push_back(que_a.pop(ti));
+        }
+        que_a.free(&ins.getInstance(), popped.at(4));
+        que_a.free(&ins.getInstance(), popped.at(0));
+        que_a.free(&ins.getInstance(), popped.at(2));
+        que_a.free(&ins.getInstance(), popped.at(1));
+        REQUIRE(2 == alloc.getNumAllocatedFragments());
+        que_a.free(&ins.getInstance(), popped.at(3));
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    }
+
+    // Dropping and purging release the shared block as well.
+    payload = make_payload(300);
+    REQUIRE(5 == que_a.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    REQUIRE(5 == que_b.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    canardTxReleasePayload(&ins.getInstance(), payload);
+    REQUIRE(5 == que_a.dropTransfer(&ins.getInstance(), que_a.peek()));
+    REQUIRE(6 == alloc.getNumAllocatedFragments());
+    REQUIRE(5 == que_b.purgeExpired(&ins.getInstance(), 1'000));
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Out of memory: no references are leaked.
+    payload = make_payload(300);
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount() + 300);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que_a.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    que_a.getInstance().capacity = 4;
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que_a.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    REQUIRE(1 == alloc.getNumAllocatedFragments());
+    que_a.getInstance().capacity = 100;
+
+    // The sharing is not used with queues backed by a frame pool.
+    std::vector<std::uint8_t> arena(4096);
+    helpers::TxQueue          pooled(100, CANARD_MTU_CAN_FD, arena.data(), arena.size());
+    REQUIRE(5 == pooled.pushShared(&ins.getInstance(), 1'000, meta, 300, payload));
+    canardTxReleasePayload(&ins.getInstance(), payload);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    REQUIRE(5 == pooled.getInstance().pool.used);
+    for (const auto* const ti : pooled.linearize())
+    {
+        REQUIRE(ti->frame.payload != nullptr);
+    }
+    drain(pooled);
+    REQUIRE(0 == pooled.getInstance().pool.used);
+
+    // Empty transfers do not need a buffer.
+    REQUIRE(1 == que_a.pushShared(&ins.getInstance(), 1'000, meta, 0, nullptr));
+    drain(que_a);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Error handling.
+    CanardPayloadFragment segments[CANARD_TX_FRAME_SEGMENTS_MAX]{};
+    REQUIRE(0 == canardTxGetFrameSegments(nullptr, &segments[0]));
+    REQUIRE(0 == canardTxMaterializeFrame(nullptr, reference.data()));
+    REQUIRE(nullptr == canardTxAllocatePayload(&ins.getInstance(), 0));
+    REQUIRE(nullptr == canardTxAllocatePayload(nullptr, 1));
+    canardTxReleasePayload(&ins.getInstance(), nullptr);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushShared(&que_a.getInstance(), &ins.getInstance(), 0, &meta, 1, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushShared(nullptr, nullptr, 0, nullptr, 0, nullptr));
+}
+
+TEST_CASE("TxPushRedundant")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 1024> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>((i * 31U) & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityHigh;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 1234;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 7;
+
+    const auto drain = [&](helpers::TxQueue& q) {
+        while (const auto* const ti = q.peek())
+        {
+            q.free(&ins.getInstance(), q.pop(ti));
+        }
+    };
+    // Each queue shall contain the same frames as if canardTxPush() was used.
+    const auto check = [&](helpers::TxQueue& q, const std::size_t payload_size) {
+        helpers::TxQueue ref(1000, q.getMTU());
+        REQUIRE(0 < ref.push(&ins.getInstance(), 1'000, meta, payload_size, payload.data()));
+        const auto a = ref.linearize();
+        const auto b = q.linearize();
+        REQUIRE(a.size() == b.size());
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            REQUIRE(a.at(i)->frame.extended_can_id == b.at(i)->frame.extended_can_id);
+            REQUIRE(a.at(i)->tx_deadline_usec == b.at(i)->tx_deadline_usec);
+            REQUIRE(a.at(i)->frame.payload_size == b.at(i)->frame.payload_size);
+            std::array<std::uint8_t, CANARD_MTU_CAN_FD> buf{};
+            REQUIRE(b.at(i)->frame.payload_size == canardTxMaterializeFrame(b.at(i), buf.data()));
+            REQUIRE(0 == std::memcmp(a.at(i)->frame.payload, buf.data(), a.at(i)->frame.payload_size));
+        }
+        drain(ref);
+    };
+
+    helpers::TxQueue               q0(100, CANARD_MTU_CAN_FD);
+    helpers::TxQueue               q1(100, CANARD_MTU_CAN_FD);
+    helpers::TxQueue               q2(100, CANARD_MTU_CAN_FD);
+    std::array<CanardTxQueue*, 3>  group{&q0.getInstance(), &q1.getInstance(), &q2.getInstance()};
+    std::array<std::int32_t, 3>    results{};
+    const auto push_eager = [&](const std::size_t payload_size) {
+        return canardTxPushRedundant(group.data(),
+                                     group.size(),
+                                     &ins.getInstance(),
+                                     1'000,
+                                     &meta,
+                                     payload_size,
+                                     payload.data(),
+                                     results.data());
+    };
+    const auto push = [&](const std::size_t payload_size) {
+        return canardTxPushRedundantShared(group.data(),
+                                           group.size(),
+                                           &ins.getInstance(),
+                                           1'000,
+                                           &meta,
+                                           payload_size,
+                                           payload.data(),
+                                           results.data());
+    };
+
+    // By default, the frames are materialized eagerly, exactly as if canardTxPush() was invoked for each queue.
+    REQUIRE(3 == push_eager(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{5, 5, 5});
+    REQUIRE(15 == alloc.getNumAllocatedFragments());
+    for (auto* const q : {&q0, &q1, &q2})
+    {
+        check(*q, 300);
+        for (const auto* const ti : q->linearize())
+        {
+            REQUIRE(ti->frame.payload != nullptr);
+        }
+    }
+    while (const auto* const ti = q0.peek())  // Like those of canardTxPush(), the frames own their memory.
+    {
+        ins.getInstance().memory_free(&ins.getInstance(), q0.pop(ti));
+    }
+    drain(q1);
+    drain(q2);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Multi-frame transfer with sharing: the payload is stored once for all interfaces.
+    REQUIRE(3 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{5, 5, 5});
+    REQUIRE(16 == alloc.getNumAllocatedFragments());
+    check(q0, 300);
+    check(q1, 300);
+    check(q2, 300);
+    drain(q0);
+    drain(q2);
+    REQUIRE(6 == alloc.getNumAllocatedFragments());  // The shared block is still referenced by the second queue.
+    drain(q1);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Single-frame transfer: no shared block is needed.
+    REQUIRE(3 == push(20));
+    REQUIRE(results == std::array<std::int32_t, 3>{1, 1, 1});
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    check(q1, 20);
+    drain(q0);
+    drain(q1);
+    drain(q2);
+
+    // Mixed MTU: the frames are generated separately for each MTU; the transfer is single-frame for some queues.
+    q1.setMTU(CANARD_MTU_CAN_CLASSIC);
+    REQUIRE(3 == push(60));
+    REQUIRE(results == std::array<std::int32_t, 3>{1, 9, 1});
+    REQUIRE(12 == alloc.getNumAllocatedFragments());  // Nine frames on the classic queue plus the shared block.
+    check(q0, 60);
+    check(q1, 60);
+    check(q2, 60);
+    drain(q0);
+    drain(q1);
+    drain(q2);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    q1.setMTU(CANARD_MTU_CAN_FD);
+
+    // A full queue does not prevent the other queues from accepting the transfer.
+    q0.getInstance().capacity = 4;
+    REQUIRE(2 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{-CANARD_ERROR_OUT_OF_MEMORY, 5, 5});
+    q0.getInstance().capacity = 100;
+    q2.getInstance().capacity = 4;
+    REQUIRE(2 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{5, 5, -CANARD_ERROR_OUT_OF_MEMORY});
+    q2.getInstance().capacity = 100;
+    drain(q0);
+    drain(q1);
+    drain(q2);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Out of memory: the queues that could not be served report the error, the others accept the transfer.
+    REQUIRE(3 == push(300));
+    const std::size_t total_amount = alloc.getTotalAllocatedAmount();
+    drain(q0);
+    const std::size_t per_queue_amount = total_amount - alloc.getTotalAllocatedAmount();
+    drain(q1);
+    drain(q2);
+    alloc.setAllocationCeiling(total_amount - per_queue_amount - 1U);
+    REQUIRE(1 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{5, -CANARD_ERROR_OUT_OF_MEMORY, -CANARD_ERROR_OUT_OF_MEMORY});
+    REQUIRE(0 == q1.getSize());
+    REQUIRE(0 == q2.getSize());
+    drain(q0);
+    alloc.setAllocationCeiling(0);
+    REQUIRE(0 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{-CANARD_ERROR_OUT_OF_MEMORY,
+                                                   -CANARD_ERROR_OUT_OF_MEMORY,
+                                                   -CANARD_ERROR_OUT_OF_MEMORY});
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Queues backed by a frame pool use eagerly materialized frames.
+    std::vector<std::uint8_t> arena(4096);
+    helpers::TxQueue          pooled(100, CANARD_MTU_CAN_FD, arena.data(), arena.size());
+    group.at(1) = &pooled.getInstance();
+    REQUIRE(3 == push(300));
+    REQUIRE(results == std::array<std::int32_t, 3>{5, 5, 5});
+    REQUIRE(11 == alloc.getNumAllocatedFragments());
+    REQUIRE(5 == pooled.getInstance().pool.used);
+    check(pooled, 300);
+    drain(q0);
+    drain(pooled);
+    drain(q2);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    group.at(1) = &q1.getInstance();
+
+    // Errors detected per queue.
+    ins.setNodeID(CANARD_NODE_ID_UNSET);
+    REQUIRE(0 == push(300));  // Anonymous nodes cannot emit multi-frame transfers.
+    REQUIRE(results == std::array<std::int32_t, 3>{-CANARD_ERROR_INVALID_ARGUMENT,
+                                                   -CANARD_ERROR_INVALID_ARGUMENT,
+                                                   -CANARD_ERROR_INVALID_ARGUMENT});
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    ins.setNodeID(42);
+
+    // The results are optional.
+    REQUIRE(3 == canardTxPushRedundant(group.data(), 3, &ins.getInstance(), 0, &meta, 0, nullptr, nullptr));
+    drain(q0);
+    drain(q1);
+    drain(q2);
+
+    // Error handling.
+    const auto ins_ptr = &ins.getInstance();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(nullptr, 3, ins_ptr, 0, &meta, 0, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(group.data(), 0, ins_ptr, 0, &meta, 0, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(group.data(), 3, nullptr, 0, &meta, 0, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(group.data(), 3, ins_ptr, 0, nullptr, 0, nullptr, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(group.data(), 3, ins_ptr, 0, &meta, 1, nullptr, nullptr));
+    group.at(2) = nullptr;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+            canardTxPushRedundant(group.data(), 3, ins_ptr, 0, &meta, 0, nullptr, nullptr));
+    REQUIRE(0 == q0.getSize());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("TxPushDirect")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    std::array<std::uint8_t, 1024> payload{};
+    for (std::size_t i = 0; i < std::size(payload); i++)
+    {
+        payload.at(i) = static_cast<std::uint8_t>((i * 7U) & 0xFFU);
+    }
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityFast;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 777;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 3;
+
+    // A model of a hardware TX FIFO with a limited number of free slots.
+    struct Hardware
+    {
+        std::size_t                                 free_slots = std::numeric_limits<std::size_t>::max();
+        std::size_t                                 acquired   = 0;
+        std::array<std::uint8_t, CANARD_MTU_CAN_FD> slot{};
+        std::vector<std::vector<std::uint8_t>>      frames;
+        std::vector<std::uint32_t>                  can_ids;
+        std::vector<CanardMicrosecond>              deadlines;
+    } hw;
+    CanardTxFrameSink sink{};
+    sink.user_reference = &hw;
+    sink.acquire        = [](CanardTxFrameSink* const self, const std::size_t payload_size) -> void* {
+        auto* const h = static_cast<Hardware*>(self->user_reference);
+        REQUIRE(h->acquired == h->frames.size());  // Every acquisition is followed by a commit.
+        REQUIRE(payload_size > 0);
+        REQUIRE(payload_size <= CANARD_MTU_CAN_FD);
+        REQUIRE(CanardCANDLCToLength[CanardCANLengthToDLC[payload_size]] == payload_size);
+        if (h->free_slots == 0)
+        {
+            return nullptr;
+        }
+        h->free_slots--;
+        h->acquired++;
+        std::memset(h->slot.data(), 0xAA, h->slot.size());
+        return h->slot.data();
+    };
+    sink.commit = [](CanardTxFrameSink* const self,
+                     const CanardMicrosecond  tx_deadline_usec,
+                     const CanardFrame* const frame) {
+        auto* const h = static_cast<Hardware*>(self->user_reference);
+        REQUIRE(frame->payload == h->slot.data());
+        const auto* const data = static_cast<const std::uint8_t*>(frame->payload);
+        h->frames.emplace_back(data, data + frame->payload_size);
+        h->can_ids.push_back(frame->extended_can_id);
+        h->deadlines.push_back(tx_deadline_usec);
+    };
+    const auto reset = [&](const std::size_t free_slots) {
+        hw.free_slots = free_slots;
+        hw.acquired   = 0;
+        hw.frames.clear();
+        hw.can_ids.clear();
+        hw.deadlines.clear();
+    };
+    const auto drain = [&](helpers::TxQueue& q) {
+        while (const auto* const ti = q.peek())
+        {
+            q.free(&ins.getInstance(), q.pop(ti));
+        }
+    };
+    // The frames written into the sink followed by the enqueued frames shall match those produced by canardTxPush().
+    const auto check = [&](helpers::TxQueue& q, const std::size_t payload_size) {
+        helpers::TxQueue ref(1000, q.getMTU());
+        REQUIRE(0 < ref.push(&ins.getInstance(), 1'000, meta, payload_size, payload.data()));
+        const auto a = ref.linearize();
+        const auto b = q.linearize();
+        REQUIRE(a.size() == (hw.frames.size() + b.size()));
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            const auto* const ref_data = static_cast<const std::uint8_t*>(a.at(i)->frame.payload);
+            const std::vector<std::uint8_t> expected(ref_data, ref_data + a.at(i)->frame.payload_size);
+            if (i < hw.frames.size())
+            {
+                REQUIRE(a.at(i)->frame.extended_can_id == hw.can_ids.at(i));
+                REQUIRE(1'000 == hw.deadlines.at(i));
+                REQUIRE(expected == hw.frames.at(i));
+            }
+            else
+            {
+                const auto* const item = b.at(i - hw.frames.size());
+                const auto* const data = static_cast<const std::uint8_t*>(item->frame.payload);
+                REQUIRE(a.at(i)->frame.extended_can_id == item->frame.extended_can_id);
+                REQUIRE(1'000 == item->tx_deadline_usec);
+                REQUIRE(expected == std::vector<std::uint8_t>(data, data + item->frame.payload_size));
+            }
+        }
+        drain(ref);
+    };
+    const auto push = [&](helpers::TxQueue& q, const std::size_t payload_size) {
+        return canardTxPushDirect(&q.getInstance(),
+                                  &ins.getInstance(),
+                                  &sink,
+                                  1'000,
+                                  &meta,
+                                  payload_size,
+                                  payload.data());
+    };
+
+    helpers::TxQueue que(10, CANARD_MTU_CAN_FD);
+
+    // The hardware accepts all frames, nothing is allocated.
+    REQUIRE(5 == push(que, 300));
+    REQUIRE(5 == hw.frames.size());
+    REQUIRE(0 == que.getSize());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    check(que, 300);
+    reset(std::numeric_limits<std::size_t>::max());
+    REQUIRE(1 == push(que, 40));
+    REQUIRE(48 == hw.frames.at(0).size());
+    check(que, 40);
+    reset(std::numeric_limits<std::size_t>::max());
+    REQUIRE(1 == push(que, 0));
+    check(que, 0);
+    reset(std::numeric_limits<std::size_t>::max());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Backpressure: the remainder of the transfer is enqueued.
+    reset(2);
+    REQUIRE(5 == push(que, 300));
+    REQUIRE(2 == hw.frames.size());
+    REQUIRE(3 == que.getSize());
+    REQUIRE(3 == alloc.getNumAllocatedFragments());
+    check(que, 300);
+
+    // The queue is not empty, so the sink is not used to preserve the transmission order.
+    reset(std::numeric_limits<std::size_t>::max());
+    meta.transfer_id = 4;
+    REQUIRE(1 == push(que, 10));
+    REQUIRE(0 == hw.acquired);
+    REQUIRE(4 == que.getSize());
+    drain(que);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // The hardware is full from the start.
+    reset(0);
+    REQUIRE(1 == push(que, 10));
+    REQUIRE(1 == que.getSize());
+    check(que, 10);
+    drain(que);
+
+    // CAN classic.
+    que.setMTU(CANARD_MTU_CAN_CLASSIC);
+    reset(4);
+    REQUIRE(9 == push(que, 60));
+    REQUIRE(4 == hw.frames.size());
+    REQUIRE(5 == que.getSize());
+    check(que, 60);
+    drain(que);
+    que.setMTU(CANARD_MTU_CAN_FD);
+
+    // The queue capacity is checked before anything is written into the sink.
+    reset(std::numeric_limits<std::size_t>::max());
+    que.getInstance().capacity = 4;
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == push(que, 300));
+    REQUIRE(0 == hw.acquired);
+    REQUIRE(4 == push(que, 220));  // Fits into the queue even though it is not going to be enqueued.
+    REQUIRE(0 == que.getSize());
+    que.getInstance().capacity = 10;
+
+    // Out of memory while enqueueing the remainder: the committed frames cannot be withdrawn.
+    reset(1);
+    alloc.setAllocationCeiling(sizeof(exposed::TxItem) * 3U);
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == push(que, 300));
+    REQUIRE(1 == hw.frames.size());
+    REQUIRE(0 == que.getSize());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+
+    // The remainder is allocated from the frame pool if the queue has one.
+    std::vector<std::uint8_t> arena(4096);
+    helpers::TxQueue          pooled(10, CANARD_MTU_CAN_FD, arena.data(), arena.size());
+    reset(3);
+    REQUIRE(5 == push(pooled, 300));
+    REQUIRE(3 == hw.frames.size());
+    REQUIRE(2 == pooled.getInstance().pool.used);
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+    check(pooled, 300);
+    drain(pooled);
+
+    // Without the sink, the function behaves like canardTxPush().
+    reset(std::numeric_limits<std::size_t>::max());
+    REQUIRE(5 ==
+            canardTxPushDirect(&que.getInstance(), &ins.getInstance(), nullptr, 1'000, &meta, 300, payload.data()));
+    REQUIRE(5 == que.getSize());
+    check(que, 300);
+    drain(que);
+
+    // Error handling.
+    auto& q = que.getInstance();
+    auto& i = ins.getInstance();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushDirect(nullptr, &i, &sink, 0, &meta, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushDirect(&q, nullptr, &sink, 0, &meta, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushDirect(&q, &i, &sink, 0, nullptr, 0, nullptr));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxPushDirect(&q, &i, &sink, 0, &meta, 1, nullptr));
+    ins.setNodeID(CANARD_NODE_ID_UNSET);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == push(que, 300));  // Anonymous multi-frame transfers are not allowed.
+    REQUIRE(0 == hw.acquired);
+    REQUIRE(0 == que.getSize());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}
+
+TEST_CASE("TxMemoryUsage")
+{
+    // The macros are usable in constant expressions; the functions return the exact values which cannot be larger.
+    static_assert(CANARD_TX_ITEM_SIZE(CANARD_MTU_CAN_FD) == (sizeof(CanardTxQueueItem) + 64U));
+    static_assert(CANARD_TX_QUEUE_WORST_CASE_BYTES(10, 8) == (10U * CANARD_TX_ITEM_SIZE(8)));
+    REQUIRE(CANARD_TX_QUEUE_WORST_CASE_BYTES(10, 8) == canardTxQueueWorstCaseBytes(10, 8));
+    REQUIRE(CANARD_TX_QUEUE_WORST_CASE_BYTES(10, 64) == canardTxQueueWorstCaseBytes(10, 64));
+    REQUIRE(canardTxQueueWorstCaseBytes(10, 12) == canardTxQueueWorstCaseBytes(10, 10));  // Rounded up to a DLC.
+    REQUIRE(canardTxQueueWorstCaseBytes(10, 64) == canardTxQueueWorstCaseBytes(10, 1000));
+    REQUIRE(canardTxQueueWorstCaseBytes(10, 8) == canardTxQueueWorstCaseBytes(10, 0));
+    REQUIRE(0U == canardTxQueueWorstCaseBytes(0, 64));
+
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        helpers::Instance ins;
+        helpers::TxQueue  que_a(100, CANARD_MTU_CAN_FD);
+        helpers::TxQueue  que_b(100, CANARD_MTU_CAN_CLASSIC);
+        que_a.getInstance().engine = engine;
+        que_b.getInstance().engine = engine;
+        auto& alloc                = ins.getAllocator();
+        ins.setNodeID(42);
+
+        std::array<std::uint8_t, 256> payload{};
+        CanardTransferMetadata        meta{};
+        meta.priority       = CanardPriorityNominal;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 321;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+
+        REQUIRE(1 == que_a.push(&ins.getInstance(), 0, meta, 10, payload.data()));
+        REQUIRE(5 == que_a.push(&ins.getInstance(), 0, meta, 256, payload.data()));
+        meta.priority = CanardPriorityLow;
+        REQUIRE(3 == que_b.push(&ins.getInstance(), 0, meta, 16, payload.data()));
+
+        const std::array<const CanardTxQueue*, 2> ques{&que_a.getInstance(), &que_b.getInstance()};
+        CanardMemoryUsage usage = canardInstanceMemoryUsage(&ins.getInstance(), ques.data(), ques.size());
+        REQUIRE(9U == usage.tx_frames);
+        REQUIRE(0U == usage.rx_sessions);
+        REQUIRE(alloc.getTotalAllocatedAmount() == usage.total_bytes);
+        REQUIRE(usage.total_bytes <= (canardTxQueueWorstCaseBytes(6, 64) + canardTxQueueWorstCaseBytes(3, 8)));
+
+        // Lazily materialized frames are smaller; the shared block is not included.
+        void* const shared = canardTxAllocatePayload(&ins.getInstance(), 200);
+        REQUIRE(shared != nullptr);
+        REQUIRE(4 == que_a.pushShared(&ins.getInstance(), 0, meta, 200, shared));
+        canardTxReleasePayload(&ins.getInstance(), shared);
+        usage = canardInstanceMemoryUsage(&ins.getInstance(), ques.data(), ques.size());
+        REQUIRE(13U == usage.tx_frames);
+        REQUIRE((usage.total_bytes + 200U + sizeof(std::size_t)) == alloc.getTotalAllocatedAmount());
+        REQUIRE(usage.total_bytes < (canardTxQueueWorstCaseBytes(10, 64) + canardTxQueueWorstCaseBytes(3, 8)));
+
+        // Only the specified queues are included.
+        usage = canardInstanceMemoryUsage(&ins.getInstance(), ques.data(), 1U);
+        REQUIRE(10U == usage.tx_frames);
+
+        while (const auto* const item = que_a.peek())
+        {
+            que_a.free(&ins.getInstance(), que_a.pop(item));
+        }
+        while (const auto* const item = que_b.peek())
+        {
+            que_b.free(&ins.getInstance(), que_b.pop(item));
+        }
+        REQUIRE(0U == canardInstanceMemoryUsage(&ins.getInstance(), ques.data(), ques.size()).total_bytes);
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("TxReservations")
+{
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        helpers::Instance ins;
+        helpers::TxQueue  que(10, CANARD_MTU_CAN_CLASSIC);
+        que.getInstance().engine = engine;
+        auto& alloc              = ins.getAllocator();
+        ins.setNodeID(42);
+
+        std::array<std::uint8_t, 256> payload{};
+        CanardTransferMetadata        meta{};
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 321;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+
+        // Four frames are reserved for the nominal priority, so six are shared.
+        que.getInstance().reserved[CanardPriorityNominal] = 4;
+        meta.priority                                     = CanardPriorityLow;
+        REQUIRE(5 == que.push(&ins.getInstance(), 0, meta, 30, payload.data()));
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 30, payload.data()));
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        REQUIRE(6 == que.getSize());
+        REQUIRE(6 == que.getInstance().size_by_priority[CanardPriorityLow]);
+
+        // The low-priority traffic could not consume the reservation.
+        meta.priority = CanardPriorityNominal;
+        for (auto i = 0U; i < 4U; i++)
+        {
+            REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        }
+        REQUIRE(10 == que.getSize());
+        REQUIRE(4 == que.getInstance().size_by_priority[CanardPriorityNominal]);
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+
+        // The nominal frames go first; once they are out, the reservation is available again.
+        for (auto i = 0U; i < 4U; i++)
+        {
+            auto* const item = que.pop(que.peek());
+            REQUIRE(((item->frame.extended_can_id >> 26U) & CANARD_PRIORITY_MAX) == CanardPriorityNominal);
+            que.free(&ins.getInstance(), item);
+        }
+        REQUIRE(0 == que.getInstance().size_by_priority[CanardPriorityNominal]);
+        meta.priority = CanardPriorityLow;
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+
+        // A batch is admitted as a whole considering the priority of each item; it is either accepted or not.
+        std::array<CanardTxBatchItem, 2> batch{};
+        batch.at(0).metadata             = meta;
+        batch.at(0).metadata.priority    = CanardPriorityNominal;
+        batch.at(0).payload_size         = 13;  // 3 frames.
+        batch.at(0).payload              = payload.data();
+        batch.at(1).metadata             = meta;
+        batch.at(1).metadata.priority    = CanardPriorityLow;
+        batch.at(1).metadata.transfer_id = 1;
+        batch.at(1).payload_size         = 1;
+        batch.at(1).payload              = payload.data();
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY ==
+                canardTxPushMany(&que.getInstance(), &ins.getInstance(), batch.size(), batch.data()));
+        REQUIRE(6 == que.getSize());
+        REQUIRE(3 == canardTxPushMany(&que.getInstance(), &ins.getInstance(), 1, batch.data()));
+        REQUIRE(9 == que.getSize());
+        REQUIRE(3 == que.getInstance().size_by_priority[CanardPriorityNominal]);
+
+        // If the reservations exceed the capacity, there is no shared part, but the capacity limit still holds.
+        que.getInstance().reserved[CanardPriorityExceptional] = 20;
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        meta.priority = CanardPriorityExceptional;
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+        REQUIRE(10 == que.getSize());
+
+        // Purging and dropping keep the counters consistent; they are validated by the helper on every operation.
+        while (const auto* const item = que.peek())
+        {
+            REQUIRE(0 < que.dropTransfer(&ins.getInstance(), item));
+        }
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+        for (const auto x : que.getInstance().size_by_priority)
+        {
+            REQUIRE(0 == x);
+        }
+    }
+}
+
+TEST_CASE("TxShaping")
+{
+    for (const auto engine : {CanardTxQueueEngineTree, CanardTxQueueEngineBuckets})
+    {
+        helpers::Instance ins;
+        helpers::TxQueue  que(100, CANARD_MTU_CAN_CLASSIC);
+        que.getInstance().engine = engine;
+        auto& alloc              = ins.getAllocator();
+        auto& tx                 = que.getInstance();
+        ins.setNodeID(42);
+
+        CanardMicrosecond eligible = 0;
+
+        // Pops the frame returned by the shaped peek and checks its properties.
+        const auto pop_shaped = [&](const CanardMicrosecond now, const CanardPortID port_id, const std::size_t size) {
+            const auto* const item = canardTxPeekShaped(&tx, now, &eligible);
+            REQUIRE(item != nullptr);
+            REQUIRE(eligible == now);
+            REQUIRE(size == item->frame.payload_size);
+            REQUIRE(port_id == ((item->frame.extended_can_id >> 8U) & CANARD_SUBJECT_ID_MAX));
+            que.free(&ins.getInstance(), canardTxPop(&tx, item));
+        };
+
+        // Error handling.
+        std::array<CanardTxShaper, 3> shapers{};
+        REQUIRE(nullptr == canardTxPeekShaped(nullptr, 0, &eligible));
+        REQUIRE(UINT64_MAX == eligible);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, 0, nullptr));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+                canardTxShape(nullptr, CanardTransferKindMessage, 1, 1, 1, &shapers.at(0)));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxShape(&tx, CanardTransferKindMessage, 1, 1, 1, nullptr));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT ==
+                canardTxShape(&tx, static_cast<CanardTransferKind>(3), 1, 1, 1, &shapers.at(0)));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxUnshape(nullptr, CanardTransferKindMessage, 1));
+        REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxUnshape(&tx, static_cast<CanardTransferKind>(3), 1));
+        REQUIRE(0 == canardTxUnshape(&tx, CanardTransferKindMessage, 1000));
+
+        // 800 bytes per second means 10 ms per full Classic CAN frame; the burst is two frames.
+        REQUIRE(1 == canardTxShape(&tx, CanardTransferKindMessage, 1000, 800, 16, &shapers.at(0)));
+        REQUIRE(0 == canardTxShape(&tx, CanardTransferKindMessage, 1000, 800, 16, &shapers.at(0)));  // Replaced.
+        REQUIRE(&shapers.at(0) == tx.shapers);
+        REQUIRE(nullptr == shapers.at(0).next);
+
+        std::array<std::uint8_t, 256> payload{};
+        CanardTransferMetadata        meta{};
+        meta.priority       = CanardPrioritySlow;
+        meta.transfer_kind  = CanardTransferKindMessage;
+        meta.port_id        = 1000;
+        meta.remote_node_id = CANARD_NODE_ID_UNSET;
+        REQUIRE(5 == que.push(&ins.getInstance(), 0, meta, 30, payload.data()));  // Frames of 8, 8, 8, 8, 5 bytes.
+        meta.priority = CanardPriorityOptional;
+        meta.port_id  = 2000;
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 1, payload.data()));
+
+        // The burst is spent, then the bulk transfer is held back while the lower-priority frame passes.
+        const CanardMicrosecond t0 = 1'000'000;
+        pop_shaped(t0, 1000, 8);
+        pop_shaped(t0, 1000, 8);
+        REQUIRE(canardTxPeek(&tx) != canardTxPeekShaped(&tx, t0, &eligible));  // The plain peek is not affected.
+        pop_shaped(t0, 2000, 2);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0, &eligible));
+        REQUIRE((t0 + 10'000) == eligible);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 9'999, &eligible));
+        REQUIRE((t0 + 10'000) == eligible);
+        pop_shaped(t0 + 10'000, 1000, 8);
+
+        // After 6.25 ms the credit covers the last frame but not the one before it, which shall not be overtaken.
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 16'250, &eligible));
+        REQUIRE((t0 + 20'000) == eligible);
+        pop_shaped(t0 + 20'000, 1000, 8);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 20'000, &eligible));
+        REQUIRE((t0 + 26'250) == eligible);
+        pop_shaped(t0 + 26'250, 1000, 5);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 26'250, &eligible));
+        REQUIRE(UINT64_MAX == eligible);  // Empty.
+
+        // A long idle period does not accumulate more than the burst.
+        meta.priority = CanardPrioritySlow;
+        meta.port_id  = 1000;
+        REQUIRE(5 == que.push(&ins.getInstance(), 0, meta, 30, payload.data()));
+        pop_shaped(t0 + 1'000'000'000, 1000, 8);
+        pop_shaped(t0 + 1'000'000'000, 1000, 8);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 1'000'000'000, &eligible));
+        REQUIRE((t0 + 1'000'010'000) == eligible);
+
+        // A frame larger than the burst passes when the bucket is full, leaving a debt.
+        shapers.at(0).burst_bytes = 4;
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 1'000'004'999, &eligible));
+        REQUIRE((t0 + 1'000'005'000) == eligible);
+        pop_shaped(t0 + 1'000'005'000, 1000, 8);
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 1'000'005'000, &eligible));
+        REQUIRE((t0 + 1'000'015'000) == eligible);
+
+        // Without the rate, the frames are held back forever once the burst is spent.
+        shapers.at(0).rate_bytes_per_second = 0;
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0 + 2'000'000'000, &eligible));
+        REQUIRE(UINT64_MAX == eligible);
+
+        // Once the shaper is removed, the frames are released.
+        REQUIRE(1 == canardTxUnshape(&tx, CanardTransferKindMessage, 1000));
+        REQUIRE(nullptr == tx.shapers);
+        pop_shaped(t0, 1000, 8);
+        pop_shaped(t0, 1000, 5);
+
+        // The transfer kinds are told apart; several shapers coexist.
+        REQUIRE(1 == canardTxShape(&tx, CanardTransferKindRequest, 100, 800, 8, &shapers.at(1)));
+        REQUIRE(1 == canardTxShape(&tx, CanardTransferKindMessage, 100, 800, 8, &shapers.at(2)));
+        meta.transfer_kind  = CanardTransferKindResponse;
+        meta.port_id        = 100;
+        meta.remote_node_id = 11;
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 7, payload.data()));
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 7, payload.data()));
+        for (auto i = 0U; i < 2U; i++)
+        {
+            const auto* const item = canardTxPeekShaped(&tx, t0, &eligible);
+            REQUIRE(item != nullptr);
+            que.free(&ins.getInstance(), canardTxPop(&tx, item));
+        }
+        meta.transfer_kind = CanardTransferKindRequest;
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 7, payload.data()));
+        REQUIRE(1 == que.push(&ins.getInstance(), 0, meta, 7, payload.data()));
+        REQUIRE(canardTxPeekShaped(&tx, t0, &eligible) != nullptr);
+        que.free(&ins.getInstance(), canardTxPop(&tx, canardTxPeekShaped(&tx, t0, &eligible)));
+        REQUIRE(nullptr == canardTxPeekShaped(&tx, t0, &eligible));
+        REQUIRE((t0 + 10'000) == eligible);
+        REQUIRE(t0 == shapers.at(2).credit_timestamp_usec);  // Refilled but not charged.
+        REQUIRE(shapers.at(2).credit == (8 * 1'000'000));
+
+        que.free(&ins.getInstance(), canardTxPop(&tx, canardTxPeek(&tx)));
+        REQUIRE(0 == que.getSize());
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    }
+}
+
+TEST_CASE("TxStreaming")
+{
+    helpers::Instance ins;
+    auto&             alloc = ins.getAllocator();
+    ins.setNodeID(42);
+
+    struct Source
+    {
+        std::array<std::uint8_t, 300> payload{};
+        std::size_t                   next_offset = 0;
+    } src;
+    for (std::size_t i = 0; i < std::size(src.payload); i++)
+    {
+        src.payload.at(i) = static_cast<std::uint8_t>((i * 13U) & 0xFFU);
+    }
+    const CanardTxStreamRead read = [](CanardTxStream* const stream,
+                                       const std::size_t     offset,
+                                       const std::size_t     size,
+                                       void* const           destination) {
+        auto* const s = static_cast<Source*>(stream->user_reference);
+        REQUIRE(offset == s->next_offset);  // The payload is read sequentially, each byte once.
+        REQUIRE((offset + size) <= stream->payload_size);
+        std::memcpy(destination, &s->payload.at(offset), size);
+        s->next_offset += size;
+    };
+
+    CanardTransferMetadata meta{};
+    meta.priority       = CanardPriorityLow;
+    meta.transfer_kind  = CanardTransferKindMessage;
+    meta.port_id        = 2345;
+    meta.remote_node_id = CANARD_NODE_ID_UNSET;
+    meta.transfer_id    = 35;  // Masked.
+
+    helpers::TxQueue que(4, CANARD_MTU_CAN_CLASSIC);
+    CanardTxStream   stream{};
+    stream.user_reference = &src;
+
+    // Invalid arguments.
+    CanardInstance& ci = ins.getInstance();
+    CanardTxQueue&  cq = que.getInstance();
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(nullptr, &cq, &ci, 0, &meta, 300, read));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, nullptr, &ci, 0, &meta, 300, read));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, &cq, nullptr, 0, &meta, 300, read));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, &cq, &ci, 0, nullptr, 300, read));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, &cq, &ci, 0, &meta, 300, nullptr));
+    meta.port_id = CANARD_SUBJECT_ID_MAX + 1U;
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, &cq, &ci, 0, &meta, 300, read));
+    meta.port_id = 2345;
+    ins.setNodeID(CANARD_NODE_ID_UNSET);  // Anonymous streams are not supported.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamInit(&stream, &cq, &ci, 0, &meta, 1, read));
+    ins.setNodeID(42);
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamPump(&cq, &ci, &stream, 10));  // Not initialized.
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamPump(nullptr, &ci, &stream, 10));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamPump(&cq, nullptr, &stream, 10));
+    REQUIRE(-CANARD_ERROR_INVALID_ARGUMENT == canardTxStreamPump(&cq, &ci, nullptr, 10));
+
+    // The streamed frames shall match those produced by canardTxPush().
+    const auto check = [&](const std::size_t payload_size, const std::size_t max_frames) {
+        helpers::TxQueue ref(1000, CANARD_MTU_CAN_CLASSIC);
+        const auto       num_frames = ref.push(&ci, 1'000, meta, payload_size, src.payload.data());
+        REQUIRE(num_frames > 0);
+        src.next_offset = 0;
+        REQUIRE(0 == canardTxStreamInit(&stream, &cq, &ci, 1'000, &meta, payload_size, read));
+        REQUIRE(&src == stream.user_reference);
+        REQUIRE(static_cast<std::size_t>(num_frames) == stream.remaining_frames);
+        REQUIRE(0 == que.getSize());
+        std::size_t pumped = 0;
+        while (stream.remaining_frames > 0)
+        {
+            const auto ret = canardTxStreamPump(&cq, &ci, &stream, max_frames);
+            REQUIRE(ret > 0);
+            REQUIRE(static_cast<std::size_t>(ret) <= std::min<std::size_t>(max_frames, cq.capacity));
+            REQUIRE(static_cast<std::size_t>(ret) == que.getSize());
+            pumped += static_cast<std::size_t>(ret);
+            REQUIRE(pumped == stream.frame_count);
+            while (const auto* const ti = que.peek())
+            {
+                auto* const       item     = que.pop(ti);
+                auto* const       expected = ref.pop(ref.peek());
+                const auto* const a        = static_cast<const std::uint8_t*>(expected->frame.payload);
+                const auto* const b        = static_cast<const std::uint8_t*>(item->frame.payload);
+                REQUIRE(expected->frame.extended_can_id == item->frame.extended_can_id);
+                REQUIRE(1'000 == item->tx_deadline_usec);
+                REQUIRE(std::vector<std::uint8_t>(a, a + expected->frame.payload_size) ==
+                        std::vector<std::uint8_t>(b, b + item->frame.payload_size));
+                que.free(&ci, item);
+                ref.free(&ci, expected);
+            }
+        }
+        REQUIRE(payload_size == src.next_offset);
+        REQUIRE(0 == ref.getSize());
+        REQUIRE(0 == canardTxStreamPump(&cq, &ci, &stream, max_frames));  // Complete.
+        REQUIRE(0 == alloc.getNumAllocatedFragments());
+    };
+    check(0, 10);
+    check(7, 10);
+    check(8, 10);
+    check(12, 1);
+    check(13, 10);
+    check(300, 3);
+    check(300, 100);  // Limited by the capacity of the queue.
+
+    // The queue is never overfilled; the pumping resumes once the space is available.
+    src.next_offset = 0;
+    REQUIRE(0 == canardTxStreamInit(&stream, &cq, &ci, 1'000, &meta, 100, read));
+    REQUIRE(3 == que.push(&ci, 0, meta, 14, src.payload.data()));
+    REQUIRE(1 == canardTxStreamPump(&cq, &ci, &stream, 10));
+    REQUIRE(0 == canardTxStreamPump(&cq, &ci, &stream, 10));
+    REQUIRE(4 == que.getSize());
+    que.free(&ci, que.pop(que.peek()));
+
+    // Out of memory: nothing is enqueued and the state is retained.
+    alloc.setAllocationCeiling(alloc.getTotalAllocatedAmount());
+    const auto frame_count = stream.frame_count;
+    REQUIRE(-CANARD_ERROR_OUT_OF_MEMORY == canardTxStreamPump(&cq, &ci, &stream, 10));
+    REQUIRE(frame_count == stream.frame_count);
+    alloc.setAllocationCeiling(std::numeric_limits<std::size_t>::max());
+    REQUIRE(1 == canardTxStreamPump(&cq, &ci, &stream, 10));
+    while (const auto* const ti = que.peek())
+    {
+        que.free(&ci, que.pop(ti));
+    }
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+
+    // Another transfer pushed on the same session while the stream is incomplete lands between the batches of the
+    // stream because the CAN ID is the same, so the receiver restarts the reassembly and the stream is lost.
+    helpers::Instance    rx;
+    CanardRxSubscription sub{};
+    REQUIRE(1 == rx.rxSubscribe(CanardTransferKindMessage, 2345, 1000, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, sub));
+    helpers::TxQueue big(1000, CANARD_MTU_CAN_CLASSIC);
+    CanardTxQueue&   cb      = big.getInstance();
+    const auto       receive = [&]() {
+        std::vector<std::size_t> out;
+        while (const auto* const ti = big.peek())
+        {
+            CanardRxTransfer      transfer{};
+            CanardRxSubscription* out_sub = nullptr;
+            if (1 == rx.rxAccept(0, ti->frame, 0, transfer, &out_sub))
+            {
+                out.push_back(transfer.payload_size);
+                canardRxReleasePayload(&rx.getInstance(), out_sub, transfer.payload);
+            }
+            big.free(&ci, big.pop(ti));
+        }
+        return out;
+    };
+    CanardTransferMetadata next = meta;
+    next.transfer_id            = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+    src.next_offset             = 0;
+    REQUIRE(0 == canardTxStreamInit(&stream, &cb, &ci, 1'000, &meta, 100, read));
+    REQUIRE(2 == canardTxStreamPump(&cb, &ci, &stream, 2));
+    REQUIRE(1 == big.push(&ci, 1'000, next, 5, src.payload.data()));
+    while (stream.remaining_frames > 0)
+    {
+        REQUIRE(0 < canardTxStreamPump(&cb, &ci, &stream, 2));
+    }
+    REQUIRE(std::vector<std::size_t>{5} == receive());
+
+    // The correct way is to complete the stream before pushing the next transfer on the same session.
+    meta.transfer_id = static_cast<CanardTransferID>((next.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+    next.transfer_id = static_cast<CanardTransferID>((meta.transfer_id + 1U) & CANARD_TRANSFER_ID_MAX);
+    src.next_offset  = 0;
+    REQUIRE(0 == canardTxStreamInit(&stream, &cb, &ci, 1'000, &meta, 100, read));
+    while (stream.remaining_frames > 0)
+    {
+        REQUIRE(0 < canardTxStreamPump(&cb, &ci, &stream, 2));
+    }
+    REQUIRE(1 == big.push(&ci, 1'000, next, 5, src.payload.data()));
+    REQUIRE((std::vector<std::size_t>{100, 5}) == receive());
+    REQUIRE(0 == alloc.getNumAllocatedFragments());
+}